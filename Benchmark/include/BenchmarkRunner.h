@@ -0,0 +1,175 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Benchmark {
+
+	/**
+	* @brief Prevents the compiler from optimizing away a value that is only computed for the benchmark.
+	* @param value The value that should count as "used".
+	*/
+	template<typename T>
+	inline void DoNotOptimize(const T& value) {
+#ifdef _MSC_VER
+		// MSVC has no inline asm on x64, reading the address through a volatile pointer escapes it
+		const void* volatile escape = static_cast<const void*>(&value);
+		(void)escape;
+		_ReadWriteBarrier();
+#else
+		// the compiler has to assume the empty asm reads the value and all memory
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+
+	/**
+	* @brief Forces all pending writes to memory to be visible to the benchmark (acts like a compiler barrier).
+	*/
+	inline void ClobberMemory() {
+#ifdef _MSC_VER
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	/**
+	* @brief Timing result of a single benchmark
+	*/
+	struct Result {
+		std::string name;
+		// iterations per sample
+		uint64_t iterations = 0;
+		// number of samples that were taken
+		size_t samples = 0;
+		// median time per iteration in nanoseconds (the value that gets compared against a baseline)
+		double nsPerOp = 0.0;
+		double minNs = 0.0;
+		double maxNs = 0.0;
+		double meanNs = 0.0;
+		// number of items that get processed per iteration (elements, matrices, messages ...)
+		uint64_t itemsPerOp = 1;
+	};
+
+	/**
+	* @brief Result of comparing a benchmark against its baseline
+	*/
+	struct Comparison {
+		std::string name;
+		double baselineNs = 0.0;
+		double currentNs = 0.0;
+		// currentNs / baselineNs
+		double ratio = 1.0;
+		bool isRegression = false;
+		bool isImprovement = false;
+	};
+
+	class Runner {
+	public:
+		/*
+		* @brief The benchmark body. Has to execute the measured operation exactly 'iterations' times.
+		*/
+		using BenchFn = std::function<void(uint64_t iterations)>;
+		/*
+		* @brief Optional per benchmark setup/teardown, is not measured.
+		*/
+		using HookFn = std::function<void()>;
+
+		Runner() = default;
+
+		/**
+		* @brief Registers a benchmark.
+		* @param name Unique name of the benchmark, groups are separated with '/' (e.g. "core/matrix4x4/multiply")
+		* @param fn Function that executes the measured operation n times
+		* @param itemsPerOp How many items one iteration processes (used for the items/s output)
+		*/
+		void Add(const std::string& name, BenchFn fn, uint64_t itemsPerOp = 1);
+
+		/**
+		* @brief Registers a benchmark with setup and teardown that run once around all samples.
+		* @param name Unique name of the benchmark
+		* @param setup Called before the benchmark is measured
+		* @param fn Function that executes the measured operation n times
+		* @param teardown Called after the benchmark was measured
+		* @param itemsPerOp How many items one iteration processes
+		*/
+		void Add(const std::string& name, HookFn setup, BenchFn fn, HookFn teardown, uint64_t itemsPerOp = 1);
+
+		/**
+		* @brief Only benchmarks whose name contains the filter get run. Empty = all.
+		*/
+		void SetFilter(const std::string& filter);
+		/**
+		* @brief Minimum time one sample should take. The iteration count gets calibrated to reach it. (default 0.05s)
+		*/
+		void SetMinSampleTime(double seconds);
+		/**
+		* @brief Number of samples that are taken per benchmark (default 9)
+		*/
+		void SetSampleCount(size_t count);
+
+		/**
+		* @brief Runs all registered benchmarks that match the filter and prints the results.
+		* @return All results in registration order
+		*/
+		const std::vector<Result>& Run();
+
+		const std::vector<Result>& GetResults() const;
+
+		/**
+		* @brief Writes the results as JSON.
+		* @param path File path of the JSON file
+		* @return True if the file could be written
+		*/
+		bool WriteJson(const std::string& path) const;
+
+		/**
+		* @brief Creates the JSON string of the results.
+		*/
+		std::string ToJson() const;
+
+		/**
+		* @brief Loads a JSON file that was written by WriteJson.
+		* @param path File path of the baseline
+		* @param outBaseline name -> nsPerOp
+		* @return True if the file could be read and contained at least one result
+		*/
+		static bool LoadBaseline(const std::string& path, std::unordered_map<std::string, double>& outBaseline);
+
+		/**
+		* @brief Compares the current results against a baseline and prints a table.
+		* @param baseline name -> nsPerOp (see LoadBaseline)
+		* @param threshold Relative slowdown that counts as a regression (0.1 = 10% slower)
+		* @return The comparison of every benchmark that exists in both sets
+		*/
+		std::vector<Comparison> CompareWithBaseline(const std::unordered_map<std::string, double>& baseline, double threshold) const;
+
+	private:
+		struct Entry {
+			std::string name;
+			HookFn setup = nullptr;
+			BenchFn fn = nullptr;
+			HookFn teardown = nullptr;
+			uint64_t itemsPerOp = 1;
+		};
+
+		std::vector<Entry> m_entries;
+		std::vector<Result> m_results;
+		std::string m_filter;
+		double m_minSampleTime = 0.05;
+		size_t m_sampleCount = 9;
+
+		Result RunEntry(Entry& entry) const;
+		/*
+		* @brief Runs the benchmark function and returns the elapsed time in nanoseconds
+		*/
+		static double TimeIterations(BenchFn& fn, uint64_t iterations);
+		static void PrintResult(const Result& result);
+	};
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "BenchmarkRunner.h"
+
+namespace Benchmark {
+
+	/*
+	* @brief Math (Matrix4x4, Vectors), Algorithm::Search, FormatUtils and Log
+	*/
+	void RegisterCoreLibBenchmarks(Runner& runner);
+
+	/*
+	* @brief Engine systems that run without a window (Profiler)
+	*/
+	void RegisterEngineBenchmarks(Runner& runner);
+
+	/*
+	* @brief Style generation, attribute parsing and the flex layout on synthetic element trees.
+	* Runs headless, no window or OpenGL context is needed.
+	*/
+	void RegisterUIBenchmarks(Runner& runner);
+
+	/*
+	* @brief Runs the engine headless on the recording device and checks behaviour the timings can not show
+	* (device call order, component state). Failed checks are logged
+	* @return Number of failed checks
+	*/
+	int RunEngineChecks();
+
+}
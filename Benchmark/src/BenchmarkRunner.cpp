@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <sstream>
+#include <CoreLib/File.h>
+#include <CoreLib/FormatUtils.h>
+#include <CoreLib/Log.h>
+#include <CoreLib/TimeUtils.h>
+
+#include "BenchmarkRunner.h"
+
+namespace Benchmark {
+
+	void Runner::Add(const std::string& name, BenchFn fn, uint64_t itemsPerOp) {
+		Add(name, nullptr, std::move(fn), nullptr, itemsPerOp);
+	}
+
+	void Runner::Add(const std::string& name, HookFn setup, BenchFn fn, HookFn teardown, uint64_t itemsPerOp) {
+		Entry& e = m_entries.emplace_back();
+		e.name = name;
+		e.setup = std::move(setup);
+		e.fn = std::move(fn);
+		e.teardown = std::move(teardown);
+		e.itemsPerOp = std::max<uint64_t>(1, itemsPerOp);
+	}
+
+	void Runner::SetFilter(const std::string& filter) {
+		m_filter = filter;
+	}
+
+	void Runner::SetMinSampleTime(double seconds) {
+		m_minSampleTime = std::max(0.001, seconds);
+	}
+
+	void Runner::SetSampleCount(size_t count) {
+		m_sampleCount = std::max<size_t>(1, count);
+	}
+
+	const std::vector<Result>& Runner::Run() {
+		m_results.clear();
+		for (auto& entry : m_entries) {
+			if (!m_filter.empty() && entry.name.find(m_filter) == std::string::npos)
+				continue;
+
+			if (entry.setup)
+				entry.setup();
+
+			Result result = RunEntry(entry);
+
+			if (entry.teardown)
+				entry.teardown();
+
+			PrintResult(result);
+			m_results.push_back(result);
+		}
+		return m_results;
+	}
+
+	const std::vector<Result>& Runner::GetResults() const {
+		return m_results;
+	}
+
+	Result Runner::RunEntry(Entry& entry) const {
+		Result result;
+		result.name = entry.name;
+		result.itemsPerOp = entry.itemsPerOp;
+
+		// warmup and calibration, doubles the iterations until one sample takes long enough
+		const double minSampleNs = m_minSampleTime * 1e9;
+		uint64_t iterations = 1;
+		double elapsed = TimeIterations(entry.fn, iterations);
+		while (elapsed < minSampleNs && iterations < (1ull << 40)) {
+			// jumps close to the target once the timing gets meaningful
+			if (elapsed > 1e5) {
+				double factor = std::clamp((minSampleNs / elapsed) * 1.2, 1.5, 10.0);
+				iterations = static_cast<uint64_t>(static_cast<double>(iterations) * factor);
+			}
+			else {
+				iterations *= 2;
+			}
+			elapsed = TimeIterations(entry.fn, iterations);
+		}
+
+		std::vector<double> perOp;
+		perOp.reserve(m_sampleCount);
+		for (size_t i = 0; i < m_sampleCount; i++) {
+			perOp.push_back(TimeIterations(entry.fn, iterations) / static_cast<double>(iterations));
+		}
+
+		std::sort(perOp.begin(), perOp.end());
+		size_t count = perOp.size();
+		result.iterations = iterations;
+		result.samples = count;
+		result.minNs = perOp.front();
+		result.maxNs = perOp.back();
+		result.meanNs = std::accumulate(perOp.begin(), perOp.end(), 0.0) / static_cast<double>(count);
+		result.nsPerOp = (count % 2 == 1) ?
+			perOp[count / 2] :
+			(perOp[count / 2 - 1] + perOp[count / 2]) * 0.5;
+
+		return result;
+	}
+
+	double Runner::TimeIterations(BenchFn& fn, uint64_t iterations) {
+		using Clock = std::chrono::steady_clock;
+		auto start = Clock::now();
+		fn(iterations);
+		ClobberMemory();
+		auto end = Clock::now();
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	static std::string FormatTime(double ns) {
+		char buffer[32];
+		if (ns < 1e3)
+			std::snprintf(buffer, sizeof(buffer), "%.2f ns", ns);
+		else if (ns < 1e6)
+			std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+		else if (ns < 1e9)
+			std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+		else
+			std::snprintf(buffer, sizeof(buffer), "%.2f s", ns / 1e9);
+		return buffer;
+	}
+
+	void Runner::PrintResult(const Result& r) {
+		double itemsPerSec = (r.nsPerOp > 0.0) ? (static_cast<double>(r.itemsPerOp) * 1e9 / r.nsPerOp) : 0.0;
+		char buffer[256];
+		std::snprintf(buffer, sizeof(buffer), "%-52s %12s/op  (min %s, max %s)  %.3g items/s",
+			r.name.c_str(), FormatTime(r.nsPerOp).c_str(),
+			FormatTime(r.minNs).c_str(), FormatTime(r.maxNs).c_str(), itemsPerSec);
+		std::printf("%s\n", buffer);
+	}
+
+	static std::string EscapeJson(const std::string& str) {
+		std::string out;
+		out.reserve(str.size());
+		for (char c : str) {
+			switch (c) {
+			case '"':  out += "\\\""; break;
+			case '\\': out += "\\\\"; break;
+			case '\n': out += "\\n"; break;
+			case '\t': out += "\\t"; break;
+			default:   out += c; break;
+			}
+		}
+		return out;
+	}
+
+	std::string Runner::ToJson() const {
+		std::ostringstream ss;
+		ss.precision(6);
+		ss << std::fixed;
+		ss << "{\n";
+#ifdef NDEBUG
+		ss << "  \"configuration\": \"Release\",\n";
+#else
+		ss << "  \"configuration\": \"Debug\",\n";
+#endif
+		ss << "  \"date\": \"" << TimeUtils::GetCurrentDateString() << " " << TimeUtils::GetCurrentTimeString() << "\",\n";
+		ss << "  \"results\": [\n";
+		for (size_t i = 0; i < m_results.size(); i++) {
+			const Result& r = m_results[i];
+			ss << "    { "
+				<< "\"name\": \"" << EscapeJson(r.name) << "\", "
+				<< "\"ns_per_op\": " << r.nsPerOp << ", "
+				<< "\"min_ns\": " << r.minNs << ", "
+				<< "\"max_ns\": " << r.maxNs << ", "
+				<< "\"mean_ns\": " << r.meanNs << ", "
+				<< "\"iterations\": " << r.iterations << ", "
+				<< "\"samples\": " << r.samples << ", "
+				<< "\"items_per_op\": " << r.itemsPerOp
+				<< " }" << ((i + 1 < m_results.size()) ? "," : "") << "\n";
+		}
+		ss << "  ]\n";
+		ss << "}\n";
+		return ss.str();
+	}
+
+	bool Runner::WriteJson(const std::string& path) const {
+		File file(path);
+		if (!file.Open(FILE_WRITE)) {
+			Log::Error("Benchmark: Could not open '{}' for writing", path);
+			return false;
+		}
+		bool ok = file.Write(ToJson());
+		file.Close();
+		return ok;
+	}
+
+	bool Runner::LoadBaseline(const std::string& path, std::unordered_map<std::string, double>& outBaseline) {
+		File file(path);
+		std::string content;
+		if (!file.Open(FILE_READ) || !file.ReadAll(content)) {
+			Log::Error("Benchmark: Could not read baseline '{}'", path);
+			return false;
+		}
+
+		// only understands the flat format that ToJson writes: every result object has a "name" and a "ns_per_op"
+		const std::string nameKey = "\"name\"";
+		const std::string nsKey = "\"ns_per_op\"";
+		size_t pos = 0;
+		while ((pos = content.find(nameKey, pos)) != std::string::npos) {
+			size_t nameStart = content.find('"', content.find(':', pos + nameKey.size()) + 1);
+			size_t nameEnd = content.find('"', nameStart + 1);
+			size_t objEnd = content.find('}', nameEnd);
+			size_t nsPos = content.find(nsKey, nameEnd);
+			if (nameStart == std::string::npos || nameEnd == std::string::npos ||
+				nsPos == std::string::npos || nsPos > objEnd)
+				break;
+
+			std::string name = content.substr(nameStart + 1, nameEnd - nameStart - 1);
+			size_t valueStart = content.find(':', nsPos) + 1;
+			try {
+				outBaseline[name] = std::stod(content.substr(valueStart, objEnd - valueStart));
+			}
+			catch (const std::exception&) {
+				Log::Warn("Benchmark: Baseline entry '{}' has an invalid ns_per_op value", name);
+			}
+			pos = objEnd;
+		}
+
+		return !outBaseline.empty();
+	}
+
+	std::vector<Comparison> Runner::CompareWithBaseline(const std::unordered_map<std::string, double>& baseline, double threshold) const {
+		std::vector<Comparison> comparisons;
+		std::printf("\n%-52s %12s %12s %9s\n", "benchmark", "baseline", "current", "change");
+		for (const auto& r : m_results) {
+			auto it = baseline.find(r.name);
+			if (it == baseline.end() || it->second <= 0.0)
+				continue;
+
+			Comparison& c = comparisons.emplace_back();
+			c.name = r.name;
+			c.baselineNs = it->second;
+			c.currentNs = r.nsPerOp;
+			c.ratio = c.currentNs / c.baselineNs;
+			c.isRegression = c.ratio > 1.0 + threshold;
+			c.isImprovement = c.ratio < 1.0 - threshold;
+
+			std::printf("%-52s %12s %12s %+8.1f%% %s\n",
+				c.name.c_str(), FormatTime(c.baselineNs).c_str(), FormatTime(c.currentNs).c_str(),
+				(c.ratio - 1.0) * 100.0,
+				c.isRegression ? "REGRESSION" : (c.isImprovement ? "improved" : ""));
+		}
+		return comparisons;
+	}
+
+}
@@ -0,0 +1,313 @@
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <streambuf>
+#include <vector>
+#include <CoreLib/Algorithm.h>
+#include <CoreLib/FormatUtils.h>
+#include <CoreLib/Log.h>
+#include <CoreLib/Math/Vector2.h>
+#include <CoreLib/Math/Vector3.h>
+#include <CoreLib/Math/Vector4.h>
+#include <CoreLib/Math/Matrix4x4.h>
+
+#include "Benchmarks.h"
+
+namespace {
+
+	using namespace Benchmark;
+
+	// discards everything that gets written to it, used to measure Log without the console cost
+	class NullBuffer : public std::streambuf {
+	protected:
+		int overflow(int c) override { return c; }
+		std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+	};
+
+	// redirects std::cout for its lifetime
+	class ScopedCoutRedirect {
+	public:
+		ScopedCoutRedirect() : m_old(std::cout.rdbuf(&m_null)) {}
+		~ScopedCoutRedirect() { std::cout.rdbuf(m_old); }
+	private:
+		NullBuffer m_null;
+		std::streambuf* m_old;
+	};
+
+	struct SearchItem {
+		unsigned int id;
+		float payload;
+		std::vector<std::shared_ptr<SearchItem>> children;
+	};
+
+	constexpr size_t VECTOR_COUNT = 1024;
+	constexpr size_t MATRIX_COUNT = 64;
+
+	std::vector<Matrix4x4> MakeMatrices(size_t count) {
+		std::mt19937 rng(1337);
+		std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+
+		std::vector<Matrix4x4> list;
+		list.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			list.push_back(
+				GLTransform4x4::Translate(dist(rng), dist(rng), dist(rng)) *
+				GLTransform4x4::RotateXYZ(dist(rng), dist(rng), dist(rng)) *
+				GLTransform4x4::Scale(1.0f + dist(rng) * 0.1f)
+			);
+		}
+		return list;
+	}
+
+	template<typename Vec>
+	std::vector<Vec> MakeVectors(size_t count) {
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+		std::vector<Vec> list(count);
+		for (auto& v : list) {
+			for (int i = 0; i < static_cast<int>(sizeof(Vec) / sizeof(float)); i++)
+				v[i] = dist(rng);
+		}
+		return list;
+	}
+
+	void RegisterMath(Runner& runner) {
+		auto matrices = std::make_shared<std::vector<Matrix4x4>>(MakeMatrices(MATRIX_COUNT));
+
+		runner.Add("core/matrix4x4/multiply", [matrices](uint64_t n) {
+			auto& m = *matrices;
+			for (uint64_t i = 0; i < n; i++) {
+				Matrix4x4 r = m[i % MATRIX_COUNT] * m[(i + 1) % MATRIX_COUNT];
+				DoNotOptimize(r);
+			}
+		});
+
+		runner.Add("core/matrix4x4/multiply_assign_chain", [matrices](uint64_t n) {
+			auto& m = *matrices;
+			for (uint64_t i = 0; i < n; i++) {
+				Matrix4x4 acc = GLTransform4x4::Identity();
+				for (size_t j = 0; j < MATRIX_COUNT; j++)
+					acc *= m[j];
+				DoNotOptimize(acc);
+			}
+		}, MATRIX_COUNT);
+
+		runner.Add("core/matrix4x4/transform_vector4", [matrices](uint64_t n) {
+			auto& m = *matrices;
+			Vector4 v(1.0f, 2.0f, 3.0f, 1.0f);
+			for (uint64_t i = 0; i < n; i++) {
+				v = m[i % MATRIX_COUNT] * v;
+				DoNotOptimize(v);
+			}
+		});
+
+		// Matrix4x4 has no inverse yet, so building model matrices (the Transform hot path) is measured instead
+		runner.Add("core/matrix4x4/build_trs", [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				float f = static_cast<float>(i & 255) * 0.01f;
+				Matrix4x4 m = GLTransform4x4::Scale(1.0f + f);
+				GLTransform4x4::MakeRotateXYZ(m, f, f * 0.5f, f * 0.25f);
+				GLTransform4x4::MakeTranslate(m, f, -f, f * 2.0f);
+				DoNotOptimize(m);
+			}
+		});
+
+		runner.Add("core/matrix4x4/look_at", [](uint64_t n) {
+			Vector3 target(0.0f, 0.0f, 0.0f);
+			for (uint64_t i = 0; i < n; i++) {
+				Vector3 pos(static_cast<float>(i & 63) + 1.0f, 5.0f, 10.0f);
+				Matrix4x4 m = GLTransform4x4::LookAt(pos, target, Vector3::up);
+				DoNotOptimize(m);
+			}
+		});
+
+		runner.Add("core/matrix4x4/to_opengl_data", [matrices](uint64_t n) {
+			auto& m = *matrices;
+			for (uint64_t i = 0; i < n; i++) {
+				Matrix4x4& mat = m[i % MATRIX_COUNT];
+				mat.SetDataDirty();
+				DoNotOptimize(mat.ToOpenGLData());
+			}
+		});
+
+		auto vec3 = std::make_shared<std::vector<Vector3>>(MakeVectors<Vector3>(VECTOR_COUNT));
+		runner.Add("core/vector3/normalize_dot_cross", [vec3](uint64_t n) {
+			auto& v = *vec3;
+			for (uint64_t i = 0; i < n; i++) {
+				float sum = 0.0f;
+				for (size_t j = 0; j + 1 < VECTOR_COUNT; j++) {
+					Vector3 a = v[j].Normalized();
+					Vector3 c = Vector3::Cross(a, v[j + 1]);
+					sum += a.Dot(c);
+				}
+				DoNotOptimize(sum);
+			}
+		}, VECTOR_COUNT);
+
+		runner.Add("core/vector3/arithmetic", [vec3](uint64_t n) {
+			auto& v = *vec3;
+			for (uint64_t i = 0; i < n; i++) {
+				Vector3 acc;
+				for (size_t j = 0; j < VECTOR_COUNT; j++)
+					acc += (v[j] * 0.5f - acc) / 3.0f;
+				DoNotOptimize(acc);
+			}
+		}, VECTOR_COUNT);
+
+		auto vec2 = std::make_shared<std::vector<Vector2>>(MakeVectors<Vector2>(VECTOR_COUNT));
+		runner.Add("core/vector2/arithmetic", [vec2](uint64_t n) {
+			auto& v = *vec2;
+			for (uint64_t i = 0; i < n; i++) {
+				Vector2 acc;
+				for (size_t j = 0; j < VECTOR_COUNT; j++)
+					acc += (v[j] * 0.5f - acc) / 3.0f;
+				DoNotOptimize(acc);
+			}
+		}, VECTOR_COUNT);
+
+		auto vec4 = std::make_shared<std::vector<Vector4>>(MakeVectors<Vector4>(VECTOR_COUNT));
+		runner.Add("core/vector4/squared_magnitude", [vec4](uint64_t n) {
+			auto& v = *vec4;
+			for (uint64_t i = 0; i < n; i++) {
+				float sum = 0.0f;
+				for (size_t j = 0; j < VECTOR_COUNT; j++)
+					sum += v[j].SquaredMagnitude();
+				DoNotOptimize(sum);
+			}
+		}, VECTOR_COUNT);
+	}
+
+	void RegisterSearch(Runner& runner) {
+		constexpr unsigned int count = 10000;
+
+		auto sorted = std::make_shared<std::vector<std::shared_ptr<SearchItem>>>();
+		sorted->reserve(count);
+		for (unsigned int i = 0; i < count; i++)
+			sorted->push_back(std::make_shared<SearchItem>(SearchItem{ i * 2, static_cast<float>(i), {} }));
+
+		auto getID = [](SearchItem& item) { return item.id; };
+
+		runner.Add("core/algorithm/get_binary_10k", [sorted, getID](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				unsigned int id = static_cast<unsigned int>((i * 7919) % (count * 2));
+				DoNotOptimize(Algorithm::Search::GetBinary<SearchItem>(*sorted, getID, id));
+			}
+		});
+
+		runner.Add("core/algorithm/get_linear_10k", [sorted](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				unsigned int id = static_cast<unsigned int>((i * 7919) % (count * 2));
+				DoNotOptimize(Algorithm::Search::GetLinear<SearchItem>(*sorted,
+					[id](SearchItem& item) { return item.id == id; }));
+			}
+		});
+
+		// 10 roots with 10 children with 100 children each, the layout UIManager searches through
+		auto tree = std::make_shared<std::vector<std::shared_ptr<SearchItem>>>();
+		unsigned int nextID = 0;
+		for (int r = 0; r < 10; r++) {
+			auto root = tree->emplace_back(std::make_shared<SearchItem>(SearchItem{ nextID++, 0.0f, {} }));
+			for (int c = 0; c < 10; c++) {
+				auto child = root->children.emplace_back(std::make_shared<SearchItem>(SearchItem{ nextID++, 0.0f, {} }));
+				for (int l = 0; l < 100; l++)
+					child->children.emplace_back(std::make_shared<SearchItem>(SearchItem{ nextID++, 0.0f, {} }));
+			}
+		}
+		const unsigned int treeCount = nextID;
+
+		runner.Add("core/algorithm/get_linear_recursive_10k", [tree, treeCount](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				unsigned int id = static_cast<unsigned int>((i * 7919) % treeCount);
+				DoNotOptimize(Algorithm::Search::GetLinearRecursive(*tree,
+					[id](SearchItem& item) { return item.id == id; },
+					[](SearchItem& item) -> std::vector<std::shared_ptr<SearchItem>>& { return item.children; }));
+			}
+		});
+	}
+
+	void RegisterFormat(Runner& runner) {
+		runner.Add("core/format/no_args", [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				DoNotOptimize(FormatUtils::formatString("Engine: No camera available"));
+		});
+
+		runner.Add("core/format/three_args", [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				DoNotOptimize(FormatUtils::formatString("UIManager: Started element {}({}) at {}", "Panel", static_cast<int>(i), 1.5f));
+		});
+
+		runner.Add("core/format/six_args", [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				DoNotOptimize(FormatUtils::formatString("{} {} {} {} {} {}", 1, 2.0f, "three", 4u, 5.0, 'x'));
+		});
+
+		runner.Add("core/format/vector3", [](uint64_t n) {
+			Vector3 v(1.0f, 2.0f, 3.0f);
+			for (uint64_t i = 0; i < n; i++)
+				DoNotOptimize(FormatUtils::formatString("pos: {}", v));
+		});
+
+		runner.Add("core/format/to_string_float", [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				DoNotOptimize(FormatUtils::toString(static_cast<float>(i) * 0.25f));
+		});
+	}
+
+	void RegisterLog(Runner& runner) {
+		auto redirect = std::make_shared<std::unique_ptr<ScopedCoutRedirect>>();
+		auto setup = [redirect]() {
+			*redirect = std::make_unique<ScopedCoutRedirect>();
+			Log::SetLevel(Log::levelError, Log::levelWarning, Log::levelInfo, Log::levelDebug);
+		};
+		auto teardown = [redirect]() {
+			redirect->reset();
+			Log::SetLevel(Log::levelError, Log::levelWarning, Log::levelInfo, Log::levelDebug);
+		};
+
+		runner.Add("core/log/info_null_console", setup, [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				Log::Info("Benchmark: message {} with value {}", static_cast<int>(i), 0.5f);
+		}, teardown);
+
+		runner.Add("core/log/info_with_subscriber", setup, [](uint64_t n) {
+			size_t bytes = 0;
+			auto id = Log::Subscribe([&bytes](Log::Level, const std::string& msg) { bytes += msg.size(); });
+			for (uint64_t i = 0; i < n; i++)
+				Log::Info("Benchmark: message {} with value {}", static_cast<int>(i), 0.5f);
+			Log::Unsubscribe(id);
+			DoNotOptimize(bytes);
+		}, teardown);
+
+		// cost of a call that gets dropped by the rate limit of its call site
+		runner.Add("core/log/rate_limited", [redirect]() {
+			*redirect = std::make_unique<ScopedCoutRedirect>();
+			Log::SetLevel(Log::levelError, Log::levelWarning, Log::levelInfo, Log::levelDebug);
+		}, [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				Log::Limited::Warn("Benchmark: flooding message {} with value {}", static_cast<int>(i), 0.5f);
+		}, teardown);
+
+		// cost of a call whose level is disabled, should be close to zero
+		runner.Add("core/log/debug_filtered", [redirect]() {
+			*redirect = std::make_unique<ScopedCoutRedirect>();
+			Log::SetLevel(Log::levelError, Log::levelWarning);
+		}, [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				Log::Debug("Benchmark: filtered message {} with value {}", static_cast<int>(i), 0.5f);
+		}, teardown);
+	}
+
+}
+
+namespace Benchmark {
+
+	void RegisterCoreLibBenchmarks(Runner& runner) {
+		RegisterMath(runner);
+		RegisterSearch(runner);
+		RegisterFormat(runner);
+		RegisterLog(runner);
+	}
+
+}
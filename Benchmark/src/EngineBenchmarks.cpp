@@ -0,0 +1,53 @@
+#include <EngineLib/Profiler.h>
+
+#include "Benchmarks.h"
+
+namespace {
+
+	using namespace Benchmark;
+	using namespace EngineCore;
+
+	void RegisterProfiler(Runner& runner) {
+		// closes the frame now and then, like the engine does, so the call tree stays small
+		runner.Add("engine/profiler/zone", [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				ENGINE_PROFILE_ZONE("Benchmark zone");
+				DoNotOptimize(i);
+			}
+			Profiler::EndFrame();
+		});
+
+		runner.Add("engine/profiler/nested_zone_depth_4", [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				ENGINE_PROFILE_ZONE("Benchmark depth 1");
+				{
+					ENGINE_PROFILE_ZONE("Benchmark depth 2");
+					{
+						ENGINE_PROFILE_ZONE("Benchmark depth 3");
+						{
+							ENGINE_PROFILE_ZONE("Benchmark depth 4");
+							DoNotOptimize(i);
+						}
+					}
+				}
+			}
+			Profiler::EndFrame();
+		}, 4);
+
+		runner.Add("engine/profiler/zone_disabled", []() { Profiler::SetEnabled(false); }, [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				ENGINE_PROFILE_ZONE("Benchmark disabled zone");
+				DoNotOptimize(i);
+			}
+		}, []() { Profiler::SetEnabled(true); });
+	}
+
+}
+
+namespace Benchmark {
+
+	void RegisterEngineBenchmarks(Runner& runner) {
+		RegisterProfiler(runner);
+	}
+
+}
@@ -0,0 +1,179 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <EngineLib/Engine.h>
+#include <EngineLib/Renderer.h>
+#include <EngineLib/RecordingRenderDevice.h>
+
+#include "Benchmarks.h"
+
+namespace {
+
+	using namespace EngineCore;
+
+	/*
+	* @brief Runs a few frames headless on the recording device, sets the scenes up in Start
+	* and checks the captured device calls and component state in Shutdown
+	*/
+	class CheckApp : public Application {
+	public:
+		CheckApp()
+			: Application("EngineChecks", "1.0.0") {
+			App_Application_Set_Header(false);
+			App_Benchmark_Set_Enabled(true);
+			App_Benchmark_Set_FrameLimit(2);
+			App_Benchmark_Set_OutputPath("benchmark/engine_checks");
+		}
+
+		int GetFailedCount() const {
+			return m_failed;
+		}
+
+	protected:
+		void Start() override {
+			m_device = dynamic_cast<RecordingRenderDevice*>(Renderer::GetDevice());
+			if (!Expect(m_device != nullptr, "the engine runs on the recording device"))
+				return;
+			m_device->SetCapture(true);
+
+			SetupSplitTarget();
+			SetupReusedSpriteRegion();
+		}
+
+		void Shutdown() override {
+			if (!m_device)
+				return;
+			CheckSplitTarget();
+			CheckReusedSpriteRegion();
+		}
+
+	private:
+		static constexpr int TARGET_WIDTH = 64;
+		static constexpr int TARGET_HEIGHT = 32;
+
+		RecordingRenderDevice* m_device = nullptr;
+		OffscreenTarget m_target;
+		std::shared_ptr<Component::SpriteRenderer> m_deletedSprite = nullptr;
+		Texture2DID m_reusingTexture = Texture2DID(ENGINE_INVALID_ID);
+		Vector4 m_reusingUVRect;
+		int m_failed = 0;
+
+		bool Expect(bool condition, const std::string& message) {
+			if (!condition) {
+				Log::Error("EngineChecks: Failed, {}", message);
+				m_failed++;
+			}
+			return condition;
+		}
+
+		// two cameras draw side by side into the same target (split screen into a texture)
+		void SetupSplitTarget() {
+			Expect(m_target.Create(TARGET_WIDTH, TARGET_HEIGHT, 1), "the split screen target can be created");
+
+			auto leftGO = GameObject::Create("LeftCamera");
+			leftGO->AddComponent<Component::Camera>()
+				->SetRenderTarget(&m_target)
+				->SetViewport(0.0f, 0.0f, 0.5f, 1.0f);
+
+			auto rightGO = GameObject::Create("RightCamera");
+			rightGO->AddComponent<Component::Camera>()
+				->SetAdditional(true)
+				->SetRenderTarget(&m_target)
+				->SetViewport(0.5f, 0.0f, 0.5f, 1.0f);
+
+			// DrawAll returns early without commands
+			auto go = GameObject::Create("SplitTargetCube");
+			go->GetTransform()->SetPosition(0, 0, 100);
+			go->AddComponent<Component::MeshRenderer>()
+				->SetMesh(ASSETS::ENGINE::MESH::Cube())->SetMaterial(ASSETS::ENGINE::MATERIAL::Default());
+		}
+
+		// every clear of a camera has to be scissored to its own half of the target
+		void CheckSplitTarget() {
+			struct Rect { int64_t x, y, width, height; };
+			Rect scissor{ 0, 0, 0, 0 };
+			bool scissorEnabled = false;
+			bool clearedLeft = false;
+			bool clearedRight = false;
+			int unscissoredClears = 0;
+
+			for (const auto& call : m_device->GetCapturedCalls()) {
+				if (call.call == RenderCall::SetScissor) {
+					scissorEnabled = (call.handle != 0);
+					scissor = { call.a, call.b, call.c, call.d };
+				}
+				else if (call.call == RenderCall::ClearColor || call.call == RenderCall::ClearDepth) {
+					if (!scissorEnabled) {
+						unscissoredClears++;
+						continue;
+					}
+					int64_t half = TARGET_WIDTH / 2;
+					if (scissor.x == 0 && scissor.y == 0 && scissor.width == half && scissor.height == TARGET_HEIGHT)
+						clearedLeft = true;
+					else if (scissor.x == half && scissor.y == 0 && scissor.width == half && scissor.height == TARGET_HEIGHT)
+						clearedRight = true;
+				}
+			}
+
+			Expect(clearedLeft, "the left camera clears its half of the shared target");
+			Expect(clearedRight, "the right camera clears its half of the shared target");
+			Expect(unscissoredClears == 0, FormatUtils::formatString("{} clear(s) without scissor wipe the whole target", unscissoredClears));
+		}
+
+		static Texture2DID AddSpriteTexture(unsigned char value) {
+			std::vector<unsigned char> pixels(8 * 8 * 4, value);
+			return ResourceManager::GetInstance()->AddTexture2DFromMemory(pixels.data(), 8, 8, 4);
+		}
+
+		// a sprite whose texture got deleted must not draw the texture that is packed into the freed region
+		void SetupReusedSpriteRegion() {
+			ResourceManager* rm = ResourceManager::GetInstance();
+
+			// keeps the page alive when the deleted texture was its only sprite
+			auto keepGO = GameObject::Create("KeepSprite");
+			keepGO->AddComponent<Component::SpriteRenderer>()->SetSprite(AddSpriteTexture(255));
+
+			auto deletedGO = GameObject::Create("DeletedSprite");
+			Texture2DID deleted = AddSpriteTexture(0);
+			m_deletedSprite = deletedGO->AddComponent<Component::SpriteRenderer>();
+			m_deletedSprite->SetSprite(deleted);
+			Vector4 deletedUVRect = m_deletedSprite->GetUVRect();
+
+			rm->DeleteAsset(deleted);
+			m_reusingTexture = AddSpriteTexture(128);
+			auto reusingGO = GameObject::Create("ReusingSprite");
+			auto reusing = reusingGO->AddComponent<Component::SpriteRenderer>();
+			reusing->SetSprite(m_reusingTexture);
+			m_reusingUVRect = reusing->GetUVRect();
+
+			Expect(m_reusingUVRect == deletedUVRect, "the new texture is packed into the region of the deleted one");
+		}
+
+		void CheckReusedSpriteRegion() {
+			Expect(m_deletedSprite->GetSpirte() != m_reusingTexture, "the sprite of the deleted texture does not take the reused id");
+			Expect(m_deletedSprite->GetUVRect() != m_reusingUVRect, "the sprite of the deleted texture does not sample the reused region");
+			m_deletedSprite = nullptr;
+		}
+	};
+
+}
+
+namespace Benchmark {
+
+	int RunEngineChecks() {
+		auto app = std::make_shared<CheckApp>();
+		{
+			EngineCore::Engine engine(app);
+			if (engine.EngineStart() != 0) {
+				Log::Error("EngineChecks: Engine start failed");
+				return 1;
+			}
+			engine.EngineLoop();
+		}
+
+		if (app->GetFailedCount() == 0)
+			Log::Info("EngineChecks: All checks passed");
+		return app->GetFailedCount();
+	}
+
+}
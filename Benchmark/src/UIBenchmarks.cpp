@@ -0,0 +1,385 @@
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <CoreLib/FormatUtils.h>
+#include <EngineLib/UI.h>
+#include <EngineLib/UI/StyleAttribute.h>
+
+#include "Benchmarks.h"
+
+namespace {
+
+	using namespace Benchmark;
+	using namespace EngineCore;
+	using namespace EngineCore::UI;
+
+	constexpr int SCREEN_WIDTH = 1920;
+	constexpr int SCREEN_HEIGHT = 1080;
+
+	/*
+	* The UI is driven through UIManager::Update like the engine does every frame.
+	* Nothing here touches the window or OpenGL.
+	*/
+	void InitUI() {
+		static bool initialized = false;
+		if (!initialized) {
+			UIManager::Init();
+			initialized = true;
+		}
+		UIManager::Update(SCREEN_WIDTH, SCREEN_HEIGHT, 0.0f);
+	}
+
+	// one UI frame (states, layout of the dirty elements, styles), transitions do not advance
+	void UpdateUI(float deltaTime = 0.0f) {
+		UIManager::Update(SCREEN_WIDTH, SCREEN_HEIGHT, deltaTime);
+	}
+
+	// UI frame with a full relayout, every element is dirty
+	void UpdateUIRelayout() {
+		UIManager::SetRootElementTransDirty();
+		UpdateUI();
+	}
+
+	// changes the state of the element and all its children, their styles get applied with the next UpdateUI
+	void SetStates(UI::ElementBase& element, UI::State state) {
+		element.SetState(state);
+		for (auto& child : element.GetChildren())
+			SetStates(*child, state);
+	}
+
+	struct TreeStyles {
+		std::shared_ptr<Style> root;
+		std::shared_ptr<Style> container;
+		std::shared_ptr<Style> item;
+	};
+
+	const TreeStyles& GetTreeStyles() {
+		static TreeStyles styles = [] {
+			TreeStyles s;
+			s.root = Style::Create("BenchRoot");
+			s.root->Set(Attribute::layoutDirection, "row");
+			s.root->Set(Attribute::layoutWrap, "wrap");
+			s.root->Set(Attribute::width, "100%w");
+			s.root->Set(Attribute::height, "100%h");
+
+			s.container = Style::Create("BenchContainer");
+			s.container->Set(Attribute::layoutDirection, "column");
+			s.container->Set(Attribute::layout, "start center");
+			s.container->Set(Attribute::width, "50%a");
+			s.container->Set(Attribute::height, "50%a");
+			s.container->Set(Attribute::padding, "2px");
+			s.container->Set(Attribute::borderSize, "1px");
+
+			s.item = Style::Create("BenchItem");
+			s.item->Set(Attribute::width, "8px");
+			s.item->Set(Attribute::height, "8px");
+			s.item->Set(Attribute::margin, "1px");
+			s.item->Set(Attribute::backgroundColor, "#ff8000a0");
+			return s;
+		}();
+		return styles;
+	}
+
+	/*
+	* @brief Adds up to fanout children per container until the element budget is used up.
+	*/
+	void AddChildren(size_t& remaining, size_t fanout, int depth) {
+		const TreeStyles& styles = GetTreeStyles();
+		for (size_t i = 0; i < fanout && remaining > 0; i++) {
+			remaining--;
+			if (depth > 1 && remaining > 0) {
+				UIManager::Begin<Panel>(styles.container);
+				AddChildren(remaining, fanout, depth - 1);
+				UIManager::End();
+			}
+			else {
+				UIManager::Add<Panel>(styles.item);
+			}
+		}
+	}
+
+	/*
+	* @brief Builds a tree with elementCount elements where every container has at most fanout children
+	* @return The id of the tree root
+	*/
+	UIElementID BuildTree(size_t elementCount, size_t fanout) {
+		int depth = static_cast<int>(std::ceil(std::log(static_cast<double>(elementCount)) / std::log(static_cast<double>(fanout))));
+		size_t remaining = elementCount;
+
+		auto root = UIManager::Begin<Panel>(GetTreeStyles().root);
+		AddChildren(remaining, fanout, std::max(depth, 1));
+		UIManager::End();
+		return root->GetID();
+	}
+
+	/*
+	* @brief Setup and teardown for benchmarks that run on one tree, the tree is built before and deleted after every run
+	*/
+	struct TreeFixture {
+		std::shared_ptr<UIElementID> rootID;
+		Runner::HookFn setup;
+		Runner::HookFn teardown;
+	};
+
+	/*
+	* @param build Creates the tree and returns its root, the styles get applied once afterwards
+	* @param onTeardown Optional, runs after the tree was deleted
+	*/
+	TreeFixture MakeTreeFixture(std::function<UIElementID()> build, Runner::HookFn onTeardown = nullptr) {
+		TreeFixture fixture;
+		fixture.rootID = std::make_shared<UIElementID>(ENGINE_INVALID_ID);
+
+		fixture.setup = [rootID = fixture.rootID, build = std::move(build)]() {
+			InitUI();
+			*rootID = build();
+			UpdateUI();
+		};
+		fixture.teardown = [rootID = fixture.rootID, onTeardown = std::move(onTeardown)]() {
+			UIManager::DeleteElement(*rootID);
+			*rootID = UIElementID(ENGINE_INVALID_ID);
+			if (onTeardown)
+				onTeardown();
+		};
+		return fixture;
+	}
+
+	TreeFixture MakeTreeFixture(size_t elementCount, size_t fanout = 10) {
+		return MakeTreeFixture([elementCount, fanout]() { return BuildTree(elementCount, fanout); });
+	}
+
+	void RegisterStyleBenchmarks(Runner& runner) {
+		auto base = std::make_shared<std::shared_ptr<Style>>();
+		auto derived = std::make_shared<std::shared_ptr<Style>>();
+
+		auto setup = [base, derived]() {
+			InitUI();
+			*base = Style::Create("BenchBase", UIManager::GetElementBaseStyle());
+			(*base)->Set(Attribute::margin, "4px 8px");
+			(*base)->Set(Attribute::padding, "2px");
+			(*base)->Set(Attribute::borderSize, "1px 2px");
+			(*base)->Set(Attribute::layout, "center center");
+			(*derived) = Style::Create("BenchDerived", *base);
+			(*derived)->Set(Attribute::backgroundColor, "#202020ff");
+			(*derived)->Set(State::Hovered, Attribute::backgroundColor, "#404040ff");
+		};
+		auto teardown = [base, derived]() {
+			base->reset();
+			derived->reset();
+		};
+
+		// Set marks the style dirty, GetAll regenerates the cached style (GenerateCachedStyle)
+		runner.Add("ui/style/generate_cached_style", setup, [derived](uint64_t n) {
+			auto& style = *derived;
+			for (uint64_t i = 0; i < n; i++) {
+				style->Set(Attribute::width, (i & 1) ? "10px" : "20px");
+				DoNotOptimize(style->GetAll());
+			}
+		}, teardown);
+
+		runner.Add("ui/style/get_all_state_cached", setup, [derived](uint64_t n) {
+			auto& style = *derived;
+			for (uint64_t i = 0; i < n; i++)
+				DoNotOptimize(style->GetAllState(State::Hovered));
+		}, teardown);
+
+		struct AttributeInput {
+			const char* name;
+			const char* value;
+		};
+		auto inputs = std::make_shared<std::vector<AttributeInput>>(std::vector<AttributeInput>{
+			{ Attribute::width, "50%w" },
+			{ Attribute::height, "120px" },
+			{ Attribute::backgroundColor, "#ff00ffa0" },
+			{ Attribute::borderRadius, "4px 4px 8px 8px" },
+			{ Attribute::marginTop, "6px" },
+			{ Attribute::layoutDirection, "column" },
+			{ Attribute::layoutMajor, "space-evenly" },
+			{ Attribute::duration, "0.25s" },
+		});
+
+		runner.Add("ui/style/parse_attribute", []() { InitUI(); }, [inputs](uint64_t n) {
+			auto& in = *inputs;
+			for (uint64_t i = 0; i < n; i++) {
+				const AttributeInput& a = in[i % in.size()];
+				DoNotOptimize(StyleAttribute::GetAttributeValue(a.name, a.value));
+			}
+		}, nullptr);
+
+		runner.Add("ui/style/parse_composite", []() { InitUI(); }, [](uint64_t n) {
+			const StyleAttribute& margin = StyleAttribute::GetAttribute(Attribute::margin);
+			for (uint64_t i = 0; i < n; i++)
+				DoNotOptimize(margin.ParseCompositeValues("1px 2px 3px 4px"));
+		}, nullptr);
+	}
+
+	void RegisterLayoutTree(Runner& runner, const std::string& shape, size_t elementCount, size_t fanout) {
+		// the fixture applies the styles once, so a frame mostly measures the layout
+		TreeFixture tree = MakeTreeFixture(elementCount, fanout);
+		auto setup = [tree]() {
+			tree.setup();
+			UpdateUIRelayout();
+		};
+		auto teardown = tree.teardown;
+
+		std::string prefix = FormatUtils::formatString("ui/flex/{}_{}", shape, elementCount);
+		runner.Add(prefix + "/layout_dirty", setup, [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				UpdateUIRelayout();
+		}, teardown, elementCount);
+
+		runner.Add(prefix + "/layout_clean", setup, [](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++)
+				UpdateUI();
+		}, teardown, elementCount);
+	}
+
+	// every element switches between normal and hovered, so each iteration applies all styles again
+	void RegisterStyleApply(Runner& runner, size_t elementCount) {
+		TreeFixture tree = MakeTreeFixture(elementCount);
+
+		runner.Add(FormatUtils::formatString("ui/style/apply_state_{}", elementCount), tree.setup, [rootID = tree.rootID](uint64_t n) {
+			auto root = UIManager::GetElement(*rootID);
+			for (uint64_t i = 0; i < n; i++) {
+				SetStates(*root, (i & 1) ? State::Hovered : State::Normal);
+				UpdateUI();
+			}
+		}, tree.teardown, elementCount);
+	}
+
+	// changes ten attributes of the style most elements share, the elements pick it up with the next UpdateElements
+	void RegisterStyleEdit(Runner& runner, size_t elementCount) {
+		static const char* colorAttributes[] = { Attribute::backgroundColor, Attribute::borderColor, Attribute::textColor };
+		static const char* sizeAttributes[] = {
+			Attribute::borderRadius, Attribute::marginTop, Attribute::marginRight, Attribute::marginBottom,
+			Attribute::marginLeft, Attribute::paddingTop, Attribute::paddingLeft
+		};
+		TreeFixture tree = MakeTreeFixture([elementCount]() { return BuildTree(elementCount, 10); }, []() {
+			// the tree styles are shared with the other benchmarks
+			const auto& item = GetTreeStyles().item;
+			for (const char* name : colorAttributes)
+				item->Remove(name);
+			for (const char* name : sizeAttributes)
+				item->Remove(name);
+			item->Set(Attribute::backgroundColor, "#ff8000a0");
+		});
+
+		runner.Add(FormatUtils::formatString("ui/style/edit_shared_{}", elementCount), tree.setup, [](uint64_t n) {
+			const auto& item = GetTreeStyles().item;
+			for (uint64_t i = 0; i < n; i++) {
+				std::string color = (i & 1) ? "#ff0000ff" : "#00ff00ff";
+				std::string size = (i & 1) ? "2px" : "3px";
+				for (const char* name : colorAttributes)
+					item->Set(name, color);
+				for (const char* name : sizeAttributes)
+					item->Set(name, size);
+				UpdateUI();
+			}
+		}, tree.teardown, elementCount);
+	}
+
+	// hover animations on every element: all elements change their state every 8 frames and transition
+	// four values (two colors, the radius and the width) towards the new state over 10 frames
+	void RegisterTransitions(Runner& runner, size_t elementCount) {
+		TreeFixture tree = MakeTreeFixture([elementCount]() {
+			auto item = Style::Create("BenchTransitionItem");
+			item->Set(Attribute::width, "8px");
+			item->Set(Attribute::height, "8px");
+			item->Set(Attribute::backgroundColor, "#ff8000a0");
+			item->Set(Attribute::borderColor, "#000000ff");
+			item->Set(Attribute::duration, "160ms");
+			item->Set(Attribute::easing, "ease-out");
+			item->Set(State::Hovered, Attribute::width, "12px");
+			item->Set(State::Hovered, Attribute::backgroundColor, "#ffffffff");
+			item->Set(State::Hovered, Attribute::borderColor, "#ff0000ff");
+			item->Set(State::Hovered, Attribute::borderRadius, "4px");
+
+			auto root = UIManager::Begin<Panel>(GetTreeStyles().root);
+			for (size_t i = 0; i < elementCount; i++)
+				UIManager::Add<Panel>(item);
+			UIManager::End();
+			return root->GetID();
+		});
+
+		runner.Add(FormatUtils::formatString("ui/style/transition_hover_{}", elementCount), tree.setup, [rootID = tree.rootID](uint64_t n) {
+			auto root = UIManager::GetElement(*rootID);
+			for (uint64_t i = 0; i < n; i++) {
+				if (i % 8 == 0) {
+					for (auto& child : root->GetChildren())
+						SetStates(*child, ((i / 8) & 1) ? State::Normal : State::Hovered);
+				}
+				// applies the new states and advances the running transitions
+				UpdateUI(1.0f / 60.0f);
+			}
+		}, tree.teardown, elementCount);
+	}
+
+	void RegisterBuildTree(Runner& runner, size_t elementCount) {
+		runner.Add(FormatUtils::formatString("ui/tree/build_delete_{}", elementCount),
+			[]() { InitUI(); },
+			[elementCount](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				UIElementID id = BuildTree(elementCount, 10);
+				UIManager::DeleteElement(id);
+			}
+		}, nullptr, elementCount);
+	}
+
+	// looks up every element of the tree by its id
+	void RegisterLookup(Runner& runner, size_t elementCount) {
+		TreeFixture tree = MakeTreeFixture(elementCount);
+		auto ids = std::make_shared<std::vector<UIElementID>>();
+
+		auto setup = [tree, ids]() {
+			tree.setup();
+
+			std::vector<UI::ElementBase*> stack{ UIManager::GetElement(*tree.rootID).get() };
+			while (!stack.empty()) {
+				UI::ElementBase* element = stack.back();
+				stack.pop_back();
+				ids->push_back(element->GetID());
+				for (const auto& child : element->GetChildren())
+					stack.push_back(child.get());
+			}
+		};
+		auto teardown = [tree, ids]() {
+			tree.teardown();
+			ids->clear();
+		};
+
+		runner.Add(FormatUtils::formatString("ui/tree/get_element_{}", elementCount), setup, [ids](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				for (UIElementID id : *ids)
+					DoNotOptimize(UIManager::GetElement(id));
+			}
+		}, teardown, elementCount);
+	}
+
+}
+
+namespace Benchmark {
+
+	void RegisterUIBenchmarks(Runner& runner) {
+		RegisterStyleBenchmarks(runner);
+
+		RegisterBuildTree(runner, 1000);
+		RegisterLookup(runner, 1000);
+		RegisterStyleApply(runner, 1000);
+		RegisterStyleEdit(runner, 1000);
+		RegisterTransitions(runner, 1000);
+
+		// every container has 10 children
+		RegisterLayoutTree(runner, "balanced", 1000, 10);
+		RegisterLayoutTree(runner, "balanced", 10000, 10);
+		RegisterLayoutTree(runner, "balanced", 100000, 10);
+
+		// one container with all elements as direct children.
+		// the sibling sizes are summed once per container, so this scales roughly linear like the balanced trees
+		RegisterLayoutTree(runner, "wide", 1000, 1000);
+		RegisterLayoutTree(runner, "wide", 5000, 5000);
+		RegisterLayoutTree(runner, "wide", 20000, 20000);
+		RegisterLayoutTree(runner, "wide", 50000, 50000);
+	}
+
+}
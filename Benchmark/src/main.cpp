@@ -0,0 +1,115 @@
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <CoreLib/Log.h>
+
+#include "Benchmarks.h"
+
+/*
+* Headless microbenchmarks for the CoreLib and UI hot paths.
+*
+* Usage: Benchmark [options]
+*   --filter <text>        only runs benchmarks whose name contains <text>
+*   --out <file.json>      writes the results as JSON (default: benchmark_results.json)
+*   --baseline <file.json> compares the results against a previous run
+*   --threshold <float>    relative slowdown that counts as regression (default: 0.1 = 10%)
+*   --samples <int>        samples per benchmark (default: 9)
+*   --min-time <seconds>   minimum duration of one sample (default: 0.05)
+*   --check                runs the headless engine checks instead of the benchmarks
+*
+* Returns EXIT_FAILURE if a baseline was given and at least one benchmark regressed,
+* or with --check if at least one check failed.
+*/
+
+static void PrintUsage() {
+	Log::Print("Usage: Benchmark [--filter <text>] [--out <file.json>] [--baseline <file.json>] "
+		"[--threshold <float>] [--samples <int>] [--min-time <seconds>] [--check]");
+}
+
+int main(int argc, char** argv) {
+	std::string filter;
+	std::string outPath = "benchmark_results.json";
+	std::string baselinePath;
+	double threshold = 0.1;
+	size_t samples = 9;
+	double minTime = 0.05;
+	bool check = false;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if (arg == "--help" || arg == "-h") {
+			PrintUsage();
+			return EXIT_SUCCESS;
+		}
+		else if (arg == "--filter" && hasValue) {
+			filter = argv[++i];
+		}
+		else if (arg == "--out" && hasValue) {
+			outPath = argv[++i];
+		}
+		else if (arg == "--baseline" && hasValue) {
+			baselinePath = argv[++i];
+		}
+		else if (arg == "--threshold" && hasValue) {
+			threshold = std::atof(argv[++i]);
+		}
+		else if (arg == "--samples" && hasValue) {
+			samples = static_cast<size_t>(std::atoi(argv[++i]));
+		}
+		else if (arg == "--min-time" && hasValue) {
+			minTime = std::atof(argv[++i]);
+		}
+		else if (arg == "--check") {
+			check = true;
+		}
+		else {
+			Log::Error("Benchmark: Unknown or incomplete argument '{}'", arg);
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (check)
+		return (Benchmark::RunEngineChecks() == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+#ifndef NDEBUG
+	Log::Warn("Benchmark: Running a debug build, the numbers are not representative");
+#endif
+
+	Benchmark::Runner runner;
+	runner.SetFilter(filter);
+	runner.SetSampleCount(samples);
+	runner.SetMinSampleTime(minTime);
+
+	Benchmark::RegisterCoreLibBenchmarks(runner);
+	Benchmark::RegisterEngineBenchmarks(runner);
+	Benchmark::RegisterUIBenchmarks(runner);
+
+	runner.Run();
+
+	if (!outPath.empty() && runner.WriteJson(outPath))
+		Log::Info("Benchmark: Results written to '{}'", outPath);
+
+	if (baselinePath.empty())
+		return EXIT_SUCCESS;
+
+	std::unordered_map<std::string, double> baseline;
+	if (!Benchmark::Runner::LoadBaseline(baselinePath, baseline))
+		return EXIT_FAILURE;
+
+	int regressions = 0;
+	for (const auto& c : runner.CompareWithBaseline(baseline, threshold)) {
+		if (c.isRegression)
+			regressions++;
+	}
+
+	if (regressions > 0) {
+		Log::Error("Benchmark: {} benchmark(s) regressed by more than {}%", regressions, threshold * 100.0);
+		return EXIT_FAILURE;
+	}
+
+	Log::Info("Benchmark: No regressions against '{}'", baselinePath);
+	return EXIT_SUCCESS;
+}
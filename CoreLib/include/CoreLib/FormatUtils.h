@@ -90,7 +90,10 @@ public:
 
     template<typename T>
     static std::string toString(T value) {
-        if constexpr (std::is_pointer_v<T>) {
+        if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            return (value) ? std::string(value) : "(null)";
+        }
+        else if constexpr (std::is_pointer_v<T>) {
             std::ostringstream oss;
             oss << static_cast<const void*>(value);
             return oss.str();
@@ -101,9 +104,6 @@ public:
         else if constexpr (std::is_arithmetic_v<T>) {
             return trimTrailingZeros(value);
         }
-        else if constexpr (std::is_same_v<T, const char*>) {
-            return std::string(value);
-        }
         else if constexpr (std::is_same_v<T, std::string>) {
             return value;
         }
@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/**
+ * @brief Utility class for writing images.
+ */
+class ImageUtils {
+public:
+    /**
+     * @brief Encodes 8 bit pixels as PNG.
+     *
+     * Every row uses the Sub filter and the data is deflated with fixed Huffman codes and runs
+     * of equal bytes only, which is fast and small enough for rendered frames with flat areas.
+     * @param pixels Tightly packed rows, width * height * channels bytes.
+     * @param channels 1 = gray, 2 = gray + alpha, 3 = RGB, 4 = RGBA
+     * @param flipVertically If true the last row is written first (OpenGL readback order).
+     * @param outData Receives the PNG file content.
+     * @return False if the size or channel count is invalid.
+     */
+    static bool EncodePNG(const unsigned char* pixels, int width, int height, int channels,
+        std::vector<unsigned char>& outData, bool flipVertically = false);
+
+    /**
+     * @brief Encodes the pixels as PNG and writes them to a file (see EncodePNG).
+     * @return False if the pixels are invalid or the file could not be written.
+     */
+    static bool WritePNG(const std::string& path, const unsigned char* pixels, int width, int height,
+        int channels, bool flipVertically = false);
+};
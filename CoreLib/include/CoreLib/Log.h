@@ -1,16 +1,40 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <new>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 #include "FormatUtils.h"
 
+/*
+* Highest log level that gets compiled in. Calls above it are removed at compile time
+* (the arguments are still evaluated, but nothing gets formatted or queued).
+* 0 = Error, 1 = Warning, 2 = Info, 3 = Debug. Release builds strip Debug by default.
+*/
+#ifndef LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILE_LEVEL 2
+#else
+#define LOG_COMPILE_LEVEL 3
+#endif
+#endif
+
 /**
  * @brief Provides basic logging functionality with support for multiple log levels.
  *
  * This class allows logging messages to the console with various log levels
  * (Error, Warning, Info, Debug) and formatting support similar to fmt or Python-style
  * placeholders. Logging levels can be enabled or disabled at runtime.
+ *
+ * By default every message is formatted and printed on the calling thread. After StartAsync
+ * the arguments get copied into a per-thread lock-free ring buffer and a background thread
+ * formats and writes them in batches. Subscribers are then called from DispatchSubscribers.
  */
 class Log {
 private:
@@ -25,6 +49,20 @@ public:
         levelDebug
     };
 
+    // What happens when the ring buffer of a thread is full (only used in async mode).
+    enum class QueuePolicy : short {
+        Block,  // waits until the background thread made space, nothing gets lost
+        Drop    // drops the message and counts it, never stalls the caller
+    };
+
+    // Statistics of one log call site, a call site is identified by its format string literal (const char array).
+    struct SiteStats {
+        const char* format = nullptr;   // the format string literal of the call site
+        Level level = levelInfo;
+        uint64_t count = 0;             // calls that passed the level check
+        uint64_t suppressed = 0;        // calls that were dropped by the rate limit
+    };
+
     using LogCallback = std::function<void(Level LogLevel, const std::string&)>;
     using SubscriberID = size_t;
     /*
@@ -87,6 +125,67 @@ public:
     */
     static void SaveLogs(const std::string& path);
 
+    // ------------------------- Async logging -------------------------
+
+    /**
+    * @brief Starts the background log thread. From now on log calls only capture their arguments.
+    * @param policy What to do when the ring buffer of a thread is full
+    * @param capacityPerThread Number of messages each thread can queue (rounded up to a power of two)
+    */
+    static void StartAsync(QueuePolicy policy = QueuePolicy::Block, size_t capacityPerThread = 2048);
+
+    /**
+    * @brief Writes all pending messages, stops the background thread and falls back to synchronous logging.
+    */
+    static void StopAsync();
+
+    /// Returns true if log calls are handled by the background thread.
+    static bool IsAsync();
+
+    /**
+    * @brief Formats and writes every message that is currently queued. Blocks until done.
+    */
+    static void Flush();
+
+    /**
+    * @brief Calls the subscribers with all messages that were written since the last call.
+    * In async mode subscribers are not called from the log call, this has to be called
+    * regularly from the thread that owns the subscribers (the engine does this once per frame).
+    */
+    static void DispatchSubscribers();
+
+    /// Number of messages that were dropped because a ring buffer was full (QueuePolicy::Drop).
+    static size_t GetDroppedCount();
+
+    // ------------------------- Flood suppression -------------------------
+
+    // default rate limit of the Log::Limited call sites: a burst of 20 messages, then 5 per second
+    static constexpr double DEFAULT_RATE_LIMIT = 5.0;
+    static constexpr uint32_t DEFAULT_RATE_BURST = 20;
+
+    /**
+    * @brief Limits how often a single Log::Limited call site can log. Every such call site has a budget of
+    * burst messages that refills with messagesPerSecond. Suppressed calls are not formatted, they get counted
+    * and reported with the next message of the same call site. The other log calls are never limited.
+    * @param messagesPerSecond refill rate of the budget, <= 0 disables the rate limit
+    * @param burst number of messages a call site can log at once
+    */
+    static void SetRateLimit(double messagesPerSecond, uint32_t burst);
+
+    /**
+    * @brief If enabled identical consecutive messages are written once, followed by
+    * a "last message repeated N times" line when a different message arrives. Enabled by default.
+    */
+    static void SetCollapseRepeats(bool value);
+
+    /**
+    * @brief Gets the counters of every call site that logged so far, sorted by call count (highest first).
+    */
+    static std::vector<SiteStats> GetSiteStats();
+
+    /// Resets the counters of all call sites.
+    static void ResetSiteStats();
+
     // ------------------------- Logging Methods -------------------------
 
     /**
@@ -98,15 +197,19 @@ public:
         std::is_convertible_v<T, std::string> || std::is_convertible_v<T, const char*>
         >>
         static void Error(T&& format, Args&&... args) {
-        if (!m_levelError) return;
-        m_print(levelError, "[ERROR]: " + FormatUtils::formatString(std::forward<T>(format), std::forward<Args>(args)...));
+        if constexpr (levelError <= LOG_COMPILE_LEVEL) {
+            if (!m_levelError) return;
+            Write<FormatMode::Format>(levelError, "[ERROR]: ", std::forward<T>(format), std::forward<Args>(args)...);
+        }
     }
 
     /// Logs a raw error message composed from arguments, without format string.
     template<typename... Args>
     static void Error(Args&&... args) {
-        if (!m_levelError) return;
-        m_print(levelError, "[ERROR]: " + FormatUtils::joinArgs(std::forward<Args>(args)...));
+        if constexpr (levelError <= LOG_COMPILE_LEVEL) {
+            if (!m_levelError) return;
+            Write<FormatMode::Join>(levelError, "[ERROR]: ", std::forward<Args>(args)...);
+        }
     }
 
     /// Logs a formatted warning message.
@@ -115,15 +218,19 @@ public:
         std::is_convertible_v<T, std::string> || std::is_convertible_v<T, const char*>
         >>
         static void Warn(T&& format, Args&&... args) {
-        if (!m_levelWarning) return;
-        m_print(levelWarning, "[WARNING]: " + FormatUtils::formatString(std::forward<T>(format), std::forward<Args>(args)...));
+        if constexpr (levelWarning <= LOG_COMPILE_LEVEL) {
+            if (!m_levelWarning) return;
+            Write<FormatMode::Format>(levelWarning, "[WARNING]: ", std::forward<T>(format), std::forward<Args>(args)...);
+        }
     }
 
     /// Logs a raw warning message.
     template<typename... Args>
     static void Warn(Args&&... args) {
-        if (!m_levelWarning) return;
-        m_print(levelWarning, "[WARNING]: " + FormatUtils::joinArgs(std::forward<Args>(args)...));
+        if constexpr (levelWarning <= LOG_COMPILE_LEVEL) {
+            if (!m_levelWarning) return;
+            Write<FormatMode::Join>(levelWarning, "[WARNING]: ", std::forward<Args>(args)...);
+        }
     }
 
     /// Logs an informational message using format string.
@@ -132,15 +239,19 @@ public:
         std::is_convertible_v<T, std::string> || std::is_convertible_v<T, const char*>
         >>
         static void Info(T&& format, Args&&... args) {
-        if (!m_levelInfo) return;
-        m_print(levelInfo, "[INFO]: " + FormatUtils::formatString(std::forward<T>(format), std::forward<Args>(args)...));
+        if constexpr (levelInfo <= LOG_COMPILE_LEVEL) {
+            if (!m_levelInfo) return;
+            Write<FormatMode::Format>(levelInfo, "[INFO]: ", std::forward<T>(format), std::forward<Args>(args)...);
+        }
     }
 
     /// Logs an informational message with argument joining.
     template<typename... Args>
     static void Info(Args&&... args) {
-        if (!m_levelInfo) return;
-        m_print(levelInfo, "[INFO]: " + FormatUtils::joinArgs(std::forward<Args>(args)...));
+        if constexpr (levelInfo <= LOG_COMPILE_LEVEL) {
+            if (!m_levelInfo) return;
+            Write<FormatMode::Join>(levelInfo, "[INFO]: ", std::forward<Args>(args)...);
+        }
     }
 
     /// Logs a debug message with formatting.
@@ -149,15 +260,19 @@ public:
         std::is_convertible_v<T, std::string> || std::is_convertible_v<T, const char*>
         >>
         static void Debug(T&& format, Args&&... args) {
-        if (!m_levelDebug) return;
-        m_print(levelDebug, "[Debug]: " + FormatUtils::formatString(std::forward<T>(format), std::forward<Args>(args)...));
+        if constexpr (levelDebug <= LOG_COMPILE_LEVEL) {
+            if (!m_levelDebug) return;
+            Write<FormatMode::Format>(levelDebug, "[Debug]: ", std::forward<T>(format), std::forward<Args>(args)...);
+        }
     }
 
     /// Logs a debug message without formatting.
     template<typename... Args>
     static void Debug(Args&&... args) {
-        if (!m_levelDebug) return;
-        m_print(levelDebug, "[Debug]: " + FormatUtils::joinArgs(std::forward<Args>(args)...));
+        if constexpr (levelDebug <= LOG_COMPILE_LEVEL) {
+            if (!m_levelDebug) return;
+            Write<FormatMode::Join>(levelDebug, "[Debug]: ", std::forward<Args>(args)...);
+        }
     }
 
     /// Prints a formatted string without log level prefix.
@@ -166,13 +281,13 @@ public:
         std::is_convertible_v<T, std::string> || std::is_convertible_v<T, const char*>
         >>
         static void Print(T&& format, Args&&... args) {
-        m_print(levelInfo, FormatUtils::formatString(std::forward<T>(format), std::forward<Args>(args)...));
+        Write<FormatMode::Format>(levelInfo, "", std::forward<T>(format), std::forward<Args>(args)...);
     }
 
     /// Prints joined arguments without log level prefix.
     template<typename... Args>
     static void Print(Args&&... args) {
-        m_print(levelInfo, FormatUtils::joinArgs(std::forward<Args>(args)...));
+        Write<FormatMode::Join>(levelInfo, "", std::forward<Args>(args)...);
     }
 
     /// Conditionally prints a formatted string based on log level.
@@ -182,14 +297,14 @@ public:
         >>
         static void Print(Level level, T&& format, Args&&... args) {
         if (!IsLevelSelected(level)) return;
-        m_print(level, FormatUtils::formatString(std::forward<T>(format), std::forward<Args>(args)...));
+        Write<FormatMode::Format>(level, "", std::forward<T>(format), std::forward<Args>(args)...);
     }
 
     /// Conditionally prints joined arguments based on log level.
     template<typename... Args>
     static void Print(Level level, Args&&... args) {
         if (!IsLevelSelected(level)) return;
-        m_print(level, FormatUtils::joinArgs(std::forward<Args>(args)...));
+        Write<FormatMode::Join>(level, "", std::forward<Args>(args)...);
     }
 
     /// Returns a formatted string for reuse (without printing).
@@ -207,9 +322,224 @@ public:
         return FormatUtils::joinArgs(std::forward<Args>(args)...);
     }
 
+    /**
+    * @brief Rate limited logging for call sites that can fire every frame (see SetRateLimit).
+    * The format has to be a string literal, it identifies the call site.
+    * Usage: Log::Limited::Warn("Engine: No camera available");
+    */
+    struct Limited {
+        Limited() = delete;
+
+        template<size_t N, typename... Args>
+        static void Error(const char(&format)[N], Args&&... args) {
+            if constexpr (levelError <= LOG_COMPILE_LEVEL) {
+                if (!m_levelError) return;
+                Write<FormatMode::Format, true>(levelError, "[ERROR]: ", format, std::forward<Args>(args)...);
+            }
+        }
+
+        template<size_t N, typename... Args>
+        static void Warn(const char(&format)[N], Args&&... args) {
+            if constexpr (levelWarning <= LOG_COMPILE_LEVEL) {
+                if (!m_levelWarning) return;
+                Write<FormatMode::Format, true>(levelWarning, "[WARNING]: ", format, std::forward<Args>(args)...);
+            }
+        }
+
+        template<size_t N, typename... Args>
+        static void Info(const char(&format)[N], Args&&... args) {
+            if constexpr (levelInfo <= LOG_COMPILE_LEVEL) {
+                if (!m_levelInfo) return;
+                Write<FormatMode::Format, true>(levelInfo, "[INFO]: ", format, std::forward<Args>(args)...);
+            }
+        }
+
+        template<size_t N, typename... Args>
+        static void Debug(const char(&format)[N], Args&&... args) {
+            if constexpr (levelDebug <= LOG_COMPILE_LEVEL) {
+                if (!m_levelDebug) return;
+                Write<FormatMode::Format, true>(levelDebug, "[Debug]: ", format, std::forward<Args>(args)...);
+            }
+        }
+    };
+
 private:
     Log() = delete;
 
+    enum class FormatMode : short {
+        Format, // first argument is the format string
+        Join    // all arguments get joined
+    };
+
+    static constexpr size_t RECORD_STORAGE_SIZE = 160;
+
+    /*
+    * @brief One queued log call. The arguments are stored in binary form inside storage,
+    * format turns them into the message and destroys them.
+    */
+    struct Record {
+        using FormatFn = void(*)(void* storage, std::string& outMessage);
+
+        FormatFn format = nullptr;
+        uint64_t sequence = 0;
+        const char* prefix = "";
+        Level level = levelInfo;
+        uint32_t suppressed = 0; // calls of the same site that were rate limited before this one
+        alignas(16) unsigned char storage[RECORD_STORAGE_SIZE];
+    };
+
+    /*
+    * A const char array is taken as string literal, it lives until the program ends.
+    * Writable char arrays (buffers) and char pointers can be gone before the log thread formats them.
+    */
+    template<typename T>
+    static constexpr bool IsLiteral = std::is_array_v<std::remove_reference_t<T>> &&
+        std::is_same_v<std::remove_extent_t<std::remove_reference_t<T>>, const char>;
+    template<typename T>
+    static constexpr bool IsCString = std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>;
+
+    // string literals are kept as pointer, every other format string gets copied
+    template<typename T>
+    using FormatCapture = std::conditional_t<IsLiteral<T>, const char*, std::string>;
+    // char arrays, char pointers and string views get copied as string (prints the same), everything else by value
+    template<typename T>
+    using ArgCapture = std::conditional_t<
+        std::is_array_v<std::remove_reference_t<T>> || IsCString<T> || std::is_same_v<std::decay_t<T>, std::string_view>,
+        std::string, std::decay_t<T>>;
+
+    // copies the text of a char pointer at the log call, nullptr can not construct a string
+    template<typename T>
+    static decltype(auto) CaptureArg(T&& arg) {
+        if constexpr (IsCString<T> && !IsLiteral<T>) {
+            // arrays can not be null, only pointers need the check
+            if constexpr (std::is_pointer_v<std::remove_reference_t<T>>)
+                return arg ? std::string(arg) : std::string("(null)");
+            else
+                return std::string(arg);
+        }
+        else
+            return std::forward<T>(arg);
+    }
+
+    template<FormatMode Mode, typename... Args>
+    struct CaptureTuple {
+        using type = std::tuple<ArgCapture<Args>...>;
+    };
+
+    template<typename T, typename... Args>
+    struct CaptureTuple<FormatMode::Format, T, Args...> {
+        using type = std::tuple<FormatCapture<T>, ArgCapture<Args>...>;
+    };
+
+    template<typename Tuple>
+    static constexpr bool FitsRecord = sizeof(Tuple) <= RECORD_STORAGE_SIZE && alignof(Tuple) <= 16;
+
+    template<FormatMode Mode, typename... Args>
+    static std::string FormatMessage(Args&&... args) {
+        if constexpr (Mode == FormatMode::Format)
+            return FormatUtils::formatString(std::forward<Args>(args)...);
+        else
+            return FormatUtils::joinArgs(std::forward<Args>(args)...);
+    }
+
+    template<FormatMode Mode, typename Tuple>
+    static void FormatRecord(void* storage, std::string& outMessage) {
+        Tuple* args = std::launder(reinterpret_cast<Tuple*>(storage));
+        outMessage = std::apply([](auto&... values) {
+            return FormatMessage<Mode>(values...);
+        }, *args);
+        args->~Tuple();
+    }
+
+    // the format string literal (or first literal argument) identifies the call site
+    template<typename T, typename... Rest>
+    static const char* GetSiteKey(T&& first, Rest&&...) {
+        if constexpr (IsLiteral<T>)
+            return first;
+        else
+            return nullptr;
+    }
+
+    static const char* GetSiteKey() {
+        return nullptr;
+    }
+
+    /*
+    * @brief Counts the call and checks the rate limit of the call site.
+    * @param limited only Log::Limited calls check the rate limit
+    * @param outSuppressed Number of calls that were suppressed since the last message of this site
+    * @return false if the message should be suppressed
+    */
+    static bool AllowSite(const char* site, Level level, bool limited, uint32_t& outSuppressed);
+
+    /// Note that gets appended to a message when calls of the same site were suppressed before.
+    static std::string GetSuppressedNote(uint32_t suppressed);
+
+    template<FormatMode Mode, typename Tuple, typename... Args>
+    static void Enqueue(Level level, const char* prefix, uint32_t suppressed, Args&&... args) {
+        Record* record = AcquireRecord();
+        // the ring buffer was full (QueuePolicy::Drop)
+        if (!record)
+            return;
+
+        new (record->storage) Tuple(CaptureArg(std::forward<Args>(args))...);
+        record->format = &FormatRecord<Mode, Tuple>;
+        record->level = level;
+        record->prefix = prefix;
+        record->suppressed = suppressed;
+        CommitRecord(record);
+    }
+
+    template<FormatMode Mode, bool RateLimited = false, typename... Args>
+    static void Write(Level level, const char* prefix, Args&&... args) {
+        uint32_t suppressed = 0;
+        if (const char* site = GetSiteKey(args...)) {
+            if (!AllowSite(site, level, RateLimited, suppressed))
+                return;
+        }
+
+        if (m_async.load(std::memory_order_acquire)) {
+            using Tuple = typename CaptureTuple<Mode, Args...>::type;
+            if constexpr (FitsRecord<Tuple>) {
+                Enqueue<Mode, Tuple>(level, prefix, suppressed, std::forward<Args>(args)...);
+            }
+            else {
+                // too large for a record, gets formatted here but is still written in order
+                Enqueue<FormatMode::Join, std::tuple<std::string>>(level, prefix, suppressed, FormatMessage<Mode>(std::forward<Args>(args)...));
+            }
+            return;
+        }
+
+        std::string message = prefix + FormatMessage<Mode>(std::forward<Args>(args)...);
+        if (suppressed > 0)
+            message += GetSuppressedNote(suppressed);
+        m_print(level, message);
+    }
+
+    class RingBuffer;
+    class AsyncState;
+    class SiteTable;
+
+    /// Lock-free table of all call sites with their counters and rate limit state.
+    static SiteTable& GetSiteTable();
+
+    /// Lazily created state of the async mode (ring buffers, background thread, pending subscriber messages).
+    static AsyncState& GetAsyncState();
+    /// Ring buffer of the calling thread, registered on first use.
+    static RingBuffer& GetThreadRing();
+
+    /*
+    * @brief Gets the next free record of the ring buffer of this thread.
+    * @return nullptr if the record was dropped
+    */
+    static Record* AcquireRecord();
+    /*
+    * @brief Publishes a record that was filled after AcquireRecord.
+    */
+    static void CommitRecord(Record* record);
+
+    static std::atomic<bool> m_async;
+
     // Flags to track active log levels.
     static bool m_levelError;
     static bool m_levelWarning;
@@ -226,8 +556,10 @@ private:
     static std::vector<Subscriber> m_subscribers;
     static SubscriberID m_nextId;
 
-    /// Low-level printer implementation (console output).
+    /// Low-level printer implementation (console output), collapses repeated messages.
     static void m_print(const Level& logLevel, const std::string& message);
+    /// Writes the message to the console, subscribers and log file without collapsing.
+    static void m_printDirect(const Level& logLevel, const std::string& message);
 
     /// Helper for formatted print with extra arguments.
     template<typename... Args>
@@ -240,6 +572,8 @@ private:
         AsyncLogger(const std::string& filename);
         ~AsyncLogger();
         void Log(const std::string& message);
+        /// Writes multiple lines at once, every line needs to end with '\n'.
+        void LogBatch(std::string&& lines);
 
     private:
         //void ProcessQueue();
@@ -0,0 +1,218 @@
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include "CoreLib\ImageUtils.h"
+
+#include "CoreLib\Log.h"
+
+namespace {
+
+    const std::array<uint32_t, 256>& GetCRCTable() {
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> result{};
+            for (uint32_t n = 0; n < 256; n++) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                result[n] = c;
+            }
+            return result;
+        }();
+        return table;
+    }
+
+    void AppendUInt32(std::vector<unsigned char>& out, uint32_t value) {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void AppendChunk(std::vector<unsigned char>& out, const char* type, const std::vector<unsigned char>& data) {
+        AppendUInt32(out, static_cast<uint32_t>(data.size()));
+        size_t start = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+
+        // the crc covers the type and the data
+        const auto& table = GetCRCTable();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = start; i < out.size(); i++)
+            crc = table[(crc ^ out[i]) & 0xFF] ^ (crc >> 8);
+        AppendUInt32(out, crc ^ 0xFFFFFFFFu);
+    }
+
+    /*
+    * Writes deflate bits, least significant bit first
+    */
+    class BitWriter {
+    public:
+        BitWriter(std::vector<unsigned char>& out) : m_out(out) {}
+
+        void Write(uint32_t bits, int count) {
+            m_buffer |= bits << m_count;
+            m_count += count;
+            while (m_count >= 8) {
+                m_out.push_back(static_cast<unsigned char>(m_buffer));
+                m_buffer >>= 8;
+                m_count -= 8;
+            }
+        }
+
+        // huffman codes are stored most significant bit first
+        void WriteCode(uint32_t code, int length) {
+            uint32_t reversed = 0;
+            for (int i = 0; i < length; i++)
+                reversed |= ((code >> i) & 1) << (length - 1 - i);
+            Write(reversed, length);
+        }
+
+        void Flush() {
+            if (m_count > 0)
+                m_out.push_back(static_cast<unsigned char>(m_buffer));
+            m_buffer = 0;
+            m_count = 0;
+        }
+
+    private:
+        std::vector<unsigned char>& m_out;
+        uint32_t m_buffer = 0;
+        int m_count = 0;
+    };
+
+    void WriteLiteral(BitWriter& writer, int value) {
+        if (value < 144)
+            writer.WriteCode(0x30 + value, 8);
+        else if (value < 256)
+            writer.WriteCode(0x190 + (value - 144), 9);
+        else if (value < 280)
+            writer.WriteCode(value - 256, 7);
+        else
+            writer.WriteCode(0xC0 + (value - 280), 8);
+    }
+
+    void WriteLength(BitWriter& writer, int length) {
+        static const int bases[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const int extraBits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+        int code = 28;
+        while (bases[code] > length)
+            code--;
+        WriteLiteral(writer, 257 + code);
+        if (extraBits[code] > 0)
+            writer.Write(static_cast<uint32_t>(length - bases[code]), extraBits[code]);
+    }
+
+    /*
+    * zlib stream with one fixed Huffman block, only matches at distance 1 (runs of the same byte)
+    */
+    void Deflate(const std::vector<unsigned char>& data, std::vector<unsigned char>& out) {
+        const int MIN_MATCH = 3;
+        const int MAX_MATCH = 258;
+
+        out.push_back(0x78);
+        out.push_back(0x01);
+
+        BitWriter writer(out);
+        writer.Write(1, 1); // last block
+        writer.Write(1, 2); // fixed Huffman codes
+
+        size_t size = data.size();
+        size_t i = 0;
+        while (i < size) {
+            if (i > 0) {
+                unsigned char previous = data[i - 1];
+                size_t run = 0;
+                while (run < MAX_MATCH && i + run < size && data[i + run] == previous)
+                    run++;
+                if (run >= MIN_MATCH) {
+                    WriteLength(writer, static_cast<int>(run));
+                    writer.WriteCode(0, 5); // distance 1
+                    i += run;
+                    continue;
+                }
+            }
+            WriteLiteral(writer, data[i]);
+            i++;
+        }
+        WriteLiteral(writer, 256); // end of block
+        writer.Flush();
+
+        uint32_t a = 1, b = 0;
+        for (unsigned char byte : data) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        AppendUInt32(out, (b << 16) | a);
+    }
+
+}
+
+bool ImageUtils::EncodePNG(const unsigned char* pixels, int width, int height, int channels,
+    std::vector<unsigned char>& outData, bool flipVertically) {
+    static const unsigned char colorTypes[] = { 0, 4, 2, 6 };
+    if (pixels == nullptr || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+        Log::Error("ImageUtils: Invalid image {}x{} with {} channels", width, height, channels);
+        return false;
+    }
+
+    size_t rowSize = static_cast<size_t>(width) * channels;
+
+    // every row starts with its filter type, Sub stores the difference to the pixel on the left
+    std::vector<unsigned char> filtered;
+    filtered.reserve((rowSize + 1) * height);
+    for (int y = 0; y < height; y++) {
+        int sourceRow = (flipVertically) ? height - 1 - y : y;
+        const unsigned char* row = pixels + static_cast<size_t>(sourceRow) * rowSize;
+        filtered.push_back(1);
+        for (size_t x = 0; x < rowSize; x++) {
+            unsigned char left = (x >= static_cast<size_t>(channels)) ? row[x - channels] : 0;
+            filtered.push_back(static_cast<unsigned char>(row[x] - left));
+        }
+    }
+
+    std::vector<unsigned char> header;
+    AppendUInt32(header, static_cast<uint32_t>(width));
+    AppendUInt32(header, static_cast<uint32_t>(height));
+    header.push_back(8); // bit depth
+    header.push_back(colorTypes[channels - 1]);
+    header.push_back(0); // compression
+    header.push_back(0); // filter method
+    header.push_back(0); // no interlace
+
+    std::vector<unsigned char> compressed;
+    compressed.reserve(filtered.size() / 4);
+    Deflate(filtered, compressed);
+
+    static const unsigned char signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    outData.clear();
+    outData.insert(outData.end(), signature, signature + sizeof(signature));
+    AppendChunk(outData, "IHDR", header);
+    AppendChunk(outData, "IDAT", compressed);
+    AppendChunk(outData, "IEND", {});
+    return true;
+}
+
+bool ImageUtils::WritePNG(const std::string& path, const unsigned char* pixels, int width, int height,
+    int channels, bool flipVertically) {
+    std::vector<unsigned char> data;
+    if (!EncodePNG(pixels, width, height, channels, data, flipVertically))
+        return false;
+
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (!directory.empty())
+        std::filesystem::create_directories(directory);
+
+    // binary, a text stream would change the line endings in the data on windows
+    std::ofstream file(path, std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        Log::Error("ImageUtils: Could not open '{}' for writing", path);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return !file.fail();
+}
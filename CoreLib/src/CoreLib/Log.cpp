@@ -1,9 +1,13 @@
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <queue>
 #include <condition_variable>
 #include <fstream>
 #include <atomic>
+#include <bit>
+#include <chrono>
+#include <deque>
 #include <filesystem>
 
 #include "CoreLib\Log.h"
@@ -18,6 +22,7 @@ std::vector<Log::Subscriber> Log::m_subscribers;
 Log::SubscriberID Log::m_nextId = 0;
 bool Log::m_saveLogs = false;
 std::unique_ptr<Log::AsyncLogger> Log::m_asyncLogger = nullptr;
+std::atomic<bool> Log::m_async = false;
 
 Log::SubscriberID Log::Subscribe(LogCallback callback) {
     m_subscribers.push_back({ ++m_nextId, callback });
@@ -60,29 +65,44 @@ public:
     void Log(const std::string& message) {
         {
             std::unique_lock<std::mutex> lock(m_mutex);
-            m_queue.push(message);
+            m_queue.push_back(message + '\n');
+        }
+        m_cv.notify_one();
+    }
+
+    void LogBatch(std::string&& lines) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(lines));
         }
         m_cv.notify_one();
     }
 
 private:
     void ProcessQueue() {
+        std::vector<std::string> batch;
         while (true) {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_cv.wait(lock, [this]() { return !m_queue.empty() || m_exitFlag; });
-
-            while (!m_queue.empty()) {
-                m_outFile << m_queue.front() << std::endl;
-                m_queue.pop();
+            bool exit = false;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() { return !m_queue.empty() || m_exitFlag; });
+                batch.swap(m_queue);
+                exit = m_exitFlag;
             }
 
-            if (m_exitFlag)
+            // writes outside of the lock and flushes once per batch instead of once per line
+            for (const auto& lines : batch)
+                m_outFile << lines;
+            m_outFile.flush();
+            batch.clear();
+
+            if (exit)
                 break;
         }
     }
 
     std::ofstream m_outFile;
-    std::queue<std::string> m_queue;
+    std::vector<std::string> m_queue;
     std::mutex m_mutex;
     std::condition_variable m_cv;
     std::thread m_workerThread;
@@ -99,6 +119,561 @@ void Log::AsyncLogger::Log(const std::string& message) {
     pImpl->Log(message);
 }
 
+void Log::AsyncLogger::LogBatch(std::string&& lines) {
+    pImpl->LogBatch(std::move(lines));
+}
+
+namespace {
+
+    std::atomic<bool> g_collapseRepeats = true;
+
+    /*
+    * @brief Collapses identical consecutive messages. The repeats are counted and reported
+    * with one line once a different message arrives.
+    */
+    class RepeatCollapser {
+    public:
+        /*
+        * @param outNote gets the "repeated" line if a run of repeats ended with this message
+        * @return false if the message is a repeat of the previous one and should not be written
+        */
+        bool Accept(Log::Level level, const std::string& message, std::string& outNote, Log::Level& outNoteLevel) {
+            if (!g_collapseRepeats.load(std::memory_order_relaxed)) {
+                TakeNote(outNote, outNoteLevel);
+                m_last.clear();
+                return true;
+            }
+
+            if (level == m_lastLevel && message == m_last) {
+                m_repeats++;
+                return false;
+            }
+
+            TakeNote(outNote, outNoteLevel);
+            m_last = message;
+            m_lastLevel = level;
+            return true;
+        }
+
+        /*
+        * @brief Ends the current run of repeats.
+        * @return true if outNote was set
+        */
+        bool TakeNote(std::string& outNote, Log::Level& outNoteLevel) {
+            if (m_repeats == 0)
+                return false;
+
+            outNote = FormatUtils::formatString("(last message repeated {} times)", m_repeats);
+            outNoteLevel = m_lastLevel;
+            m_repeats = 0;
+            return true;
+        }
+
+    private:
+        std::string m_last;
+        Log::Level m_lastLevel = Log::levelInfo;
+        uint64_t m_repeats = 0;
+    };
+
+    // used by the synchronous path
+    std::mutex g_printMutex;
+    RepeatCollapser g_printCollapser;
+
+}
+
+/*
+* Open addressing table keyed by the address of the format string literal.
+* Every site is counted, only the Log::Limited sites check the rate limit.
+* Sites only get added, never removed, so a lookup is a few atomic loads.
+* The rate limit is a GCRA (virtual scheduling) per site: every message moves the
+* theoretical arrival time (tat) one interval forward, a message is allowed
+* as long as tat is at most burst - 1 intervals ahead of now.
+*/
+class Log::SiteTable {
+public:
+    bool Allow(const char* key, Level level, bool limited, uint32_t& outSuppressed) {
+        Site* site = Find(key, level);
+        // table is full, the site is not limited
+        if (!site)
+            return true;
+
+        site->count.fetch_add(1, std::memory_order_relaxed);
+        if (!limited)
+            return true;
+
+        int64_t interval = m_intervalNs.load(std::memory_order_relaxed);
+        if (interval > 0) {
+            int64_t window = interval * (m_burst.load(std::memory_order_relaxed) - 1);
+            int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+
+            int64_t tat = site->tat.load(std::memory_order_relaxed);
+            int64_t newTat = 0;
+            do {
+                int64_t start = std::max(tat, now);
+                if (start - now > window) {
+                    site->suppressed.fetch_add(1, std::memory_order_relaxed);
+                    site->pendingSuppressed.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                newTat = start + interval;
+            } while (!site->tat.compare_exchange_weak(tat, newTat, std::memory_order_relaxed));
+        }
+
+        outSuppressed = site->pendingSuppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    void SetRateLimit(double messagesPerSecond, uint32_t burst) {
+        int64_t interval = (messagesPerSecond > 0.0) ? static_cast<int64_t>(1e9 / messagesPerSecond) : 0;
+        m_intervalNs.store(interval, std::memory_order_relaxed);
+        m_burst.store(std::max<uint32_t>(burst, 1), std::memory_order_relaxed);
+    }
+
+    std::vector<SiteStats> GetStats() const {
+        std::vector<SiteStats> stats;
+        for (const auto& site : m_sites) {
+            const char* key = site.key.load(std::memory_order_acquire);
+            if (!key)
+                continue;
+
+            SiteStats& s = stats.emplace_back();
+            s.format = key;
+            s.level = site.level.load(std::memory_order_relaxed);
+            s.count = site.count.load(std::memory_order_relaxed);
+            s.suppressed = site.suppressed.load(std::memory_order_relaxed);
+        }
+
+        std::sort(stats.begin(), stats.end(),
+            [](const SiteStats& a, const SiteStats& b) { return a.count > b.count; });
+        return stats;
+    }
+
+    void Reset() {
+        for (auto& site : m_sites) {
+            site.count.store(0, std::memory_order_relaxed);
+            site.suppressed.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static constexpr size_t CAPACITY = 1024; // power of two
+
+    struct Site {
+        std::atomic<const char*> key = nullptr;
+        std::atomic<Level> level = levelInfo;
+        std::atomic<int64_t> tat = 0;
+        std::atomic<uint64_t> count = 0;
+        std::atomic<uint64_t> suppressed = 0;
+        std::atomic<uint32_t> pendingSuppressed = 0;
+    };
+
+    Site* Find(const char* key, Level level) {
+        size_t hash = (reinterpret_cast<uintptr_t>(key) >> 3) * 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i < CAPACITY; i++) {
+            Site& site = m_sites[(hash + i) & (CAPACITY - 1)];
+            const char* current = site.key.load(std::memory_order_acquire);
+            if (current == key)
+                return &site;
+
+            if (!current) {
+                site.level.store(level, std::memory_order_relaxed);
+                if (site.key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+                    return &site;
+                // another thread took the slot
+                if (current == key)
+                    return &site;
+            }
+        }
+        return nullptr;
+    }
+
+    Site m_sites[CAPACITY];
+    std::atomic<int64_t> m_intervalNs = static_cast<int64_t>(1e9 / DEFAULT_RATE_LIMIT);
+    std::atomic<uint32_t> m_burst = DEFAULT_RATE_BURST;
+};
+
+Log::SiteTable& Log::GetSiteTable() {
+    static SiteTable table;
+    return table;
+}
+
+bool Log::AllowSite(const char* site, Level level, bool limited, uint32_t& outSuppressed) {
+    return GetSiteTable().Allow(site, level, limited, outSuppressed);
+}
+
+std::string Log::GetSuppressedNote(uint32_t suppressed) {
+    return FormatUtils::formatString(" [{} similar messages suppressed]", suppressed);
+}
+
+void Log::SetRateLimit(double messagesPerSecond, uint32_t burst) {
+    GetSiteTable().SetRateLimit(messagesPerSecond, burst);
+}
+
+void Log::SetCollapseRepeats(bool value) {
+    g_collapseRepeats.store(value, std::memory_order_relaxed);
+}
+
+std::vector<Log::SiteStats> Log::GetSiteStats() {
+    return GetSiteTable().GetStats();
+}
+
+void Log::ResetSiteStats() {
+    GetSiteTable().Reset();
+}
+
+/*
+* Single producer (the owning thread), single consumer (whoever holds the drain mutex).
+* head and tail only grow, the slot is head & mask.
+*/
+class Log::RingBuffer {
+public:
+    RingBuffer(size_t capacity)
+        : m_records(std::make_unique<Record[]>(capacity)), m_capacity(capacity), m_mask(capacity - 1) {
+    }
+
+    Record* TryAcquire() {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= m_capacity)
+            return nullptr;
+        return &m_records[head & m_mask];
+    }
+
+    // returns the number of records that are queued after the commit
+    size_t Commit() {
+        size_t head = m_head.load(std::memory_order_relaxed) + 1;
+        m_head.store(head, std::memory_order_release);
+        return head - m_tail.load(std::memory_order_relaxed);
+    }
+
+    template<typename Func>
+    void Drain(Func&& func) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+        for (; tail != head; tail++)
+            func(m_records[tail & m_mask]);
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    bool IsEmpty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const {
+        return m_capacity;
+    }
+
+    // set when the owning thread exits, the ring gets deleted once it is drained
+    std::atomic<bool> retired = false;
+
+private:
+    std::unique_ptr<Record[]> m_records;
+    size_t m_capacity;
+    size_t m_mask;
+    alignas(64) std::atomic<size_t> m_head = 0;
+    alignas(64) std::atomic<size_t> m_tail = 0;
+};
+
+class Log::AsyncState {
+public:
+    struct Entry {
+        uint64_t sequence;
+        Level level;
+        std::string message;
+    };
+
+    ~AsyncState() {
+        Stop();
+    }
+
+    void Start(QueuePolicy policy, size_t capacityPerThread) {
+        Stop();
+        m_policy = policy;
+        m_capacity = std::bit_ceil(std::max<size_t>(capacityPerThread, 16));
+        m_exitFlag = false;
+        m_workerThread = std::thread(&AsyncState::ProcessRings, this);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_exitFlag = true;
+        }
+        m_wakeCV.notify_all();
+        if (m_workerThread.joinable())
+            m_workerThread.join();
+        // the worker is gone, drains what was committed while it was shutting down
+        Drain(true);
+    }
+
+    RingBuffer* CreateRing() {
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        return m_rings.emplace_back(std::make_unique<RingBuffer>(m_capacity)).get();
+    }
+
+    void Wake() {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_wakeRequested = true;
+        }
+        m_wakeCV.notify_one();
+    }
+
+    /*
+    * @brief Formats every committed record of all rings, writes them in sequence order
+    * and queues them for the subscribers.
+    * @param endRepeats writes the "repeated" line of the current run of repeats
+    */
+    void Drain(bool endRepeats = false) {
+        std::lock_guard<std::mutex> drainLock(m_drainMutex);
+
+        m_entries.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_ringMutex);
+            for (auto& ring : m_rings) {
+                ring->Drain([this](Record& record) {
+                    Entry& entry = m_entries.emplace_back();
+                    entry.sequence = record.sequence;
+                    entry.level = record.level;
+                    record.format(record.storage, entry.message);
+                    entry.message.insert(0, record.prefix);
+                    if (record.suppressed > 0)
+                        entry.message += GetSuppressedNote(record.suppressed);
+                });
+            }
+
+            m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                [](const auto& ring) { return ring->retired.load(std::memory_order_acquire) && ring->IsEmpty(); }),
+                m_rings.end());
+        }
+
+        size_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped > m_droppedReported) {
+            Entry& entry = m_entries.emplace_back();
+            entry.sequence = UINT64_MAX;
+            entry.level = levelWarning;
+            entry.message = FormatUtils::formatString("[WARNING]: Log: {} messages were dropped, the ring buffer was full", dropped - m_droppedReported);
+            m_droppedReported = dropped;
+        }
+
+        std::sort(m_entries.begin(), m_entries.end(),
+            [](const Entry& a, const Entry& b) { return a.sequence < b.sequence; });
+
+        m_output.clear();
+        for (auto& entry : m_entries) {
+            Entry note;
+            bool accept = m_collapser.Accept(entry.level, entry.message, note.message, note.level);
+            if (!note.message.empty())
+                m_output.push_back(std::move(note));
+            if (accept)
+                m_output.push_back(std::move(entry));
+        }
+        if (endRepeats) {
+            Entry note;
+            if (m_collapser.TakeNote(note.message, note.level))
+                m_output.push_back(std::move(note));
+        }
+
+        if (m_output.empty())
+            return;
+
+        m_batch.clear();
+        for (const auto& entry : m_output) {
+            m_batch += entry.message;
+            m_batch += '\n';
+        }
+
+        std::cout.write(m_batch.data(), static_cast<std::streamsize>(m_batch.size()));
+        std::cout.flush();
+        if (m_saveLogs && m_asyncLogger)
+            m_asyncLogger->LogBatch(std::string(m_batch));
+
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        for (auto& entry : m_output)
+            m_pending.push_back(std::move(entry));
+        // nobody dispatches, keeps only the newest messages
+        while (m_pending.size() > MAX_PENDING)
+            m_pending.pop_front();
+    }
+
+    void TakePending(std::vector<Entry>& outEntries) {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        outEntries.assign(std::make_move_iterator(m_pending.begin()), std::make_move_iterator(m_pending.end()));
+        m_pending.clear();
+    }
+
+    QueuePolicy GetPolicy() const {
+        return m_policy;
+    }
+
+    void AddDropped() {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t GetDropped() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    uint64_t NextSequence() {
+        return m_sequence.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t MAX_PENDING = 4096;
+    static constexpr auto WAKE_INTERVAL = std::chrono::milliseconds(5);
+
+    void ProcessRings() {
+        while (true) {
+            bool exit = false;
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wakeCV.wait_for(lock, WAKE_INTERVAL, [this]() { return m_exitFlag || m_wakeRequested; });
+                m_wakeRequested = false;
+                exit = m_exitFlag;
+            }
+
+            Drain();
+
+            if (exit)
+                break;
+        }
+    }
+
+    QueuePolicy m_policy = QueuePolicy::Block;
+    size_t m_capacity = 2048;
+
+    std::mutex m_ringMutex;
+    std::vector<std::unique_ptr<RingBuffer>> m_rings;
+
+    std::mutex m_drainMutex;
+    std::vector<Entry> m_entries;
+    std::vector<Entry> m_output;
+    RepeatCollapser m_collapser;
+    std::string m_batch;
+
+    std::mutex m_pendingMutex;
+    std::deque<Entry> m_pending;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCV;
+    std::thread m_workerThread;
+    bool m_exitFlag = false;
+    bool m_wakeRequested = false;
+
+    std::atomic<uint64_t> m_sequence = 0;
+    std::atomic<size_t> m_dropped = 0;
+    size_t m_droppedReported = 0;
+};
+
+Log::AsyncState& Log::GetAsyncState() {
+    // destroyed at exit, which stops the worker and writes the remaining messages
+    static AsyncState state;
+    return state;
+}
+
+Log::RingBuffer& Log::GetThreadRing() {
+    struct ThreadRing {
+        RingBuffer* ring = nullptr;
+        ~ThreadRing() {
+            if (ring)
+                ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local ThreadRing threadRing;
+    if (!threadRing.ring)
+        threadRing.ring = GetAsyncState().CreateRing();
+    return *threadRing.ring;
+}
+
+Log::Record* Log::AcquireRecord() {
+    RingBuffer& ring = GetThreadRing();
+    Record* record = ring.TryAcquire();
+    if (record)
+        return record;
+
+    AsyncState& state = GetAsyncState();
+    if (state.GetPolicy() == QueuePolicy::Drop) {
+        state.AddDropped();
+        return nullptr;
+    }
+
+    // QueuePolicy::Block, waits for the worker to make space
+    while (!(record = ring.TryAcquire())) {
+        if (!m_async.load(std::memory_order_acquire)) {
+            state.AddDropped();
+            return nullptr;
+        }
+        state.Wake();
+        std::this_thread::yield();
+    }
+    return record;
+}
+
+void Log::CommitRecord(Record* record) {
+    AsyncState& state = GetAsyncState();
+    record->sequence = state.NextSequence();
+
+    RingBuffer& ring = GetThreadRing();
+    // wakes the worker early once the ring is half full, otherwise it picks the records up on its next tick
+    if (ring.Commit() == ring.GetCapacity() / 2)
+        state.Wake();
+}
+
+void Log::StartAsync(QueuePolicy policy, size_t capacityPerThread) {
+    if (m_async.load(std::memory_order_acquire))
+        return;
+
+    GetAsyncState().Start(policy, capacityPerThread);
+    m_async.store(true, std::memory_order_release);
+}
+
+void Log::StopAsync() {
+    if (!m_async.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    GetAsyncState().Stop();
+    DispatchSubscribers();
+}
+
+bool Log::IsAsync() {
+    return m_async.load(std::memory_order_acquire);
+}
+
+void Log::Flush() {
+    if (m_async.load(std::memory_order_acquire)) {
+        GetAsyncState().Drain(true);
+    }
+    else {
+        std::string note;
+        Level noteLevel = levelInfo;
+        bool hasNote = false;
+        {
+            std::lock_guard<std::mutex> lock(g_printMutex);
+            hasNote = g_printCollapser.TakeNote(note, noteLevel);
+        }
+        if (hasNote)
+            m_printDirect(noteLevel, note);
+    }
+    std::cout.flush();
+}
+
+void Log::DispatchSubscribers() {
+    static std::vector<AsyncState::Entry> entries;
+    GetAsyncState().TakePending(entries);
+
+    for (const auto& entry : entries) {
+        for (auto& sub : m_subscribers) {
+            sub.callback(entry.level, entry.message);
+        }
+    }
+    entries.clear();
+}
+
+size_t Log::GetDroppedCount() {
+    return GetAsyncState().GetDropped();
+}
+
 void Log::ClearLog() {
     system("cls");
 }
@@ -129,7 +704,23 @@ void Log::SaveLogs(const std::string& path) {
 
 
 void Log::m_print(const Level& logLevel, const std::string& message) {
-    std::cout << message << std::endl;
+    std::string note;
+    Level noteLevel = levelInfo;
+    {
+        std::lock_guard<std::mutex> lock(g_printMutex);
+        if (!g_printCollapser.Accept(logLevel, message, note, noteLevel))
+            return;
+    }
+    if (!note.empty())
+        m_printDirect(noteLevel, note);
+    m_printDirect(logLevel, message);
+}
+
+void Log::m_printDirect(const Level& logLevel, const std::string& message) {
+    // only errors flush right away, everything else is flushed with the stream buffer
+    std::cout << message << '\n';
+    if (logLevel == levelError)
+        std::cout.flush();
 
     for (auto& sub : m_subscribers) {
         sub.callback(logLevel, message);
@@ -4,6 +4,9 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 #include <String>
+#include <cstdint>
+#include <functional>
+#include <vector>
 
 #include <CoreLib\Math\Vector3.h>
 #include "Input.h"
@@ -30,6 +33,15 @@ public:
 		Hidden
 	};
 
+	/**
+	* @brief How the GL context of the offscreen mode is created
+	*/
+	enum class ContextAPI {
+		Native,	// hidden window of the platform
+		EGL,	// surfaceless, without display server (e.g. Mesa llvmpipe)
+		OSMesa	// software rendering, without display server
+	};
+
 	virtual ~Application() = default;
 
 	virtual void Start();
@@ -39,6 +51,17 @@ public:
 	virtual void OnWindowResize(int newWidth, int newHeight);
 	virtual void OnWindowFocusLost();
 	virtual void OnWindowFocusGain();
+	/**
+	* @brief Called for every frame that took longer than the frame budget (see App_Profiler_Set_FrameBudget).
+	* The zones of the frame can be read with EngineCore::Profiler::GetLastFrameZones
+	*/
+	virtual void OnFrameBudgetExceeded(double frameTimeMs);
+	/**
+	* @brief Called with every frame read back in offscreen mode (see App_Offscreen_Set_Enabled).
+	* The readback is asynchronous, so the frame arrives a few frames after it was rendered
+	* @param pixels RGBA8, top row first
+	*/
+	virtual void OnOffscreenFrame(uint64_t frameIndex, int width, int height, const std::vector<unsigned char>& pixels);
 
 	static Application* GetInstance();
 
@@ -115,6 +138,123 @@ public:
 	*/
 	void App_Debug_Set_DebugKey(EngineCore::KeyCode key);
 
+	// Profiler
+	bool App_Profiler_Get_Capture() const;
+	EngineCore::KeyCode App_Profiler_Get_CaptureKey() const;
+	std::string App_Profiler_Get_CapturePath() const;
+	float App_Profiler_Get_FrameBudget() const;
+
+	/**
+	* @brief Starts or stops recording a profiler capture. The capture is a ring buffer,
+	* so it can run the whole session and keeps the last events.
+	*/
+	void App_Profiler_Set_Capture(bool value);
+	/**
+	* @brief Sets the key that saves the profiler capture as Chrome trace JSON (default F11).
+	* If no capture is running the first press starts one.
+	*/
+	void App_Profiler_Set_CaptureKey(EngineCore::KeyCode key);
+	/**
+	* @brief Sets where captures are saved (default "profiler/capture").
+	* needs to be path/name. no extension, date and time get appended
+	*/
+	void App_Profiler_Set_CapturePath(const std::string& path);
+	/**
+	* @brief Sets the frame budget in milliseconds (default 0 = off). Frames that take longer
+	* log their zone breakdown (rate limited, see Log::Limited) and call OnFrameBudgetExceeded
+	*/
+	void App_Profiler_Set_FrameBudget(float milliseconds);
+
+	// Benchmark
+	bool App_Benchmark_Get_Enabled() const;
+	double App_Benchmark_Get_FixedDeltaTime() const;
+	uint64_t App_Benchmark_Get_FrameLimit() const;
+	double App_Benchmark_Get_DurationLimit() const;
+	std::string App_Benchmark_Get_OutputPath() const;
+	uint64_t App_Benchmark_Get_WarmupFrames() const;
+	std::string App_Benchmark_Get_Baseline() const;
+	double App_Benchmark_Get_Threshold() const;
+	bool App_Benchmark_Get_UpdateBaseline() const;
+
+	/**
+	* @brief Runs the engine as deterministic benchmark: every frame advances the time by the fixed
+	* delta time, the run stops at the frame or duration limit and the timing of every frame is written
+	* to the output path (CSV and JSON) at exit. Combined with App_Application_Set_Header(false) no window
+	* or GL context is created and the renderer uses the recording device (unless App_Offscreen_Set_Enabled).
+	* Has to be set before EngineStart
+	*/
+	void App_Benchmark_Set_Enabled(bool value);
+	/**
+	* @brief Sets the simulated time between two frames in seconds (default 1/60)
+	*/
+	void App_Benchmark_Set_FixedDeltaTime(double seconds);
+	/**
+	* @brief Stops the benchmark after this many frames (default 600, 0 = no limit)
+	*/
+	void App_Benchmark_Set_FrameLimit(uint64_t frames);
+	/**
+	* @brief Stops the benchmark once this much simulated time passed in seconds (default 0 = no limit)
+	*/
+	void App_Benchmark_Set_DurationLimit(double seconds);
+	/**
+	* @brief Replaces the simulated clock (frame * fixed delta time) with a custom one that returns seconds.
+	* nullptr restores the simulated clock
+	*/
+	void App_Benchmark_Set_Clock(std::function<double()> clock);
+	/**
+	* @brief Sets where the frame timings are saved (default "benchmark/frames").
+	* needs to be path/name. no extension, .csv and .json get appended
+	*/
+	void App_Benchmark_Set_OutputPath(const std::string& path);
+	/**
+	* @brief Frames that run before the recording starts, they do not count towards the frame limit (default 0)
+	*/
+	void App_Benchmark_Set_WarmupFrames(uint64_t frames);
+	/**
+	* @brief Sets a baseline file (see FrameRecorder::WriteBaseline). At the end of the run the metrics are
+	* compared against it and EngineLoop returns ENGINE_FAILURE if one regressed. Empty disables the check (default)
+	*/
+	void App_Benchmark_Set_Baseline(const std::string& path);
+	/**
+	* @brief Relative growth of a metric that counts as regression (default 0.1 = 10%)
+	*/
+	void App_Benchmark_Set_Threshold(double threshold);
+	/**
+	* @brief Writes the metrics of the run to the baseline file instead of comparing against it
+	*/
+	void App_Benchmark_Set_UpdateBaseline(bool value);
+
+	// Offscreen
+	bool App_Offscreen_Get_Enabled() const;
+	ContextAPI App_Offscreen_Get_ContextAPI() const;
+	size_t App_Offscreen_Get_ReadbackBufferCount() const;
+	std::string App_Offscreen_Get_DumpPath() const;
+	uint64_t App_Offscreen_Get_DumpInterval() const;
+
+	/**
+	* @brief Renders into a framebuffer of the window size instead of a visible window and reads every
+	* frame back asynchronously (see OnOffscreenFrame). Works without App_Application_Set_Header,
+	* the GL context then belongs to a hidden window. Has to be set before EngineStart
+	*/
+	void App_Offscreen_Set_Enabled(bool value);
+	/**
+	* @brief Sets how the GL context is created (default Native). EGL and OSMesa need no display server
+	*/
+	void App_Offscreen_Set_ContextAPI(ContextAPI api);
+	/**
+	* @brief Size of the readback ring (default 3). More buffers stall less but deliver the frames later
+	*/
+	void App_Offscreen_Set_ReadbackBufferCount(size_t count);
+	/**
+	* @brief Writes the read back frames as PNG sequence (path/name, _<frame>.png gets appended).
+	* Empty disables the dump (default)
+	*/
+	void App_Offscreen_Set_DumpPath(const std::string& path);
+	/**
+	* @brief Only every n-th frame is dumped (default 1 = every frame)
+	*/
+	void App_Offscreen_Set_DumpInterval(uint64_t frames);
+
 private:
 	static Application* s_instance;
 
@@ -147,5 +287,27 @@ private:
 	bool m_appDebugIsDebugCameraActive = false;
 	EngineCore::KeyCode m_appDebugKey = EngineCore::KeyCode::F12;
 
+	bool m_appProfilerCapture = false;
+	EngineCore::KeyCode m_appProfilerCaptureKey = EngineCore::KeyCode::F11;
+	std::string m_appProfilerCapturePath = "profiler/capture";
+	float m_appProfilerFrameBudget = 0.0f;
+
+	bool m_appBenchmarkEnabled = false;
+	double m_appBenchmarkFixedDeltaTime = 1.0 / 60.0;
+	uint64_t m_appBenchmarkFrameLimit = 600;
+	double m_appBenchmarkDurationLimit = 0.0;
+	std::function<double()> m_appBenchmarkClock;
+	std::string m_appBenchmarkOutputPath = "benchmark/frames";
+	uint64_t m_appBenchmarkWarmupFrames = 0;
+	std::string m_appBenchmarkBaseline;
+	double m_appBenchmarkThreshold = 0.1;
+	bool m_appBenchmarkUpdateBaseline = false;
+
+	bool m_appOffscreenEnabled = false;
+	ContextAPI m_appOffscreenContextAPI = ContextAPI::Native;
+	size_t m_appOffscreenReadbackBufferCount = 3;
+	std::string m_appOffscreenDumpPath;
+	uint64_t m_appOffscreenDumpInterval = 1;
+
 	GLFWwindow* m_window = nullptr;
 };
\ No newline at end of file
@@ -21,12 +21,14 @@ namespace EngineCore {
 				ShaderID Default();
 				ShaderID DefaultText();
 				ShaderID DefaultUI();
+				ShaderID DefaultUILayer();
 			}
 
 			namespace MATERIAL {
 				MaterialID Default();
 				MaterialID DefaultText();
 				MaterialID DefaultUI();
+				MaterialID DefaultUILayer();
 			}
 
 			namespace FONT {
@@ -2,11 +2,14 @@
 #include <string>
 #include <CoreLib\ConversionUtils.h>
 #include <CoreLib\Math\Matrix4x4.h>
+#include <CoreLib\Math\Vector4.h>
 
 #include "..\ComponentBase.h"
+#include "..\Frustum.h"
 
 namespace EngineCore {
 	class Engine;
+	class OffscreenTarget;
 
 	namespace Component {
 
@@ -29,9 +32,29 @@ namespace EngineCore {
 			float GetAspectRatio() const;
 			float GetNearPlane() const;
 			float GetFarPlane() const;
-			Matrix4x4 GetProjectionMatrix();
-			Matrix4x4 GetViewMatrix();
+			/**
+			* @brief The matrices and the frustum are cached, they are only rebuilt when the camera moved or a setting changed
+			*/
+			const Matrix4x4& GetProjectionMatrix();
+			const Matrix4x4& GetViewMatrix();
+			/**
+			* @brief Gets projection * view
+			*/
+			const Matrix4x4& GetViewProjectionMatrix();
+			const Frustum& GetFrustum();
+			int GetPriority() const;
+			bool IsAdditional() const;
+			/**
+			* @brief Gets the viewport, x, y, width and height in 0 - 1 of the window
+			*/
+			Vector4 GetViewport() const;
+			OffscreenTarget* GetRenderTarget() const;
+			Vector4 GetBackgroundColor() const;
 			const std::vector<RenderLayerID>& GetRenderLayers() const;
+			/**
+			* @brief Gets the bits of the render layers of the camera (see RenderLayerManager::GetLayerMask)
+			*/
+			RenderLayerMask GetRenderLayerMask() const;
 
 			Camera* SetFOV(float fov);
 			Camera* SetOrthograpic(bool value);
@@ -49,12 +72,34 @@ namespace EngineCore {
 			Camera* SetPlanes(float nearPlane, float farPlane);
 			Camera* SetCameraLayers(std::vector<RenderLayerID> renderLayers);
 			Camera* AddCameraLayer(RenderLayerID renderLayer);
+			/**
+			* @brief Cameras are rendered from the lowest to the highest priority
+			*/
+			Camera* SetPriority(int priority);
+			/**
+			* @brief Additional cameras are rendered every frame next to the main camera (split-screen, minimap, render-to-texture)
+			*/
+			Camera* SetAdditional(bool value);
+			/**
+			* @brief Sets the part of the window (or render target) the camera draws into, values are 0 - 1 from the bottom left
+			*/
+			Camera* SetViewport(float x, float y, float width, float height);
+			/**
+			* @brief The camera draws into the target instead of the window, nullptr = window.
+			* The target has to stay alive as long as the camera uses it
+			*/
+			Camera* SetRenderTarget(OffscreenTarget* target);
+			/**
+			* @brief Color the render target is cleared with, the window is cleared by the engine
+			*/
+			Camera* SetBackgroundColor(const Vector4& color);
 
 		private:
 			// gets updatet in the engine loop (before the update loop of the application)
 			static int m_windowWidth, m_windowHeight;
 			std::shared_ptr<GameObject> m_gameObject;
 			std::vector<RenderLayerID> m_renderLayers;
+			RenderLayerMask m_renderLayerMask = 0;	// updated with m_renderLayers
 
 			float m_fov = 66.0f;
 			bool m_isOrthograpic = false;
@@ -66,12 +111,28 @@ namespace EngineCore {
 			float m_nearPlane = 0.1f;
 			float m_farPlane = 1000.0f;
 
+			int m_priority = 0;
+			bool m_isAdditional = false;
+			Vector4 m_viewport{ 0, 0, 1, 1 };
+			OffscreenTarget* m_renderTarget = nullptr;
+			Vector4 m_backgroundColor{ 0, 0, 0, 1 };
+
 			Matrix4x4 m_projection;
 			Matrix4x4 m_view;
+			Matrix4x4 m_viewProjection;
+			Frustum m_frustum;
+			// the view is rebuilt when the position or direction differs from the last build
+			bool m_viewChanged = true;
+			Vector3 m_viewPosition;
+			Vector3 m_viewForward;
+			bool m_viewProjectionChanged = true;
 
 			float CalculateAspectRatio() const;
 			void CreateProjectionMatrix(float aspectRatio);
 			void CreateViewMatrix();
+			void UpdateProjectionMatrix();
+			void UpdateViewMatrix();
+			void UpdateViewProjection();
 
 			static void SetWindowDimensions(int width, int height);
 		};
@@ -25,9 +25,14 @@ namespace EngineCore {
 			int GetZOrder() const;
 			Vector4 GetSpriteColor() const;
 			bool GetInvertMesh() const;
+			/*
+			* @brief Gets the region of the sprite on its texture, uv offset (xy) and scale (zw)
+			*/
+			Vector4 GetUVRect() const;
 
 			/*
-			* @brief Sets the spirte of the SpriteRenderer
+			* @brief Sets the spirte of the SpriteRenderer. Small textures are packed into the sprite atlas,
+			* so sprites with different textures can still be drawn in one batch
 			* @param id the id of the texture
 			* @return this component ptr
 			*/
@@ -58,8 +63,17 @@ namespace EngineCore {
 			int m_zOrder = 0;
 
 			Vector4 m_meshColor{ 1, 1, 1, 1 };
+			Vector4 m_uvRect{ 0, 0, 1, 1 };	// region of the sprite on its atlas page
+			uint64_t m_regionSerial = 0;		// serial of the packed region, 0 if the sprite is not packed
+			uint64_t m_atlasGeneration = 0;	// atlas generation the region was last checked at
 			bool m_isTransparent = false;
 			bool m_invertMesh = false;
+
+			/*
+			* @brief Checks that the packed region still belongs to the sprite. The region of a deleted texture
+			* gets reused, the sprite loses its texture then instead of drawing the new one
+			*/
+			void ValidateRegion();
 		};
 
 	}
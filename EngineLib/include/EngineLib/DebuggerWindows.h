@@ -20,11 +20,14 @@ namespace EngineCore {
 		void SetIconFonts(ImFont* smallIcon, ImFont* largeIcon);
 		void MenuSidebar(float sidebarRatio, int windowWidth, int windowHeight);
 		void StatsWindow();
+		void FramePhasesTable();
 		void CameraWindow();
 		void DrawGameObjectNode(const std::shared_ptr<GameObject>& obj);
 		void HierarchyWindow();
 		void InspectorWindow();
 		void ConsoleWindow();
+		// counters of every log call site (calls, rate limited calls)
+		void LogSitesTable();
 		/**
 		* @brief Draws a single UI element and its children in a collapsible HTML-like tree node
 		* @param elem Shared pointer to the UI element to draw
@@ -78,6 +81,7 @@ namespace EngineCore {
 		std::vector<LogMsg> m_log;
 		// info = 1 bit, warn = 2 bit, error = 3 bit, debug = 4 bit
 		uint8_t m_logMask = 0b1111;
+		bool m_logSitesView = false;
 		Log::SubscriberID m_subscriberId;
 	};
 
@@ -17,6 +17,9 @@
 #include "EngineLib/EngineTypes.h"
 #include "EngineLib/Application.h"
 #include "EngineLib/Time.h"
+#include "EngineLib/Profiler.h"
+#include "EngineLib/FrameRecorder.h"
+#include "EngineLib/OffscreenTarget.h"
 #include "EngineLib/Input.h"
 #include "EngineLib/Shader.h"
 #include "EngineLib/Texture2D.h"
@@ -43,10 +46,14 @@ namespace EngineCore {
 		~Engine();
 
 		int EngineStart();
-		void EngineLoop();
+		/*
+		* @return ENGINE_SUCCESS, or ENGINE_FAILURE if a benchmark regressed against its baseline
+		*/
+		int EngineLoop();
 
 	private:
 		bool m_isEngineRunning = true;
+		int m_exitCode = ENGINE_SUCCESS;
 
 		int m_frameCount = 0;
 		int m_framesPerSecond = 0;// m_framesPerSecond = m_frameCount - m_lastFrameCount;
@@ -62,10 +69,46 @@ namespace EngineCore {
 		GLFWwindow* m_window = nullptr;
 		GameObjectManager* m_gameObjectManager = nullptr;
 
+		// benchmark mode (see Application::App_Benchmark_Set_Enabled)
+		uint64_t m_benchmarkFrame = 0;
+		FrameRecorder m_frameRecorder;
+
+		// offscreen mode (see Application::App_Offscreen_Set_Enabled)
+		std::unique_ptr<OffscreenTarget> m_offscreenTarget;
+
 		void Update(double currentTimeSec);
 		void LateUpdate();
 		void Shutdown();
 
+		/*
+		* @brief Saves the running profiler capture to the capture path of the app (or starts a capture if none is running)
+		*/
+		void SaveProfilerCapture();
+
+		/*
+		* @brief Installs the benchmark clock, called before the app starts
+		*/
+		void StartBenchmark();
+		/*
+		* @brief Records the frame that just ended and stops the engine once a limit is reached
+		*/
+		void RecordBenchmarkFrame();
+		/*
+		* @brief Writes the recorded frames to the benchmark output path, logs the summary and
+		* compares against (or updates) the baseline
+		* @return ENGINE_FAILURE if a metric regressed
+		*/
+		int FinishBenchmark();
+
+		/*
+		* @brief Creates the offscreen target with the window size and binds it, needs the GL context
+		*/
+		int OffscreenInit();
+		/*
+		* @brief Dumps the read back frame as PNG (if a dump path is set) and passes it to the app
+		*/
+		void OnOffscreenFrame(const OffscreenTarget::Frame& frame);
+
 		void OnWindowResize(int width, int height);
 
 		int GLFWInit();
@@ -109,6 +152,7 @@ Components
 - Transform
 - Camera
 - - Can see diffrent kind of Render-Layers
+- - Priority, viewport and render target, additional cameras render next to the main camera
 - MeshRenderer
 - Script
 - - FreeCameraScript
@@ -124,7 +168,10 @@ Render-Layers
 
 Renderer
 - Renders batches
-- Renders what the camera can see
+- Renders what the cameras can see, frustum culling with mesh bounding spheres
+- RenderDevice interface (OpenGL, recording device without GPU)
+- per-instance color, uv rect and params, tints do not break batches
+- sprites are packed into a runtime atlas, one batch per atlas page
 
 Debugger with ImGui
 - General stats
@@ -133,7 +180,23 @@ Debugger with ImGui
 - Camera
 - Console
 
-Simple Profiler
-- section start/end
-- get the data
+Profiler
+- nested scoped zones (ENGINE_PROFILE_ZONE)
+- per-thread call trees
+- per-frame history with percentiles
+- engine phases as zones (update, ui, draw commands, draw)
+- frame budget with zone breakdown of slow frames
+
+Benchmark mode
+- fixed delta time or custom clock
+- frame / duration limit
+- headless with the recording render device
+- per-frame timings as CSV and JSON
+- warmup frames
+- baseline comparison with regression threshold
+
+Offscreen mode
+- renders into a framebuffer, hidden window or surfaceless EGL / OSMesa context
+- asynchronous readback through a ring of readback buffers
+- PNG sequence dumps
 */
\ No newline at end of file
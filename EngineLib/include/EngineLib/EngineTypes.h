@@ -1,6 +1,8 @@
 #pragma once
+#include <cstdint>
 #include <limits>
 #include <string>
+#include <type_traits>
 #include <CoreLib/Math.h>
 #include <CoreLib/FormatUtils.h>
 
@@ -56,6 +58,9 @@ namespace EngineCore {
 	using InputLayerID = EngineID<InputLayerTag>;
 	using UIElementID = EngineID<UIElementTag>;
 
+	// one bit per render layer, see RenderLayerManager::GetLayerMask
+	using RenderLayerMask = uint64_t;
+
 	enum class RenderCommandType {
 		Mesh = 0,
 		Text
@@ -67,6 +72,7 @@ namespace EngineCore {
 	
 	/*
 	* @brief A render command that describes how a mesh or text element should be drawn.
+	* Small and trivially copyable, everything bigger (matrix, params, text geometry) is referenced.
 	*
 	* @note The only parameter that is always required is `renderLayerID`.
 	*       If it is left as ENGINE_INVALID_ID, the command will be ignored.
@@ -80,6 +86,8 @@ namespace EngineCore {
 	*   - meshID          (the mesh geometry to draw)
 	*   - modelMatrix     (the world transform of the mesh)
 	*   - isTransparent   (optional, only if transparency material is transparent)
+	*   - meshColor, uvRect, instanceParams, instanceCustom
+	*                     (optional, per-instance attributes, they do not break the batch, see InstanceData)
 	*
 	* Text rendering:
 	*   - type            must be set to RenderCommandType::Text
@@ -88,7 +96,8 @@ namespace EngineCore {
 	*   - modelMatrix     transform for text positioning and scaling
 	*   - fontID          the font to use for rendering
 	*   - pixelSize       font size in pixels
-	*   - textQuads       precomputed quads representing the text geometry
+	*   - textQuads       precomputed quads representing the text geometry, textQuadCount of them.
+	*                     The command only points at them, the buffer has to stay unchanged until the frame is drawn
 	*   - isTransparent   set automatically by the renderer
 	*/
 	struct RenderCommand {
@@ -103,15 +112,22 @@ namespace EngineCore {
 		int zOrder = 0;
 		const Matrix4x4* modelMatrix = nullptr;
 		Vector4 meshColor = { 1, 1, 1, 1 };
+		// meaning depends on the shader, see InstanceData (the UI shader uses them for the border)
+		Vector4 uvRect = { 0, 0, 1, 1 };			// uv offset (xy) and scale (zw)
+		Vector4 instanceParams = { 0, 0, 0, 0 };	// x = texture array layer
+		Vector4 instanceCustom = { 0, 0, 0, 0 };
 		bool isTransparent = false;
 
 		// For text
 		FontID fontID = FontID(ENGINE_INVALID_ID);
 		int pixelSize = 0;
-		std::vector<TextQuad> textQuads;
+		const TextQuad* textQuads = nullptr;
+		size_t textQuadCount = 0;
 
 		RenderCommand() = default;
 	};
+	// Submit copies and the sort moves commands, both have to stay a memcpy
+	static_assert(std::is_trivially_copyable_v<RenderCommand>, "RenderCommand must be trivially copyable");
 
 	inline std::string RenderCommandTypeToString(RenderCommandType type) {
 		switch (type) {
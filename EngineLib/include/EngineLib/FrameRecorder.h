@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineLib/Profiler.h"
+#include "EngineLib/Renderer.h"
+
+namespace EngineCore {
+
+	/*
+	* @brief Records the timing of every frame of a benchmark run and writes it as CSV or JSON.
+	*
+	* A frame stores the CPU frame time, the time of every engine phase (the zones of the main thread
+	* up to depth 2, see Profiler::GetLastFrameZones) and the render counters. Phases get a column
+	* the first time they show up, frames without the phase have 0 in it.
+	*
+	* The metrics (averages over all frames) can be saved as baseline and compared against later runs.
+	*/
+	class FrameRecorder {
+	public:
+		struct Frame {
+			uint64_t index = 0;
+			double time = 0;			// simulated time in seconds (Time::GetTimeDouble)
+			double frameTime = 0;		// CPU time of the frame in seconds
+			RenderStats renderStats;
+			std::vector<double> phaseTimes; // seconds, indexed like GetPhaseNames
+		};
+
+		struct Summary {
+			size_t frameCount = 0;
+			double average = 0;	// seconds
+			double p50 = 0;
+			double p95 = 0;
+			double p99 = 0;
+			double max = 0;
+		};
+
+		/*
+		* @brief One value that gets compared against a baseline, lower is better
+		*/
+		struct Metric {
+			std::string name;
+			double value = 0;
+		};
+
+		struct Comparison {
+			std::string name;
+			double baseline = 0;
+			double current = 0;
+			double ratio = 1.0;	// current / baseline
+			bool isRegression = false;
+		};
+
+		FrameRecorder() = default;
+
+		void Reserve(size_t frameCount);
+		void Clear();
+
+		/*
+		* @param zones breakdown of the frame, only the main thread zones up to depth 2 are kept
+		*/
+		void Record(uint64_t index, double time, double frameTime, const std::vector<Profiler::FrameZone>& zones, const RenderStats& renderStats);
+
+		const std::vector<Frame>& GetFrames() const;
+		const std::vector<std::string>& GetPhaseNames() const;
+
+		/*
+		* @brief Gets the frame time statistics over all recorded frames
+		*/
+		Summary GetSummary() const;
+		/*
+		* @brief Gets the statistics of one phase (frames where it did not run count as 0)
+		*/
+		Summary GetPhaseSummary(const std::string& phaseName) const;
+		/*
+		* @brief Gets the frame time (avg, p95), the average time of every phase and the average render counters
+		*/
+		std::vector<Metric> GetMetrics() const;
+
+		/*
+		* @brief Writes one row per frame, times in milliseconds
+		* @return false if the file could not be written
+		*/
+		bool WriteCSV(const std::string& path) const;
+		/*
+		* @brief Writes the summary, the phase summaries and every frame, times in milliseconds
+		* @return false if the file could not be written
+		*/
+		bool WriteJson(const std::string& path) const;
+		/*
+		* @brief Writes only the metrics, the file can be used as baseline
+		* @return false if the file could not be written
+		*/
+		bool WriteBaseline(const std::string& path) const;
+
+		/*
+		* @brief Reads the "metrics" object of a file written by WriteBaseline or WriteJson
+		* @param outBaseline metric name -> value
+		* @return false if the file could not be read or has no metrics
+		*/
+		static bool LoadBaseline(const std::string& path, std::unordered_map<std::string, double>& outBaseline);
+
+		/*
+		* @brief Compares the metrics against a baseline and logs every metric that exists in both.
+		* A metric regressed if it grew by more than threshold (0.1 = 10%) and by more than MIN_REGRESSION_DELTA,
+		* so tiny phases do not fail a run because of timer noise
+		*/
+		std::vector<Comparison> CompareWithBaseline(const std::unordered_map<std::string, double>& baseline, double threshold) const;
+
+		// smallest absolute growth that counts as regression (ms for times, count for render counters)
+		static constexpr double MIN_REGRESSION_DELTA = 0.01;
+
+	private:
+		static constexpr int MAX_PHASE_DEPTH = 2;
+
+		std::vector<Frame> m_frames;
+		std::vector<std::string> m_phaseNames;
+
+		size_t GetPhaseIndex(const char* name);
+		static Summary CreateSummary(std::vector<double> values);
+		static void AppendMetrics(std::string& json, const std::vector<Metric>& metrics);
+		static bool WriteFile(const std::string& path, const std::string& content);
+	};
+
+}
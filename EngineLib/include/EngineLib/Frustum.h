@@ -0,0 +1,32 @@
+#pragma once
+#include <CoreLib/Math/Vector3.h>
+#include <CoreLib/Math/Vector4.h>
+
+class Matrix4x4;
+
+namespace EngineCore {
+
+	/*
+	* @brief The six planes of a camera view volume, used to skip what a camera can not see.
+	* A default constructed frustum contains everything.
+	*/
+	class Frustum {
+	public:
+		Frustum() = default;
+
+		/*
+		* @brief Extracts the planes from a projection * view matrix
+		*/
+		void Set(const Matrix4x4& viewProjection);
+
+		/*
+		* @return false if the sphere is completely outside of one of the planes
+		*/
+		bool IntersectsSphere(const Vector3& center, float radius) const;
+
+	private:
+		// left, right, bottom, top, near, far; xyz normal pointing inside, w distance
+		Vector4 m_planes[6];
+	};
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "EngineLib/RenderDevice.h"
+
+namespace EngineCore {
+
+	/*
+	* @brief RenderDevice on OpenGL 3.3, needs a current context with loaded GL functions (GLAD)
+	*/
+	class GLRenderDevice : public RenderDevice {
+	public:
+		GLRenderDevice() = default;
+
+		GpuHandle CreateBuffer(BufferType type, const void* data, size_t size, BufferUsage usage) override;
+		void SetBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, BufferUsage usage) override;
+		void UpdateBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, size_t offset) override;
+		void DeleteBuffer(GpuHandle buffer) override;
+
+		GpuHandle CreateVertexArray(const std::vector<VertexAttribute>& attributes, GpuHandle indexBuffer) override;
+		void DeleteVertexArray(GpuHandle vertexArray) override;
+
+		GpuHandle CreateTexture2D(const TextureDesc& desc, const unsigned char* data) override;
+		void UpdateTexture2D(GpuHandle texture, int x, int y, int width, int height, int channels, const unsigned char* data) override;
+		void DeleteTexture(GpuHandle texture) override;
+		void BindTexture(unsigned int unit, GpuHandle texture) override;
+		GpuHandle GetBoundTexture(unsigned int unit) const override;
+		unsigned int GetMaxTextureUnits() const override;
+
+		GpuHandle CreateFramebuffer(int width, int height) override;
+		GpuHandle CreateTextureFramebuffer(GpuHandle colorTexture, int width, int height) override;
+		void DeleteFramebuffer(GpuHandle framebuffer) override;
+		void BindFramebuffer(GpuHandle framebuffer) override;
+		void SetViewport(int x, int y, int width, int height) override;
+		void SetScissor(bool enabled, int x, int y, int width, int height) override;
+
+		GpuHandle CreateReadbackBuffer(size_t size) override;
+		void DeleteReadbackBuffer(GpuHandle readbackBuffer) override;
+		void ReadPixelsAsync(GpuHandle framebuffer, int width, int height, GpuHandle readbackBuffer) override;
+		bool IsReadbackReady(GpuHandle readbackBuffer) override;
+		bool ReadReadbackBuffer(GpuHandle readbackBuffer, void* outData, size_t size) override;
+
+		GpuHandle CreateProgram(const std::string& vertexCode, const std::string& fragmentCode) override;
+		void DeleteProgram(GpuHandle program) override;
+		void UseProgram(GpuHandle program) override;
+		GpuHandle GetCurrentProgram() const override;
+		int GetUniformLocation(GpuHandle program, const std::string& name) override;
+
+		void SetUniformInt(int location, int value) override;
+		void SetUniformFloats(int location, const float* values, int components) override;
+		void SetUniformMatrix(int location, int columns, int rows, const float* data) override;
+
+		void SetDepthTest(bool enabled) override;
+		void SetFrontFace(FrontFace frontFace) override;
+		void SetBlendMode(BlendMode mode) override;
+		void ClearDepth() override;
+		void ClearColor(float r, float g, float b, float a) override;
+
+		void DrawIndexed(GpuHandle vertexArray, int indexCount) override;
+		void DrawIndexedInstanced(GpuHandle vertexArray, int indexCount, int instanceCount) override;
+
+	private:
+		GpuHandle m_currentProgram = 0;
+		unsigned int m_activeUnit = 0;
+		std::vector<GpuHandle> m_boundTextures; // per texture unit
+		GpuHandle m_boundFramebuffer = 0;
+
+		struct FramebufferAttachments {
+			GpuHandle color = 0;
+			GpuHandle depthStencil = 0;
+			bool ownsColor = true; // false if the texture was passed to CreateTextureFramebuffer
+		};
+		std::unordered_map<GpuHandle, FramebufferAttachments> m_framebuffers;
+		// fence of the last ReadPixelsAsync per readback buffer (GLsync)
+		std::unordered_map<GpuHandle, void*> m_readbackFences;
+
+		void DeleteReadbackFence(GpuHandle readbackBuffer);
+		void SetActiveUnit(unsigned int unit);
+		/*
+		* @brief Compiles one shader stage, logs the error
+		*/
+		static GpuHandle CompileShader(unsigned int stage, const std::string& code, const char* stageName);
+	};
+
+}
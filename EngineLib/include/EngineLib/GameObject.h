@@ -36,6 +36,10 @@ namespace EngineCore {
 		static std::shared_ptr<GameObject> Get(const std::string& name);
 		static std::shared_ptr<Component::Camera> GetMainCamera();
 		static void SetMainCamera(std::shared_ptr<Component::Camera> camera);
+		/*
+		* @brief Gets every registered camera, including the main camera
+		*/
+		static const std::vector<std::weak_ptr<Component::Camera>>& GetCameras();
 
 		template<typename C, typename... Args>
 		std::shared_ptr<C> AddComponent(Args&&... args);
@@ -1,14 +1,34 @@
 #pragma once
 #include <vector>
+#include <CoreLib\Math\Vector4.h>
 #include "EngineLib\Vertex.h"
+#include "EngineLib\RenderDevice.h"
 // #include "Components\MeshRenderer_C.h"
 
-typedef unsigned int GLuint;
-typedef int GLsizei;
-class Matrix4x4;
-
 namespace EngineCore {
 
+    /*
+    * @brief Per-instance vertex attributes, one entry per instance of a batch.
+    *
+    * Shaders read them as instance attributes. Only the model matrix has a fixed meaning,
+    * the vec4 slots are interpreted by the shader of the material:
+    *
+    *   location      attribute            default shaders                     DefaultUI shader
+    *   3-6   mat4    instanceModel        model matrix                        model matrix, the scale is the element size
+    *   7     vec4    instanceColor        tint (RenderCommand::meshColor)     background color
+    *   8     vec4    instanceUVRect       uv offset (xy) and scale (zw)       border color
+    *   9     vec4    instanceParams       x = texture array layer, yzw free   border width (top, right, bottom, left)
+    *   10    vec4    instanceCustom       free for custom shaders             border radius (per corner)
+    */
+    struct InstanceData {
+        float model[16];    // column-major
+        Vector4 color;
+        Vector4 uvRect;
+        Vector4 params;
+        Vector4 custom;
+    };
+    static_assert(sizeof(InstanceData) == 32 * sizeof(float), "InstanceData has to be tightly packed floats");
+
     class Mesh {
     friend class Renderer;
     public:
@@ -19,18 +39,26 @@ namespace EngineCore {
         void CreateGL();
         void DeleteGL();
 
+        /*
+        * @brief Local bounding sphere, xyz = center, w = radius (negative if the mesh has no vertices)
+        */
+        const Vector4& GetBoundingSphere() const;
+
     private:
         bool m_exists = false;
 
-        GLuint m_vao = 0, m_vbo = 0, m_ebo = 0;
-        GLuint m_instanceVBO = 0;
-        GLsizei m_indexCount = 0;
+        GpuHandle m_vao = 0, m_vbo = 0, m_ebo = 0;
+        GpuHandle m_instanceVBO = 0;
+        int m_indexCount = 0;
 
         std::string m_path;
         std::vector<Vertex> m_vertices;
         std::vector<unsigned int> m_indices;
+        Vector4 m_boundingSphere{ 0, 0, 0, -1 };
+
+        void CalculateBoundingSphere();
 
-        void DrawInstanced(int instanceCount, const std::vector<Matrix4x4>& matrices);
+        void DrawInstanced(const std::vector<InstanceData>& instances);
     };
 
 }
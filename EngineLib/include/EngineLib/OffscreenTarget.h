@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "EngineLib/RenderDevice.h"
+
+namespace EngineCore {
+
+	/*
+	* @brief Framebuffer the engine renders into instead of the window, with asynchronous readback.
+	*
+	* RequestReadback copies the finished frame into the next buffer of a ring, the copy runs on the GPU
+	* while the following frames are rendered. Finished frames are handed to the frame callback in order,
+	* a frame only has to be waited for once the ring is full (counted in GetStallCount).
+	*/
+	class OffscreenTarget {
+	public:
+		struct Frame {
+			uint64_t index = 0;
+			int width = 0;
+			int height = 0;
+			std::vector<unsigned char> pixels; // RGBA8, top row first
+		};
+
+		using FrameCallback = std::function<void(const Frame& frame)>;
+
+		OffscreenTarget() = default;
+		~OffscreenTarget();
+
+		OffscreenTarget(const OffscreenTarget&) = delete;
+		OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+		/*
+		* @param readbackBufferCount size of the readback ring, frames arrive up to count - 1 frames late
+		* @return false if the framebuffer could not be created
+		*/
+		bool Create(int width, int height, size_t readbackBufferCount = 3);
+		/*
+		* @brief Deletes the framebuffer and the readback buffers, pending readbacks are dropped
+		*/
+		void Destroy();
+		/*
+		* @brief Recreates the framebuffer with the new size, pending readbacks are delivered first
+		*/
+		bool Resize(int width, int height);
+
+		/*
+		* @brief Draws go into the target, sets the viewport to its size
+		*/
+		void Bind();
+		/*
+		* @brief Draws go into the window again
+		*/
+		void Unbind();
+
+		void SetFrameCallback(FrameCallback callback);
+
+		/*
+		* @brief Starts the readback of the current content, delivers every readback that finished
+		*/
+		void RequestReadback(uint64_t frameIndex);
+		/*
+		* @brief Delivers every finished readback without waiting
+		*/
+		void Poll();
+		/*
+		* @brief Waits for and delivers every pending readback
+		*/
+		void Finish();
+
+		bool IsValid() const;
+		int GetWidth() const;
+		int GetHeight() const;
+		GpuHandle GetFramebuffer() const;
+		size_t GetPendingCount() const;
+		/// Number of readbacks that had to be waited for because the ring was full
+		uint64_t GetStallCount() const;
+
+	private:
+		struct ReadbackSlot {
+			GpuHandle buffer = 0;
+			uint64_t frameIndex = 0;
+			bool pending = false;
+		};
+
+		GpuHandle m_framebuffer = 0;
+		int m_width = 0;
+		int m_height = 0;
+
+		std::vector<ReadbackSlot> m_slots;
+		size_t m_nextSlot = 0; // slot of the next readback, the oldest pending readback is the first pending one after it
+		uint64_t m_stallCount = 0;
+
+		FrameCallback m_frameCallback;
+		Frame m_frame;							// reused for every delivered frame
+		std::vector<unsigned char> m_rowBuffer;	// for flipping the rows
+
+		size_t GetFrameSize() const;
+		/*
+		* @brief Reads the slot (waits if necessary) and calls the frame callback
+		*/
+		void Deliver(ReadbackSlot& slot);
+	};
+
+}
@@ -1,48 +1,283 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define ENGINE_PROFILER_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ENGINE_PROFILER_RDTSC
+#endif
+
+#define ENGINE_PROFILER_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILER_CONCAT(a, b) ENGINE_PROFILER_CONCAT_INNER(a, b)
+
+/*
+* Profiles the rest of the current scope as a zone with the given name (string literal).
+* The call site descriptor is static, so a zone only costs two timestamps and a short lookup.
+*/
+#define ENGINE_PROFILE_ZONE(name) \
+	static EngineCore::Profiler::ZoneSite ENGINE_PROFILER_CONCAT(_profilerSite, __LINE__) { name, __FILE__, __LINE__ }; \
+	EngineCore::Profiler::Zone ENGINE_PROFILER_CONCAT(_profilerZone, __LINE__)(ENGINE_PROFILER_CONCAT(_profilerSite, __LINE__))
+
+// Profiles the rest of the current function, the zone is named after the function
+#define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_ZONE(__FUNCTION__)
+
 namespace EngineCore {
-	
+
+	/*
+	* @brief Hierarchical profiler with scoped zones.
+	*
+	* Zones nest, every (parent zone, zone) path is its own node, so the same zone called
+	* from different places shows up separately. Every thread records into its own call tree
+	* without locks, EndFrame collects the time spent per node during the frame into a fixed size history.
+	*/
 	class Profiler {
 	public:
+		/*
+		* @brief Static description of one zone call site, created by ENGINE_PROFILE_ZONE
+		*/
+		struct ZoneSite {
+			const char* name;
+			const char* file;
+			int line;
+		};
+
+		/*
+		* @brief RAII zone, measures the time between construction and destruction
+		*/
+		class Zone {
+		public:
+			Zone(const ZoneSite& site) {
+				if (m_enabled)
+					m_active = Begin(site);
+			}
+
+			~Zone() {
+				if (m_active)
+					End();
+			}
+
+			Zone(const Zone&) = delete;
+			Zone& operator=(const Zone&) = delete;
+
+		private:
+			bool m_active = false;
+		};
+
 		struct Section {
 			std::string name;
-			double m_longestTime;
-			double m_shortestTime;
-			double average;
-			std::vector<double> m_deltaTimes;
+			const char* file = nullptr;
+			int line = 0;
+			int depth = 0;				// nesting depth, 0 = root zone
+			size_t threadIndex = 0;		// threads are numbered in the order they opened their first zone
+			double m_longestTime = 0;	// seconds spent in the zone per frame
+			double m_shortestTime = 0;
+			double average = 0;
+			double p50 = 0;
+			double p95 = 0;
+			double p99 = 0;
+			double averageCalls = 0;	// calls per frame
+			std::vector<double> m_deltaTimes; // time per frame, oldest first
+		};
+
+		/*
+		* @brief Time one zone took in a single frame
+		*/
+		struct FrameZone {
+			const char* name = nullptr;
+			int depth = 0;
+			size_t threadIndex = 0;
+			double time = 0;	// seconds
+			uint64_t calls = 0;
 		};
 
+		/*
+		* @param frameIndex the slow frame
+		* @param frameTime seconds between the EndFrame calls of the frame
+		* @param zones every zone that ran in the frame, in call tree order
+		*/
+		using FrameBudgetCallback = std::function<void(uint64_t frameIndex, double frameTime, const std::vector<FrameZone>& zones)>;
+
+		/*
+		* @brief Records the fps of the current frame
+		*/
 		static void Start(int fps);
-		static void SectionStart(const std::string& sectionName);
-		static void SectionEnd();
 
+		/*
+		* @brief Starts timing the first frame (otherwise the first frame starts with the first EndFrame)
+		*/
+		static void StartFrame();
+
+		/*
+		* @brief Closes the current frame, collects the time of every zone since the last call.
+		* Has to be called once per frame by the main thread (the engine does this at the end of Update).
+		*/
+		static void EndFrame();
+
+		/*
+		* @brief Gets the stats of every zone in call tree order (parents before their children)
+		*/
 		static std::vector<Section> GetSectionData();
 		static std::string GetSectionDataString();
 		static size_t GetMaxSampleCount();
 		static float GetAverageFPS();
 
+		/*
+		* @brief Sets the history size of the fps and of every zone. Clears the collected samples
+		*/
 		static void SetMaxSampleCount(size_t sampleCount);
+		/*
+		* @brief Enables or disables the recording of new zones (enabled by default)
+		*/
+		static void SetEnabled(bool value);
+		static bool IsEnabled();
+
+		// ------------------------- Frame budget -------------------------
+
+		/*
+		* @brief Sets the time a frame may take before the budget callback is called
+		* @param seconds budget, 0 disables the check
+		*/
+		static void SetFrameBudget(double seconds);
+		static double GetFrameBudget();
+		/*
+		* @brief Called by EndFrame for every frame that took longer than the budget. Without callback the zones of the frame get logged (rate limited)
+		*/
+		static void SetFrameBudgetCallback(FrameBudgetCallback callback);
+		/// Number of frames that exceeded the budget
+		static uint64_t GetFrameBudgetExceededCount();
+
+		/*
+		* @brief Gets the duration of the last frames in seconds, oldest first
+		*/
+		static std::vector<double> GetFrameTimes();
+		/*
+		* @brief Gets the duration of the last closed frame in seconds
+		*/
+		static double GetLastFrameTime();
+		/*
+		* @brief Gets the zones of the last closed frame, in call tree order
+		*/
+		static const std::vector<FrameZone>& GetLastFrameZones();
+		/*
+		* @brief Formats a frame breakdown as one line per zone, indented by depth
+		*/
+		static std::string FormatFrameZones(const std::vector<FrameZone>& zones);
+
+		// ------------------------- Capture -------------------------
+
+		/*
+		* @brief Starts recording every zone and frame with timestamps. Every thread records into
+		* its own ring buffer, once full the oldest events get overwritten (keeps the last eventsPerThread events).
+		* @param eventsPerThread size of the ring buffer per thread (rounded up to a power of two),
+		* the buffers are allocated once, later captures keep the size of the first one
+		*/
+		static void StartCapture(size_t eventsPerThread = 1 << 16);
+		/*
+		* @brief Stops recording, the captured events are kept until the next StartCapture
+		*/
+		static void StopCapture();
+		static bool IsCapturing();
+
+		/*
+		* @brief Writes the captured events as Chrome trace event JSON (chrome://tracing, ui.perfetto.dev).
+		* Recording is paused while writing and continues afterwards.
+		* @return false if the file could not be written
+		*/
+		static bool WriteChromeTrace(const std::string& path);
+
+		/*
+		* @brief Gets the current timestamp in profiler ticks
+		*/
+		static inline uint64_t GetTicks() {
+#ifdef ENGINE_PROFILER_RDTSC
+			return __rdtsc();
+#else
+			return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		/*
+		* @brief Converts profiler ticks to seconds
+		*/
+		static double TicksToSeconds(uint64_t ticks);
 
 	private:
-		struct SectionObj {
-			unsigned int m_index = 0;
-			double m_longestTime = 0;
-			double m_shortestTime = 0;
-			std::vector<double> m_deltaTimes;
+		class ThreadData;
+
+		/*
+		* @brief Fixed size history, overwrites the oldest sample once full
+		*/
+		class RingHistory {
+		public:
+			RingHistory() : m_next(0), m_count(0) {}
+
+			void Resize(size_t capacity);
+			void Push(double value);
+			size_t Size() const;
+			// copies the samples, oldest first
+			void CopyTo(std::vector<double>& out) const;
+
+		private:
+			std::vector<double> m_samples;
+			size_t m_next;
+			size_t m_count;
 		};
 
+		/*
+		* @return true if the zone was opened (false if the nesting is too deep)
+		*/
+		static bool Begin(const ZoneSite& site);
+		static void End();
+
+		/*
+		* @brief Gets the call tree of the calling thread, registers it on first use
+		*/
+		static ThreadData& GetThreadData();
+		static void UpdateTickFrequency();
+
+		/*
+		* @brief Every thread that opened a zone, the data is kept after the thread exits.
+		* Lock m_threadsMutex while using it
+		*/
+		static std::vector<std::unique_ptr<ThreadData>>& GetThreads();
+		static inline std::mutex m_threadsMutex;
+
+		static inline bool m_enabled = true;
+
+		static inline std::atomic<bool> m_capturing = false;
+		static inline size_t m_captureEventsPerThread = 0;
+		// incremented by StartCapture, a thread whose events have an older epoch starts over
+		static inline std::atomic<uint64_t> m_captureEpoch = 0;
+		static inline uint64_t m_captureStartTicks = 0;
+		static inline uint64_t m_frameIndex = 0;
+		static inline uint64_t m_frameStartTicks = 0;
+
+		static inline RingHistory m_frameTimes;
+		static inline double m_lastFrameTime = 0;
+		static inline std::vector<FrameZone> m_lastFrameZones;
+		static inline double m_frameBudget = 0;
+		static inline uint64_t m_frameBudgetExceeded = 0;
+		static inline FrameBudgetCallback m_frameBudgetCallback;
+
 		static inline int m_highestFPS = 0;
 		static inline int m_lowestFPS = 0;
-		static inline std::vector<int> m_fpsList;
+		static inline RingHistory m_fpsList;
 
 		static inline size_t m_maxSampleCount = 500;
-		static inline unsigned int indexCount = 0;
-		static inline std::string m_currentSection;
-		static inline double m_currentStartTime;
-		static inline std::unordered_map<std::string, SectionObj> m_sections;
+
+		// tick -> seconds calibration, ticks are either TSC cycles or steady_clock ticks
+		static inline std::atomic<double> m_secondsPerTick = 0.0;
+		static inline uint64_t m_calibrationStartTicks = 0;
+		static inline std::chrono::steady_clock::time_point m_calibrationStartTime;
 	};
 
-}
\ No newline at end of file
+}
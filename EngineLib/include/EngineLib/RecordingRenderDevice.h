@@ -0,0 +1,154 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineLib/RenderDevice.h"
+
+namespace EngineCore {
+
+	enum class RenderCall {
+		CreateBuffer = 0,
+		SetBufferData,
+		UpdateBufferData,
+		DeleteBuffer,
+		CreateVertexArray,
+		DeleteVertexArray,
+		CreateTexture2D,
+		UpdateTexture2D,
+		DeleteTexture,
+		BindTexture,
+		CreateFramebuffer,
+		DeleteFramebuffer,
+		BindFramebuffer,
+		SetViewport,
+		CreateReadbackBuffer,
+		DeleteReadbackBuffer,
+		ReadPixels,
+		ReadReadbackBuffer,
+		CreateProgram,
+		DeleteProgram,
+		UseProgram,
+		SetUniform,
+		SetDepthTest,
+		SetFrontFace,
+		ClearDepth,
+		ClearColor,
+		DrawIndexed,
+		DrawIndexedInstanced,
+		SetScissor,
+		SetBlendMode,
+		Count
+	};
+
+	const char* RenderCallToString(RenderCall call);
+
+	/*
+	* @brief RenderDevice without GPU. Hands out handles, counts every call and can capture the call stream.
+	*
+	* Used by the engine when there is no window (Renderer backend Recording), so the whole submission
+	* path (commands, sorting, batching, uniform and buffer uploads) runs and can be measured headless.
+	* A captured stream can be compared against a stored one to check the batching.
+	*/
+	class RecordingRenderDevice : public RenderDevice {
+	public:
+		/*
+		* @brief One device call, the meaning of a - d depends on the call
+		* (size/offset for buffers, unit for textures, location for uniforms, index/instance count for draws,
+		* x, y, width and height for viewport and scissor rects)
+		*/
+		struct RecordedCall {
+			RenderCall call = RenderCall::Count;
+			GpuHandle handle = 0;
+			int64_t a = 0;
+			int64_t b = 0;
+			int64_t c = 0;
+			int64_t d = 0;
+		};
+
+		RecordingRenderDevice() = default;
+
+		/*
+		* @brief Enables capturing of the call stream (disabled by default, the calls are always counted)
+		*/
+		void SetCapture(bool value);
+		bool IsCapturing() const;
+		const std::vector<RecordedCall>& GetCapturedCalls() const;
+		void ClearCapturedCalls();
+		/*
+		* @brief Formats the captured calls as one line per call, stable between runs (golden streams)
+		*/
+		std::string FormatCapturedCalls() const;
+
+		uint64_t GetCallCount(RenderCall call) const;
+		void ResetCallCounts();
+
+		GpuHandle CreateBuffer(BufferType type, const void* data, size_t size, BufferUsage usage) override;
+		void SetBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, BufferUsage usage) override;
+		void UpdateBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, size_t offset) override;
+		void DeleteBuffer(GpuHandle buffer) override;
+
+		GpuHandle CreateVertexArray(const std::vector<VertexAttribute>& attributes, GpuHandle indexBuffer) override;
+		void DeleteVertexArray(GpuHandle vertexArray) override;
+
+		GpuHandle CreateTexture2D(const TextureDesc& desc, const unsigned char* data) override;
+		void UpdateTexture2D(GpuHandle texture, int x, int y, int width, int height, int channels, const unsigned char* data) override;
+		void DeleteTexture(GpuHandle texture) override;
+		void BindTexture(unsigned int unit, GpuHandle texture) override;
+		GpuHandle GetBoundTexture(unsigned int unit) const override;
+		unsigned int GetMaxTextureUnits() const override;
+
+		GpuHandle CreateFramebuffer(int width, int height) override;
+		GpuHandle CreateTextureFramebuffer(GpuHandle colorTexture, int width, int height) override;
+		void DeleteFramebuffer(GpuHandle framebuffer) override;
+		void BindFramebuffer(GpuHandle framebuffer) override;
+		void SetViewport(int x, int y, int width, int height) override;
+		void SetScissor(bool enabled, int x, int y, int width, int height) override;
+
+		/*
+		* @brief Readbacks are always ready and read as black transparent pixels
+		*/
+		GpuHandle CreateReadbackBuffer(size_t size) override;
+		void DeleteReadbackBuffer(GpuHandle readbackBuffer) override;
+		void ReadPixelsAsync(GpuHandle framebuffer, int width, int height, GpuHandle readbackBuffer) override;
+		bool IsReadbackReady(GpuHandle readbackBuffer) override;
+		bool ReadReadbackBuffer(GpuHandle readbackBuffer, void* outData, size_t size) override;
+
+		GpuHandle CreateProgram(const std::string& vertexCode, const std::string& fragmentCode) override;
+		void DeleteProgram(GpuHandle program) override;
+		void UseProgram(GpuHandle program) override;
+		GpuHandle GetCurrentProgram() const override;
+		int GetUniformLocation(GpuHandle program, const std::string& name) override;
+
+		void SetUniformInt(int location, int value) override;
+		void SetUniformFloats(int location, const float* values, int components) override;
+		void SetUniformMatrix(int location, int columns, int rows, const float* data) override;
+
+		void SetDepthTest(bool enabled) override;
+		void SetFrontFace(FrontFace frontFace) override;
+		void SetBlendMode(BlendMode mode) override;
+		void ClearDepth() override;
+		void ClearColor(float r, float g, float b, float a) override;
+
+		void DrawIndexed(GpuHandle vertexArray, int indexCount) override;
+		void DrawIndexedInstanced(GpuHandle vertexArray, int indexCount, int instanceCount) override;
+
+	private:
+		static constexpr unsigned int MAX_TEXTURE_UNITS = 16;
+
+		bool m_capture = false;
+		std::vector<RecordedCall> m_calls;
+		std::array<uint64_t, static_cast<size_t>(RenderCall::Count)> m_callCounts{};
+
+		GpuHandle m_nextHandle = 1;
+		GpuHandle m_currentProgram = 0;
+		std::array<GpuHandle, MAX_TEXTURE_UNITS> m_boundTextures{};
+		// uniform name -> location per program, locations are handed out in the order they are requested
+		std::unordered_map<GpuHandle, std::unordered_map<std::string, int>> m_uniformLocations;
+
+		void Record(RenderCall call, GpuHandle handle = 0, int64_t a = 0, int64_t b = 0, int64_t c = 0, int64_t d = 0);
+	};
+
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace EngineCore {
+
+	/*
+	* @brief Handle of a GPU object (buffer, vertex array, texture, program), 0 = no object
+	*/
+	using GpuHandle = unsigned int;
+
+	enum class BufferType {
+		Vertex = 0,
+		Index
+	};
+
+	enum class BufferUsage {
+		Static = 0,	// uploaded once
+		Dynamic		// rewritten every frame
+	};
+
+	enum class FrontFace {
+		CounterClockwise = 0,
+		Clockwise
+	};
+
+	enum class BlendMode {
+		Alpha = 0,	// src alpha, one minus src alpha
+		Layer		// like Alpha, but the alpha channel adds up the coverage, the target holds premultiplied colors that get blended again later
+	};
+
+	/*
+	* @brief One float attribute of a vertex array
+	*/
+	struct VertexAttribute {
+		unsigned int location = 0;
+		int components = 0;		// 1 - 4 floats
+		size_t stride = 0;		// bytes
+		size_t offset = 0;		// bytes
+		GpuHandle buffer = 0;	// vertex buffer the attribute reads from
+		bool perInstance = false;
+	};
+
+	/*
+	* @brief Wrap and filter modes are GL enum values, like in the Texture2D setters
+	*/
+	struct TextureDesc {
+		int width = 0;
+		int height = 0;
+		int channels = 4;		// 1 = R8, 3 = RGB8, 4 = RGBA8
+		unsigned int wrapX = 0;
+		unsigned int wrapY = 0;
+		unsigned int filterMin = 0;
+		unsigned int filterMag = 0;
+		bool mipmaps = false;
+	};
+
+	/*
+	* @brief Thin interface over the graphics API (buffers, textures, programs, state and draw calls).
+	*
+	* Mesh, Shader, Texture2D, FontAsset, FontManager and the Renderer only talk to the device,
+	* so the whole render path also runs on a device that makes no GPU calls (see RecordingRenderDevice).
+	* Get the active device with Renderer::GetDevice.
+	*/
+	class RenderDevice {
+	public:
+		virtual ~RenderDevice() = default;
+
+		// ------------------------- Buffers -------------------------
+
+		/*
+		* @param data can be nullptr to only allocate
+		*/
+		virtual GpuHandle CreateBuffer(BufferType type, const void* data, size_t size, BufferUsage usage) = 0;
+		/*
+		* @brief Reallocates the buffer with new data
+		*/
+		virtual void SetBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, BufferUsage usage) = 0;
+		/*
+		* @brief Overwrites a part of the buffer, has to fit into the allocated size
+		*/
+		virtual void UpdateBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, size_t offset) = 0;
+		virtual void DeleteBuffer(GpuHandle buffer) = 0;
+
+		// ------------------------- Vertex arrays -------------------------
+
+		virtual GpuHandle CreateVertexArray(const std::vector<VertexAttribute>& attributes, GpuHandle indexBuffer) = 0;
+		virtual void DeleteVertexArray(GpuHandle vertexArray) = 0;
+
+		// ------------------------- Textures -------------------------
+
+		/*
+		* @param data tightly packed rows, width * height * channels bytes
+		* @return 0 if the channel count is not supported
+		*/
+		virtual GpuHandle CreateTexture2D(const TextureDesc& desc, const unsigned char* data) = 0;
+		/*
+		* @brief Overwrites a rectangle of the texture, mipmaps are not regenerated
+		* @param data tightly packed rows, width * height * channels bytes in the channel count of the texture
+		*/
+		virtual void UpdateTexture2D(GpuHandle texture, int x, int y, int width, int height, int channels, const unsigned char* data) = 0;
+		virtual void DeleteTexture(GpuHandle texture) = 0;
+		virtual void BindTexture(unsigned int unit, GpuHandle texture) = 0;
+		/*
+		* @brief Gets the texture last bound to the unit through this device
+		*/
+		virtual GpuHandle GetBoundTexture(unsigned int unit) const = 0;
+		virtual unsigned int GetMaxTextureUnits() const = 0;
+
+		// ------------------------- Framebuffers -------------------------
+
+		/*
+		* @brief Creates a framebuffer with an RGBA8 color and a depth/stencil attachment
+		* @return 0 if the framebuffer is incomplete
+		*/
+		virtual GpuHandle CreateFramebuffer(int width, int height) = 0;
+		/*
+		* @brief Creates a framebuffer without depth that draws into an existing RGBA8 texture of the same size.
+		* The texture is not deleted with the framebuffer
+		* @return 0 if the framebuffer is incomplete
+		*/
+		virtual GpuHandle CreateTextureFramebuffer(GpuHandle colorTexture, int width, int height) = 0;
+		virtual void DeleteFramebuffer(GpuHandle framebuffer) = 0;
+		/*
+		* @brief Draws go into the framebuffer, 0 = window
+		*/
+		virtual void BindFramebuffer(GpuHandle framebuffer) = 0;
+		virtual void SetViewport(int x, int y, int width, int height) = 0;
+		/*
+		* @brief Limits draws and clears to the rect (bottom left origin), disabled draws everywhere again
+		*/
+		virtual void SetScissor(bool enabled, int x, int y, int width, int height) = 0;
+
+		// ------------------------- Readback -------------------------
+
+		virtual GpuHandle CreateReadbackBuffer(size_t size) = 0;
+		virtual void DeleteReadbackBuffer(GpuHandle readbackBuffer) = 0;
+		/*
+		* @brief Starts copying the RGBA8 pixels of the framebuffer (bottom row first) into the
+		* readback buffer, returns without waiting for the GPU
+		*/
+		virtual void ReadPixelsAsync(GpuHandle framebuffer, int width, int height, GpuHandle readbackBuffer) = 0;
+		/*
+		* @brief Checks without waiting if the last ReadPixelsAsync into the buffer finished
+		*/
+		virtual bool IsReadbackReady(GpuHandle readbackBuffer) = 0;
+		/*
+		* @brief Copies the content of the readback buffer, waits if the copy is not finished yet
+		* @return false if the buffer could not be read
+		*/
+		virtual bool ReadReadbackBuffer(GpuHandle readbackBuffer, void* outData, size_t size) = 0;
+
+		// ------------------------- Programs -------------------------
+
+		/*
+		* @brief Compiles and links a vertex and fragment shader, errors are logged
+		*/
+		virtual GpuHandle CreateProgram(const std::string& vertexCode, const std::string& fragmentCode) = 0;
+		virtual void DeleteProgram(GpuHandle program) = 0;
+		virtual void UseProgram(GpuHandle program) = 0;
+		/*
+		* @brief Gets the program last used through this device
+		*/
+		virtual GpuHandle GetCurrentProgram() const = 0;
+		/*
+		* @return -1 if the program has no active uniform with this name
+		*/
+		virtual int GetUniformLocation(GpuHandle program, const std::string& name) = 0;
+
+		// uniforms of the current program
+		virtual void SetUniformInt(int location, int value) = 0;
+		/*
+		* @param components 1 - 4 (float, vec2, vec3, vec4)
+		*/
+		virtual void SetUniformFloats(int location, const float* values, int components) = 0;
+		/*
+		* @param data columns * rows floats in column-major order
+		*/
+		virtual void SetUniformMatrix(int location, int columns, int rows, const float* data) = 0;
+
+		// ------------------------- State -------------------------
+
+		virtual void SetDepthTest(bool enabled) = 0;
+		virtual void SetFrontFace(FrontFace frontFace) = 0;
+		virtual void SetBlendMode(BlendMode mode) = 0;
+		virtual void ClearDepth() = 0;
+		/*
+		* @brief Clears the color of the bound framebuffer
+		*/
+		virtual void ClearColor(float r, float g, float b, float a) = 0;
+
+		// ------------------------- Draw -------------------------
+
+		/*
+		* @brief Draws indexed triangles (unsigned int indices)
+		*/
+		virtual void DrawIndexed(GpuHandle vertexArray, int indexCount) = 0;
+		virtual void DrawIndexedInstanced(GpuHandle vertexArray, int indexCount, int instanceCount) = 0;
+	};
+
+}
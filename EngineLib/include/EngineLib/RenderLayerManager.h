@@ -22,10 +22,14 @@ namespace EngineCore {
 	*       and both are behind a layer with priority 1.
 	*     - This makes it possible to enforce strict ordering independent of depth testing,
 	*       for example to ensure UI or overlays are always rendered on top.
+	* - Every layer gets a bit in a RenderLayerMask, so camera visibility is a single AND.
+	*   There can be at most MAX_RENDER_LAYERS layers.
 	*/
 	class RenderLayerManager {
 		friend class Engine;
 	public:
+		static constexpr size_t MAX_RENDER_LAYERS = sizeof(RenderLayerMask) * 8;
+
 		/*
 		* @brief Adds a new render layer with the specified name.
 		*        Layers can be assigned to GameObjects or Cameras to control visibility.
@@ -56,6 +60,17 @@ namespace EngineCore {
 		*/
 		static int GetLayerPriority(RenderLayerID layerID);
 
+		/*
+		* @brief Gets the bit of the layer
+		* @return 0 if the layer does not exist
+		*/
+		static RenderLayerMask GetLayerMask(RenderLayerID layerID);
+
+		/*
+		* @brief Gets the bits of all the layers
+		*/
+		static RenderLayerMask GetLayerMask(const std::vector<RenderLayerID>& layerIDs);
+
 		/*
 		* @brief Returns a vector containing all layer names.
 		* @return A vector of all layer names.
@@ -79,10 +94,16 @@ namespace EngineCore {
 	private:
 		RenderLayerManager() = delete;
 
+		static constexpr unsigned int INVALID_LAYER_INDEX = std::numeric_limits<unsigned int>::max();
+
 		// Internal mapping of layer names to their unique indices
 		static inline std::unordered_map<std::string, RenderLayerID> m_nameToID;
-		static inline std::unordered_map<RenderLayerID, int> m_idToPriority;
 		static inline IDManager m_idManager;
+		// layers are never removed, so the ids stay small and can index a flat array
+		static inline std::vector<unsigned int> m_idToIndex;	// id value -> bit index
+		static inline std::vector<int> m_indexToPriority;		// bit index -> priority
+
+		static unsigned int GetLayerIndex(RenderLayerID layerID);
 
 		// Flag to prevent adding new layers after initialization
 		static inline bool m_lock = false;
@@ -1,9 +1,11 @@
 #pragma once
 #include <memory>
+#include <CoreLib/Math/Vector3.h>
+#include <CoreLib/Math/Vector4.h>
 
 #include "EngineTypes.h"
-
-class Matrix4x4;
+#include "RenderDevice.h"
+#include "Mesh.h"
 
 namespace EngineCore {
 
@@ -12,21 +14,99 @@ namespace EngineCore {
         class Camera;
     }
 
+    /*
+    * @brief Graphics API the renderer submits to.
+    * Recording runs the same render path on a RecordingRenderDevice without any GPU calls (used without window)
+    */
+    enum class RenderBackend {
+        OpenGL = 0,
+        Recording
+    };
+
+    /*
+    * @brief Counters of the last DrawAll
+    */
+    struct RenderStats {
+        size_t commands = 0;    // commands submitted this frame
+        size_t drawCalls = 0;   // instanced mesh batches and text quads
+        size_t instances = 0;   // meshes drawn over all batches
+        size_t cameras = 0;     // cameras rendered
+        size_t culled = 0;      // commands outside of a camera frustum, counted per camera
+    };
+
     class Renderer {
     friend class Engine;
     public:
         Renderer() = default;
 
         static Renderer* GetInstance();
+        static RenderBackend GetBackend();
+        /*
+        * @brief Gets the device every GPU resource and draw call goes through
+        */
+        static RenderDevice* GetDevice();
+        /*
+        * @brief Queues the command for DrawAll, commands of layers no camera renders are dropped
+        */
         void Submit(const RenderCommand& cmd);
         void ReserveCommands(size_t count);
+        /*
+        * @brief UI commands submitted until EndUITarget are drawn into the framebuffer before the rest of the UI.
+        * Only the scissor rect (pixels, bottom left origin) is cleared and drawn, the framebuffer ends up with
+        * premultiplied colors (BlendMode::Layer). Targets can not be nested
+        */
+        void BeginUITarget(GpuHandle framebuffer, int width, int height, int scissorX, int scissorY, int scissorWidth, int scissorHeight);
+        void EndUITarget();
+
+        const RenderStats& GetStats() const;
 
     private:
+        static inline RenderBackend m_backend = RenderBackend::OpenGL;
+        static inline std::unique_ptr<RenderDevice> m_device = nullptr;
+
         std::vector<RenderCommand> m_commands;// can be optimced with a ptr
-        std::vector<Matrix4x4> m_instanceMatrices;
+        std::vector<InstanceData> m_instances; // instances of the current batch
+        std::vector<Vector4> m_commandBounds; // world bounding sphere per command (xyz center, w radius), w < 0 is never culled
+        std::vector<std::shared_ptr<Component::Camera>> m_frameCameras; // cameras of this frame, sorted by priority
+        RenderLayerMask m_visibleLayers = ~RenderLayerMask(0); // layers of all frame cameras
+        RenderLayerMask m_uiLayers = ~RenderLayerMask(0); // layers of the main camera, UI is drawn once on top
+        Vector3 m_sortPosition; // transparent commands are sorted by the distance to this point
+        GpuHandle m_surfaceFramebuffer = 0;
+        int m_surfaceWidth = 0;
+        int m_surfaceHeight = 0;
+        RenderStats m_stats;
+
+        struct UITarget {
+            GpuHandle framebuffer = 0;
+            int width = 0;
+            int height = 0;
+            int scissor[4] = { 0, 0, 0, 0 }; // x, y, width, height
+            size_t begin = 0; // UI commands [begin, end), counted from the first UI command
+            size_t end = 0;
+        };
+        std::vector<UITarget> m_uiTargets;
+        size_t m_uiCommandCount = 0; // UI commands submitted this frame
+
+        /*
+        * @brief Creates the device of the backend, has to be called before any GPU resource is created
+        */
+        static void InitBackend(RenderBackend backend);
 
+        /*
+        * @brief Collects the cameras of this frame (main camera and additional cameras), call before the draw commands are sent
+        * @param surfaceFramebuffer framebuffer cameras without render target draw into (0 = window)
+        */
+        void BeginFrame(GpuHandle surfaceFramebuffer, int surfaceWidth, int surfaceHeight);
         void DrawAll();
-        void SortDrawCommands(std::shared_ptr<Component::Camera> cameraPtr);
+        void SortDrawCommands(const Vector3& viewPosition);
+        /*
+        * @brief Calculates m_commandBounds for the sorted commands, shared by all cameras
+        */
+        void CalculateCommandBounds();
+        /*
+        * @brief Draws the commands [begin, end) with the view of the camera, camera == nullptr draws UI commands
+        */
+        void DrawCommands(size_t begin, size_t end, Component::Camera* camera, RenderLayerMask layers);
         void PrintCommands(bool displayOption);
     };
 
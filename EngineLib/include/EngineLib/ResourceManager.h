@@ -8,6 +8,7 @@
 #include "Shader.h"
 #include "Material.h"
 #include "FontAsset.h"
+#include "SpriteAtlas.h"
 #include "IDManager.h"
 #include "EngineTypes.h"
 
@@ -43,6 +44,8 @@ namespace EngineCore {
         Shader* GetShader(ShaderID id);
         Material* GetMaterial(MaterialID id);
         FontAsset* GetFontAsset(FontID id);
+        // Runtime atlas the SpriteRenderers pack their textures into
+        SpriteAtlas& GetSpriteAtlas();
 
         const FontAsset::Glyph& GetFontGlyph(FontID id, char c, int pixelSize);
         unsigned int GetFontAtlasTextureID(FontID id, int pixelSize);
@@ -113,6 +116,7 @@ namespace EngineCore {
         std::unordered_map<ShaderID, std::unique_ptr<Shader>> m_shaders;
         std::unordered_map<MaterialID, std::unique_ptr<Material>> m_materials;
         std::unordered_map<FontID, std::unique_ptr<FontAsset>> m_fonts;
+        SpriteAtlas m_spriteAtlas;
 
         unsigned int GetNewUniqueId(AssetType counter);
         void Cleanup();
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 
@@ -67,6 +68,17 @@ namespace EngineCore {
 		* @return True if at least one texture has alpha channels.
 		*/
 		bool GetIsTransparent() const;
+		/**
+		* @brief Gets a key of all stored parameter names and values (64 bit hash).
+		* Objects with the same key bind the same values, so the renderer draws their commands in one batch.
+		* @return 0 if no parameter is stored.
+		*/
+		uint64_t GetBindKey() const;
+		/**
+		* @brief Compares every stored parameter name and value.
+		* Different keys never match, equal keys can still collide, so the renderer checks this before merging batches.
+		*/
+		bool HasSameParams(const ShaderBindObject& other) const;
 
 		// Convenience functions to retrieve parameters of specific types
 
@@ -82,6 +94,8 @@ namespace EngineCore {
 	private:
 		static inline unsigned int m_maxTextureUnits = 0;/**< Maximum number of texture units supported. */
 		bool m_isTransparent = false; /**< True if any bound texture has transparency. */
+		mutable uint64_t m_bindKey = 0; /**< Cached result of GetBindKey. */
+		mutable bool m_bindKeyDirty = false; /**< Set by SetParam. */
 
 		// Stored parameters grouped by type
 		std::unordered_map<std::string, bool> m_boolParams;
@@ -107,6 +121,12 @@ namespace EngineCore {
 		*/
 		void SetIsTransparent(Texture2DID id);
 
+		/**
+		* @brief Hashes every parameter, independent of the map order.
+		* @return 0 if no parameter is stored.
+		*/
+		uint64_t ComputeBindKey() const;
+
 		/**
 		* @brief Helper to convert a map of parameters to a vector of values.
 		* @tparam T Parameter type.
@@ -14,31 +14,37 @@ namespace EngineCore {
             "T is not a valid param type. Must be bool, int, float, Vector2, Vector3, Vector4, Matrix, or Asset_Texture2DID"
             );
 
+        // only looks the param up, the values (and the bind key) only change with SetParam
+        const std::unordered_map<std::string, T>* params = nullptr;
         if constexpr (std::is_same<T, bool>::value) {
-            return m_boolParams[name];
+            params = &m_boolParams;
         }
         else if constexpr (std::is_same<T, int>::value) {
-            return m_intParams[name];
+            params = &m_intParams;
         }
         else if constexpr (std::is_same<T, float>::value) {
-            return m_floatParams[name];
+            params = &m_floatParams;
         }
         else if constexpr (std::is_same<T, Vector2>::value) {
-            return m_vector2Params[name];
+            params = &m_vector2Params;
         }
         else if constexpr (std::is_same<T, Vector3>::value) {
-            return m_vector3Params[name];
+            params = &m_vector3Params;
         }
         else if constexpr (std::is_same<T, Vector4>::value) {
-            return m_vector4Params[name];
+            params = &m_vector4Params;
         }
         else if constexpr (std::is_same<T, Matrix>::value) {
-            return m_matrixParams[name];
+            params = &m_matrixParams;
         }
         else if constexpr (std::is_same<T, Texture2DID>::value) {
-            return m_textureParams[name];
+            params = &m_textureParams;
         }
 
+        auto it = params->find(name);
+        if (it != params->end())
+            return it->second;
+
         Log::Warn("ShaderBindObject: Param {} not found!", name);
         static T dummy;
         return dummy;
@@ -58,6 +64,7 @@ namespace EngineCore {
             "T is not a valid param type. Must be bool, int, float, Vector2, Vector3, Vector4, Matrix, or Asset_Texture2DID"
             );
 
+        m_bindKeyDirty = true;
         // save value in the right map
         if constexpr (std::is_same<T, bool>::value) {
             m_boolParams[name] = value;
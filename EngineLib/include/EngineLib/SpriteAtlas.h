@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <CoreLib/Math/Vector4.h>
+
+#include "EngineLib/EngineTypes.h"
+
+namespace EngineCore {
+
+	/*
+	* @brief Packs small sprite textures into shared RGBA8 pages at runtime.
+	*
+	* Sprites on the same page only differ in their uv rect, which is an instance attribute,
+	* so they share one ShaderBindObject value and are drawn in one batch. Pages are ordinary
+	* Texture2D assets, a page is only shared by textures with the same mag filter.
+	* Get the atlas with ResourceManager::GetSpriteAtlas.
+	*/
+	class SpriteAtlas {
+	public:
+		struct Region {
+			Texture2DID texture = Texture2DID(ENGINE_INVALID_ID);	// page texture
+			Vector4 uvRect{ 0, 0, 1, 1 };							// uv offset (xy) and scale (zw) on the page
+			uint64_t serial = 0;									// unique per Pack, a reused id gets a new one
+		};
+
+		/*
+		* @param pageSize width and height of a page in pixels
+		* @param padding border around every sprite, filled with its edge pixels so filtering does not bleed
+		* @param maxSpriteSize textures with a bigger side are not packed
+		*/
+		SpriteAtlas(int pageSize = 2048, int padding = 1, int maxSpriteSize = 512);
+
+		SpriteAtlas(const SpriteAtlas&) = delete;
+		SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+
+		/*
+		* @brief Gets the region of the texture, packs it the first time
+		* @return false if the texture can not be packed (too big, no pixels), use the texture itself then
+		*/
+		bool Pack(Texture2DID id, Region& outRegion);
+		/*
+		* @return false if the texture is not packed
+		*/
+		bool TryGetRegion(Texture2DID id, Region& outRegion) const;
+		/*
+		* @brief Forgets the region of the texture, its space on the page gets reused (see GetGeneration).
+		* A page is deleted together with its texture once its last sprite is removed
+		*/
+		void Remove(Texture2DID id);
+		/*
+		* @brief Deletes all pages
+		*/
+		void Clear();
+
+		size_t GetPageCount() const;
+		size_t GetSpriteCount() const;
+		/*
+		* @brief Changes every time a region is removed, regions that were copied before have to be looked up again
+		*/
+		uint64_t GetGeneration() const;
+
+	private:
+		struct Span {
+			int x = 0;
+			int width = 0;
+		};
+
+		struct Shelf {
+			int y = 0;
+			int height = 0;
+			int x = 0;						// end of the used columns, everything right of it is free
+			std::vector<Span> freeSpans;	// removed blocks left of x, sorted by x
+		};
+
+		struct Page {
+			Texture2DID texture = Texture2DID(ENGINE_INVALID_ID);
+			unsigned int filter = 0;
+			std::vector<Shelf> shelves;
+			int nextShelfY = 0;
+			size_t spriteCount = 0;
+		};
+
+		// where a packed texture is, so Remove can give the block back
+		struct Placement {
+			Region region;
+			size_t shelf = 0;
+			int x = 0;
+			int width = 0;	// block width with padding
+		};
+
+		int m_pageSize = 2048;
+		int m_padding = 1;
+		int m_maxSpriteSize = 512;
+		uint64_t m_nextSerial = 1;
+		uint64_t m_generation = 0;
+
+		std::vector<Page> m_pages;
+		std::unordered_map<Texture2DID, Placement> m_placements;
+		std::vector<unsigned char> m_blockBuffer; // padded sprite, reused
+
+		/*
+		* @brief Finds space for a width x height block on the page (shelf packing), reuses removed blocks first
+		*/
+		bool Allocate(Page& page, int width, int height, int& outX, int& outY, size_t& outShelf);
+		/*
+		* @brief Gives a block back to its shelf, empty shelves at the bottom of the page give their rows back
+		*/
+		void Free(Page& page, size_t shelfIndex, int x, int width);
+		Page* CreatePage(unsigned int filter);
+	};
+
+}
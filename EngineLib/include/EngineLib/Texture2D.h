@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 #include "EngineTypes.h"
 
 typedef unsigned int GLenum;
@@ -155,6 +156,19 @@ namespace EngineCore {
          */
         void SetGenerateMipmaps(bool enable);
 
+        /**
+        * @brief Overwrites a rectangle of the texture, on the GPU and in the kept image data.
+        * Mipmaps are not regenerated, so only use it on textures without mipmaps.
+        * @param data tightly packed rows in the channel count of the texture
+        */
+        void UpdateRegion(int x, int y, int width, int height, const unsigned char* data);
+
+        /**
+        * @brief Gets the pixels converted to RGBA8, top row first. Textures loaded from file are decoded again.
+        * @return false if the texture has no pixels
+        */
+        bool GetPixelsRGBA(std::vector<unsigned char>& outPixels) const;
+
         /**
          * @return The OpenGL texture ID.
          */
@@ -185,6 +199,11 @@ namespace EngineCore {
          */
         int GetNrChannels() const;
 
+        /**
+         * @return The filter used when the texture is upscaled.
+         */
+        unsigned int GetFilterMag() const;
+
     private:
         bool m_exists = false;
 
@@ -206,6 +225,11 @@ namespace EngineCore {
 
         bool m_createMipmaps = true;
 
+        /*
+        * @brief Creates the GPU texture from the size, channels and sampling settings
+        * @return false if the channel count is not supported
+        */
+        bool CreateTexture(const unsigned char* data);
         void LoadTextureFallback();
         unsigned char* GenerateFallbackTexture();
     };
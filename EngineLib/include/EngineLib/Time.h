@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 
 namespace EngineCore {
 	class Engine;
@@ -19,13 +20,23 @@ namespace EngineCore {
 		// Gets the time diff between current frame and last frame time in seconds
 		static double GetDeltaTimeDouble();
 
+		/*
+		* @brief Returns the current time in seconds
+		*/
+		using Clock = std::function<double()>;
+
 	private:
 		Time();
+		/*
+		* @brief Sets the clock GetTime and the frame delta time are based on (nullptr = glfwGetTime)
+		*/
+		static void SetClock(Clock clock);
 		static void UpdateTime(double currentTimeSec);
 		static void CalculateDeltaTime(double currentTimeSec);
 
 		static inline double m_lastFrameTimeSec = 0.0;
 		static inline double m_deltaTimeSec = 0.0;
 		static inline unsigned int m_frameCount = 0;// maybe std::uint64_t
+		static inline Clock m_clock;
 	};
 }
\ No newline at end of file
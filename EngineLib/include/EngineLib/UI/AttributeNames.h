@@ -153,6 +153,11 @@ namespace Attribute {
 	* @param number in sekunds
 	*/
 	constexpr const char* duration = "duration";
+	/*
+	* @brief Sets the curve of the transition between styles
+	* @param linear, ease-in, ease-out, ease-in-out
+	*/
+	constexpr const char* easing = "easing";
 
 }
 
@@ -14,6 +14,7 @@
 #include "EngineLib/UI/LayoutCalc/FlexLayoutCalculator.h"
 #include "EngineLib/UI/LayoutCalc/GridLayoutCalculator.h"
 #include "EngineLib/UI/IUIElementDetailRenderer.h"
+#include "EngineLib/UI/LayerCache.h"
 #include "../Style.h"
 
 namespace EngineCore {
@@ -25,6 +26,10 @@ namespace EngineCore::UI {
 
     class ElementBase {
     friend class UIManager;
+    friend class FlexLayoutCalculator;
+    friend class GridLayoutCalculator;
+    friend class HitGrid;
+    friend class TransitionSystem;
     public:
         using Callback = std::function<void()>;
 
@@ -43,6 +48,8 @@ namespace EngineCore::UI {
             );
 
             basePtr->SetParent(this, m_children.size());
+            m_layoutCache.Invalidate();
+            MarkHierarchyChanged();
             basePtr->Init();
 
             return std::static_pointer_cast<T>(basePtr);
@@ -137,36 +144,35 @@ namespace EngineCore::UI {
         float GetBorderBottom() const;
         float GetBorderLeft() const;
         float GetDuration() const;
+        Easing GetEasing() const;
 
-        /**
-        * @brief Computes the total (Desired + border + margin) size of all sibling elements except this element.
-        * @return A Vector2 representing the summed margin size of the siblings.
-        */
-        Vector2 ComputeSiblingsTotalDesiredPixelSize() const;
+        State GetState() const;
+        bool IsCached() const;
 
-        /**
-        * @brief Computes the total (Layout + border + margin)  size of all sibling elements except this element.
-        * @return A Vector2 representing the summed margin size of the siblings.
+        /*
+        * @brief Sets the state, its style gets applied with the next UI update.
+        * The hover and press handling of the UIManager overrides Hovered, Pressed and Normal of the element under the mouse
         */
-        Vector2 ComputeSiblingsTotalLayoutSize() const;
-
-        State GetState() const;
+        void SetState(State state);
 
         size_t GetChildCount() const;
         std::shared_ptr<ElementBase> GetChild(size_t index);
         std::vector<std::shared_ptr<ElementBase>>& GetChildren();
         const std::vector<std::shared_ptr<ElementBase>>& GetChildren() const;
+
+        /*
+        * @brief Changes whenever an element is added to or removed from any child list
+        */
+        static size_t GetHierarchyVersion();
     protected:
         std::string m_elementName;
         UIElementID m_id;
         // Style m_elementStyle; needs to be later used for clean transition between styles
         // element should probably have a default style that can be modified with a function that can be overridden
         // maybe need to add limit to how often per frame style updates can be applyd
-        Style::SubscriberID m_styleDirtyCallbackID = 0;
-        Style::SubscriberID m_baseStyleDirtyCallbackID = 0;
         std::shared_ptr<Style> m_style = nullptr;
         std::shared_ptr<Style> m_baseStyle = nullptr; // element base style
-        std::shared_ptr<Style> m_mergedStyle = nullptr;// style extended form m_baseStyle and m_style
+        std::shared_ptr<Style> m_mergedStyle = nullptr;// style extended form m_baseStyle and m_style, shared with elements that use the same styles
         ElementBase* m_parentElementPtr = nullptr;
         // position of this child in the parent child list
         size_t m_listPosition = 0;
@@ -174,7 +180,7 @@ namespace EngineCore::UI {
         State m_state = State::Normal;
         RenderCommand m_cmd;
         MaterialID m_materialID{ ENGINE_INVALID_ID };
-        ShaderBindObject m_sbo;
+        ShaderBindObject m_sbo;// extra uniforms for custom element materials, an empty one does not split a batch
 
         Callback m_onClick = nullptr;
         Callback m_onHover = nullptr;
@@ -196,6 +202,28 @@ namespace EngineCore::UI {
 
         virtual void OnUIElementGUIImpl(IUIElementDetailRenderer& ui) {};
 
+        /*
+        * @brief Grid cell of the child at listPosition (grid layout). Containers that recycle their children map them to other cells
+        */
+        virtual size_t GetGridCellIndex(size_t listPosition) const { return listPosition; }
+        /*
+        * @brief Columns of the grid layout, 0 = as many as fit into the content width
+        */
+        virtual size_t GetGridColumnCount() const { return 0; }
+        /*
+        * @brief Gets subtracted from the positions of the children (grid layout)
+        */
+        virtual Vector2 GetScrollOffset() const { return Vector2(0, 0); }
+
+        /**
+        * @brief Marks this element and its children dirty for matrix/layout recalculation.
+        */
+        void MarkTransDirty() const;
+        /*
+        * @brief Has to be called after elements got removed from a child list without UIManager::DeleteElement
+        */
+        static void MarkHierarchyChanged();
+
         void CallOnClick();
         void CallOnHover();
         void CallOnPress();
@@ -206,8 +234,6 @@ namespace EngineCore::UI {
         void RemoveStyleInternal(std::shared_ptr<Style> style);
         void ClearStyleInternal();
 
-        void SetState(State state);
-
         void SetLayoutType(LayoutType layoutType);
         void SetLayoutDirection(Flex::LayoutDirection direction);
         void SetLayoutWrap(Flex::LayoutWrap wrap);
@@ -302,6 +328,8 @@ namespace EngineCore::UI {
         void SetPaddingLeft(float left);
 
         void SetDuration(float duration);
+        void SetEasing(Easing easing);
+        void SetCachedInternal(bool value);
 
         /*
         * @brief Checks whether a given point lies within the bounding box of this element.
@@ -334,18 +362,36 @@ namespace EngineCore::UI {
         /*
         * @brief sets all params of this element to default values. NEEDS to be expandet on if new params of the shader get added
         */
-        void InitShaderBindObject();
 
         static inline bool m_attributesRegistered = false;
+        static inline size_t s_hierarchyVersion = 0;
+        // the layout validates caches while it runs, MarkTransDirty always walks the subtree then
+        static inline bool s_layoutRunning = false;
+        // applied before the other attributes, they decide how the other values change
+        static inline size_t s_durationAttributeID = SIZE_MAX;
+        static inline size_t s_easingAttributeID = SIZE_MAX;
         static inline FlexLayoutCalculator s_flexCalculator;
         static inline GridLayoutCalculator s_gridCalculator;
         /*
-        * @brief Map of attribute names to behavior callbacks.
+        * @brief Behavior callbacks, indexed by the StyleAttribute id.
         */
-        static inline std::unordered_map<std::string, std::function<void(ElementBase*, const StyleValue&)>> m_registeredAttributes;
+        static inline std::vector<std::function<void(ElementBase*, const StyleValue&)>> m_registeredAttributes;
         
         mutable bool m_transformDirty = true;
+        // MarkTransDirty reached the whole subtree and nothing of it was laid out since
+        mutable bool m_subtreeDirty = false;
         mutable bool m_styleDirty = true;
+        bool m_styleApplied = false;// the first style snaps, later ones transition
+        size_t m_appliedStyleGeneration = 0;// generation of m_mergedStyle the attributes were set from
+        // layout results of the children, invalidated with MarkTransDirty
+        mutable LayoutCache m_layoutCache;
+        // entry of this element in the hit grid of the UIManager
+        size_t m_hitIndex = SIZE_MAX;
+        bool m_isCached = false;
+        // texture of a cached element, created and owned by the UIManager
+        LayerCache* m_layer = nullptr;
+        // screen bounds of the last frame, cleared in the layers above if the element changes
+        LayerCache::Rect m_renderRect;
 
         // Calculated final position of the element including layout effects (major/minor alignment, parent constraints, etc.)
         Vector2 m_layoutPosition{ 0.0f, 0.0f };
@@ -384,6 +430,7 @@ namespace EngineCore::UI {
         Vector4 m_borderRadius{ 0, 0, 0, 0 }; // top-left, top-right, bottom-right, bottom-left
         Vector4 m_borderSize{ 0, 0, 0, 0 };
         float m_duration = 0.0f;
+        Easing m_easing = Easing::EaseInOut;
 
         /**
         * @brief Calculates the layout-relative position (taking into account margin and alignment).
@@ -404,17 +451,26 @@ namespace EngineCore::UI {
         * @brief Marks the parent and its children dirty for matrix/layout recalculation.
         */
         void MarkTransDirtyParent() const;
-        /**
-        * @brief Marks this element and its children dirty for matrix/layout recalculation.
+        /*
+        * @brief The old and the new screen bounds of the element get redrawn in every cached layer above it
         */
-        void MarkTransDirty() const;
+        void MarkRenderDirty();
 
         void UpdateImpl();
         void SendDrawCommandImpl(Renderer* renderer, RenderLayerID renderLayerID);
         void RegisterAttributesImpl();
         void SetParent(ElementBase* elementPtr, size_t indexPos);
-        void SetAttributes(const std::unordered_map<std::string, std::string>& attribute);
         void SetStyleAttributes();
+        /*
+        * @brief Sets a style value, over the style duration if one is set (UIManager transitions)
+        */
+        void TransitionTo(TransitionProperty property, const Vector4& value, StyleUnit::Unit unit = StyleUnit::Unit::PX);
+        void TransitionTo(TransitionProperty property, float value, StyleUnit::Unit unit = StyleUnit::Unit::PX);
+        /*
+        * @brief Current value of a property, single values are in x
+        */
+        Vector4 GetTransitionValue(TransitionProperty property) const;
+        void SetTransitionValue(TransitionProperty property, const Vector4& value, StyleUnit::Unit unit);
         void SetLayoutSize(const Vector2& size);
         void SetLayoutSize(float x, float y);
         /*
@@ -472,6 +528,14 @@ namespace EngineCore::UI {
             ClearStyleInternal();
             return static_cast<Derived*>(this);
         }
+
+        /*
+        * @brief Draws the element and its children into a texture that is only redrawn where something changed
+        */
+        Derived* SetCached(bool value) {
+            SetCachedInternal(value);
+            return static_cast<Derived*>(this);
+        }
     };
 
 }
@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "EngineLib/EngineTypes.h"
+#include "EngineLib/UI/Elements/Element.h"
+#include "EngineLib/UI/Elements/Panel.h"
+
+namespace EngineCore::UI {
+
+    /*
+    * @brief Scrollable list or grid over a data source of any size.
+    * Only the visible rows and a few overscan rows exist as Panel items. They are recycled while scrolling
+    * and filled by the bind callback, so a frame costs the same for 50 and for 100k items.
+    * The items are placed with the grid layout, the item style decides the cell size.
+    */
+    class VirtualList : public Element<VirtualList> {
+    public:
+        enum class Mode {
+            List,   // one column
+            Grid    // as many columns as fit into the width
+        };
+        using BindCallback = std::function<void(size_t index, Panel& item)>;
+
+        VirtualList(UIElementID id, std::shared_ptr<Style> style = std::make_shared<Style>(),
+            std::shared_ptr<Style> itemStyle = std::make_shared<Style>());
+
+        VirtualList* SetMode(Mode mode);
+        VirtualList* SetItemCount(size_t count);
+        /*
+        * @brief Called when an item shows a new index, the item is reused for other indices later
+        */
+        VirtualList* SetOnBind(BindCallback callback);
+        /*
+        * @brief Rows that exist above and below the visible rows (default 2)
+        */
+        VirtualList* SetOverscan(size_t rows);
+        VirtualList* SetScroll(float scroll);
+        VirtualList* ScrollBy(float amount);
+        /*
+        * @brief Pixels scrolled per mouse wheel step (default 40)
+        */
+        VirtualList* SetScrollSpeed(float speed);
+        /*
+        * @brief Binds all items again, call when the data behind the visible items changed
+        */
+        VirtualList* Refresh();
+
+        Mode GetMode() const;
+        size_t GetItemCount() const;
+        float GetScroll() const;
+        float GetMaxScroll() const;
+        /*
+        * @brief Gets the number of item elements (visible + overscan)
+        */
+        size_t GetPoolSize() const;
+        /*
+        * @return The index the item element shows, or SIZE_MAX if it is not bound yet
+        */
+        size_t GetBoundIndex(size_t poolIndex) const;
+
+    protected:
+        void Update() override;
+        void SendDrawCommand(Renderer* renderer) override;
+        void OnUIElementGUIImpl(IUIElementDetailRenderer& ui) override;
+
+        size_t GetGridCellIndex(size_t listPosition) const override;
+        size_t GetGridColumnCount() const override;
+        Vector2 GetScrollOffset() const override;
+
+    private:
+        static constexpr size_t UNBOUND_INDEX = SIZE_MAX;
+
+        Mode m_mode = Mode::List;
+        size_t m_itemCount = 0;
+        size_t m_overscan = 2;
+        float m_scroll = 0.0f;
+        float m_maxScroll = 0.0f;
+        float m_scrollSpeed = 40.0f;
+        std::shared_ptr<Style> m_itemStyle = nullptr;
+        BindCallback m_onBind = nullptr;
+        // item index shown by each child, child i shows an index with index % pool size == i
+        std::vector<size_t> m_boundIndices;
+
+        /*
+        * @brief Calculates the visible range, resizes the pool and binds the items that show a new index
+        */
+        void UpdatePool();
+        /*
+        * @brief Creates or deletes items, all items get unbound
+        */
+        void ResizePool(size_t size);
+    };
+
+}
\ No newline at end of file
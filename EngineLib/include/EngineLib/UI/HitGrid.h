@@ -0,0 +1,102 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <CoreLib/Math/Vector2.h>
+
+namespace EngineCore::UI {
+
+    class ElementBase;
+
+    /*
+    * @brief Flat list of the screen rects of all UI elements, bucketed into a uniform grid over the window.
+    *
+    * Every rect is clipped by the rects of its parents, because the hover walk only enters a child
+    * if the mouse is over the parent. The entries are in hierarchy order (parents before children,
+    * later siblings after earlier ones), so the hovered element is the last entry that contains the mouse.
+    * Only moved elements are updated, the list is rebuilt when elements are added or removed.
+    */
+    class HitGrid {
+    public:
+        /*
+        * @param cellSize width and height of a grid cell in pixels
+        */
+        HitGrid(float cellSize = 64.0f);
+
+        /*
+        * @brief Sets the area covered by the grid, forces a rebuild
+        */
+        void SetBounds(const Vector2& size);
+        /*
+        * @brief Forces a rebuild with the next Update
+        */
+        void Invalidate();
+
+        /*
+        * @brief Brings the grid up to date with the layout
+        * @param root element whose children get hit tested, the root itself is never hovered
+        * @param movedElements elements that got a new layout position this frame, in hierarchy order
+        */
+        void Update(ElementBase& root, const std::vector<ElementBase*>& movedElements);
+
+        /*
+        * @brief Finds the deepest element under the point
+        * @return nullptr if no element contains the point
+        */
+        std::shared_ptr<ElementBase> Find(const Vector2& point) const;
+
+        /*
+        * @brief Changes every time the rect of an element changes, results of Find stay valid while it is the same
+        */
+        size_t GetGeneration() const;
+        size_t GetEntryCount() const;
+
+    private:
+        static constexpr size_t NO_PARENT = SIZE_MAX;
+
+        struct Rect {
+            float minX = 0.0f;
+            float minY = 0.0f;
+            float maxX = 0.0f;
+            float maxY = 0.0f;
+
+            bool IsEmpty() const;
+            bool Contains(const Vector2& point) const;
+            bool operator==(const Rect& other) const = default;
+        };
+
+        struct Entry {
+            std::shared_ptr<ElementBase> element;
+            size_t parent = NO_PARENT;
+            Rect rect; // clipped by the parent rects
+        };
+
+        float m_cellSize = 64.0f;
+        Vector2 m_bounds{ 0, 0 };
+        size_t m_columns = 0;
+        size_t m_rows = 0;
+        bool m_rebuild = true;
+        size_t m_hierarchyVersion = 0;
+        size_t m_generation = 0;
+
+        std::vector<Entry> m_entries;
+        // entry indices per cell, sorted ascending
+        std::vector<std::vector<size_t>> m_cells;
+
+        void Rebuild(ElementBase& root);
+        void AddEntries(const std::shared_ptr<ElementBase>& element, size_t parent);
+        /*
+        * @brief Calculates the clipped rect of the entry from its element and its parent entry
+        * @return true if the rect changed
+        */
+        bool CalculateRect(size_t index);
+        void FillCells();
+        void InsertIntoCells(size_t index, const Rect& rect);
+        void RemoveFromCells(size_t index, const Rect& rect);
+        /*
+        * @brief Gets the cells the rect overlaps
+        * @return false if the rect is empty or outside of the grid
+        */
+        bool GetCellRange(const Rect& rect, size_t& outMinX, size_t& outMinY, size_t& outMaxX, size_t& outMaxY) const;
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <CoreLib/Math/Vector2.h>
+#include <CoreLib/Math/Matrix4x4.h>
+
+#include "EngineLib/EngineTypes.h"
+#include "EngineLib/RenderDevice.h"
+#include "EngineLib/ShaderBindObject.h"
+
+namespace EngineCore {
+    class Renderer;
+}
+
+namespace EngineCore::UI {
+
+    /*
+    * @brief Texture a cached element and its children are drawn into (Element::SetCached), owned by the UIManager.
+    *
+    * Elements of the layer report the screen areas they change. Only the union of these areas is cleared
+    * and drawn again (scissor), with the elements that overlap it. Every frame the texture is drawn onto
+    * the screen with one quad. The texture has the size of the window, so layer pixels map 1:1 to the screen.
+    */
+    class LayerCache {
+    public:
+        struct Rect {
+            float minX = 0.0f;
+            float minY = 0.0f;
+            float maxX = 0.0f;
+            float maxY = 0.0f;
+
+            bool IsEmpty() const;
+            bool Overlaps(const Rect& other) const;
+            /*
+            * @brief Grows the rect to contain the other one, empty rects are ignored
+            */
+            void Merge(const Rect& other);
+            /*
+            * @brief Screen bounds of the unit plane transformed by a UI model matrix
+            */
+            static Rect FromModel(const Matrix4x4& model);
+        };
+
+        LayerCache();
+        ~LayerCache();
+
+        LayerCache(const LayerCache&) = delete;
+        LayerCache& operator=(const LayerCache&) = delete;
+
+        /*
+        * @brief Creates the texture, recreates it if the window size changed (everything gets redrawn)
+        * @return false if there is no texture, the elements are drawn directly then
+        */
+        bool Prepare(const Vector2& windowSize);
+        /*
+        * @brief Deletes the texture, the next Prepare creates it again
+        */
+        void Release();
+
+        void AddDirtyRect(const Rect& rect);
+        /*
+        * @brief Redraws the whole layer with the next frame
+        */
+        void Invalidate();
+        bool IsDirty() const;
+
+        /*
+        * @brief The UI commands submitted until EndRedraw go into the texture, clipped to the dirty area
+        */
+        void BeginRedraw(Renderer* renderer);
+        /*
+        * @return true if an element with these bounds has to be submitted by the current redraw
+        */
+        bool NeedsRedraw(const Rect& rect) const;
+        /*
+        * @brief Adds the bounds of a submitted element to the area that gets composited
+        */
+        void AddDrawnRect(const Rect& rect);
+        void EndRedraw(Renderer* renderer);
+
+        /*
+        * @brief Submits the quad that draws the texture onto the screen
+        */
+        void SendCompositeCommand(Renderer* renderer, RenderLayerID renderLayerID);
+
+        /*
+        * @brief Number of existing layers, elements only look for their layer if there is one
+        */
+        static size_t GetLayerCount();
+
+    private:
+        static inline size_t s_layerCount = 0;
+
+        Texture2DID m_texture = Texture2DID(ENGINE_INVALID_ID);
+        GpuHandle m_framebuffer = 0;
+        int m_width = 0;
+        int m_height = 0;
+
+        Rect m_dirtyRect;   // area that gets cleared and drawn again
+        Rect m_redrawRect;  // dirty area of the running redraw in whole pixels
+        Rect m_contentRect; // everything drawn since the last full redraw, the composited area
+
+        Matrix4x4 m_compositeTransform;
+        ShaderBindObject m_sbo; // binds the texture
+        RenderCommand m_cmd;
+    };
+
+}
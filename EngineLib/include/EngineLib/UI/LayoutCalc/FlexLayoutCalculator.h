@@ -4,6 +4,12 @@
 
 namespace EngineCore::UI {
 
+    /*
+    * @brief Two pass flex layout. The first child of a container that is sized measures the whole
+    * container once (sums and stretch counts), the first child that is positioned arranges all
+    * children in one walk. Both results are cached in the container until it is marked dirty,
+    * so a container with n children costs O(n) instead of O(n^2)
+    */
     class FlexLayoutCalculator : public ILayoutCalculator {
     public:
         FlexLayoutCalculator() = default;
@@ -13,6 +19,22 @@ namespace EngineCore::UI {
         Vector2 CalculateSize(ElementBase* element) override;
 
     private:
+        /*
+        * @brief Sums the desired sizes and counts the stretched children of the container
+        */
+        void Measure(ElementBase* container, LayoutCache& cache);
+        /*
+        * @brief Positions all children of the container, uses the layout sizes of the size pass
+        */
+        void Arrange(ElementBase* container, LayoutCache& cache);
+        /*
+        * @brief Position of one child
+        * @param siblingsLayoutSize summed layout size of all other children
+        * @param previousPosition position of the previous child
+        * @param previousMarginSize margin size of the previous child
+        */
+        Vector2 ArrangeChild(ElementBase* parent, ElementBase* element, size_t listPosition,
+            const Vector2& siblingsLayoutSize, const Vector2& previousPosition, const Vector2& previousMarginSize);
 
         enum class Axis { X, Y };
 
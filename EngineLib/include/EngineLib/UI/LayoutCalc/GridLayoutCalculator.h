@@ -3,6 +3,11 @@
 
 namespace EngineCore::UI {
 
+    /*
+    * @brief Places the children in equally sized cells, row by row. A cell is as big as the biggest child,
+    * the column count fits the content width of the container unless the container sets one (ElementBase::GetGridColumnCount).
+    * Containers that recycle their children (VirtualList) map them to other cells with ElementBase::GetGridCellIndex
+    */
     class GridLayoutCalculator : public ILayoutCalculator {
     public:
         GridLayoutCalculator() = default;
@@ -10,6 +15,17 @@ namespace EngineCore::UI {
 
         Vector2 CalculatePosition(ElementBase* element) override;
         Vector2 CalculateSize(ElementBase* element) override;
+
+        /*
+        * @brief Columns that fit into the width, at least one
+        */
+        static size_t CalculateColumnCount(float contentWidth, float cellWidth);
+
+    private:
+        /*
+        * @brief Calculates the cell size and column count and positions all children of the container
+        */
+        void Arrange(ElementBase* container, LayoutCache& cache);
     };
 
 }
\ No newline at end of file
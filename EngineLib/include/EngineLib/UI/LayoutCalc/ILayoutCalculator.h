@@ -1,10 +1,36 @@
 #pragma once
 #include <memory>
+#include <vector>
 #include <CoreLib/Math/Vector2.h>
 
 namespace EngineCore::UI {
     class ElementBase;
 
+    /*
+    * @brief Results a layout calculator computed for the children of one container.
+    * Stays valid until the container or one of its children is marked dirty
+    */
+    struct LayoutCache {
+        bool measured = false;
+        bool arranged = false;
+
+        // measure pass
+        Vector2 childrenDesiredPixelSize;   // sum of desired pixel + border + margin of all children
+        size_t stretchCount = 0;            // children that stretch along the major axis
+        size_t avaibleStretchCount = 0;     // children with unit %a along the major axis
+
+        // arrange pass
+        Vector2 childrenLayoutSize;         // sum of layout + border + margin of all children
+        std::vector<Vector2> childPositions;
+        Vector2 gridCellSize;               // grid: biggest margin size of the children
+        size_t gridColumns = 0;             // grid: columns the children are placed in
+
+        inline void Invalidate() {
+            measured = false;
+            arranged = false;
+        }
+    };
+
     class ILayoutCalculator {
     public:
         ILayoutCalculator() = default;
@@ -1,5 +1,6 @@
 #pragma once
 #include <unordered_map>
+#include <map>
 #include <vector>
 #include <memory>
 #include <string>
@@ -12,11 +13,45 @@
 
 namespace EngineCore::UI {
 
-	class Style {
+	/**
+	* @brief Parsed attribute values of one style state, indexed by the attribute id.
+	*
+	* Styles parse their values when they are set, applying a compiled style to an element
+	* only walks the attributes that are set and hands over the typed values.
+	* Values are immutable and shared, merging styles does not copy them.
+	*/
+	class CompiledStyle {
 	public:
-		using StyleDirtyCallback = std::function<void()>;
-		using SubscriberID = size_t;
+		/**
+		* @brief Sets the value of an attribute, a value that was set before is replaced
+		*/
+		void Set(size_t attributeID, const StyleValue& value);
+		void Remove(size_t attributeID);
+		/**
+		* @brief Takes over all values of the other style, its values replace the values of this style
+		*/
+		void Merge(const CompiledStyle& other);
+		void Clear();
 
+		bool Has(size_t attributeID) const;
+		/**
+		* @brief Gets the value of an attribute, only valid if Has returns true
+		*/
+		const StyleValue& Get(size_t attributeID) const;
+		/**
+		* @brief Returns the ids of all attributes that are set, in the order they were set first
+		*/
+		const std::vector<size_t>& GetSetIDs() const;
+
+	private:
+		void SetShared(size_t attributeID, const std::shared_ptr<const StyleValue>& value);
+
+		std::vector<std::shared_ptr<const StyleValue>> m_values;// by attribute id, nullptr if not set
+		std::vector<size_t> m_setIDs;
+	};
+
+	class Style {
+	public:
 		Style() = default;
 		Style(const std::string& name);
 
@@ -35,6 +70,17 @@ namespace EngineCore::UI {
 		*/
 		static std::shared_ptr<Style> Create(const std::string& name, std::shared_ptr<Style> style);
 
+		/**
+		* @brief Gets the style that merges base and style (base first), all callers with the same two styles share it.
+		*
+		* The merged style is only changed through the styles it extends, so sharing it is safe.
+		* It is kept alive by its users, the next call after the last user released it creates a new one.
+		* @param base The style that is applied first
+		* @param style The style that is applied on top of base, can be nullptr
+		* @return A shared pointer to the merged style
+		*/
+		static std::shared_ptr<Style> GetMerged(std::shared_ptr<Style> base, std::shared_ptr<Style> style);
+
 		/**
 		* @brief Extends the current style by adding another style to its list of extended styles
 		* @param style A shared pointer to the Style object to extend from
@@ -126,31 +172,52 @@ namespace EngineCore::UI {
 
 		const std::vector<std::shared_ptr<Style>> GetAllExtendedStyles() const;
 
+		/**
+		* @brief Retrieves the parsed attributes of a state, including extended styles
+		* @param state The state for which to retrieve the attributes, attributes of the normal state that the state does not set are included
+		* @return A constant reference to the parsed attributes, stays valid until the style changes
+		*/
+		const CompiledStyle& GetCompiled(State state) const;
+
 		std::string ToString() const;
 
-		SubscriberID SubDirtCallback(StyleDirtyCallback callback);
-		void UnsubDirtyCallback(SubscriberID id);
+		/**
+		* @brief Returns the generation of the style, it changes when this style or a style it extends changes.
+		*
+		* Changing a style only bumps its own generation, users compare the generation with the one they
+		* saw last (once per frame) instead of being called back on every change.
+		*/
+		size_t GetGeneration() const;
 
 	private:
-		template<typename T>
-		class Subscriber {
-		public:
-			SubscriberID id;
-			T callback;
-		};
         std::string m_name = "UNKNOWN";
 		mutable std::unordered_map<State, std::unordered_map<std::string, std::string>> m_attributes;// state, attName, attValue
+		// m_attributes parsed on Set, composites are split into their attributes
+		std::unordered_map<State, CompiledStyle> m_compiledAttributes;
+		// merged compiled attributes of the cached style, every state includes the normal state
+		mutable std::unordered_map<State, CompiledStyle> m_resolvedAttributes;
 		std::vector<std::shared_ptr<Style>> m_extendedStyles;
-		mutable bool m_styleDirty = true;
 		mutable std::unique_ptr<Style> m_cachedStyle;
 
-		SubscriberID m_dirtyCallbackID = 0;
-		SubscriberID m_dirtyCallbackIDInter = 0;
-		std::vector<Subscriber<StyleDirtyCallback>> m_dirtyCallback;
-		// inter dirty callback to updates all styles befor other elements
-		std::vector<Subscriber<StyleDirtyCallback>> m_dirtyCallbackInter;
+		size_t m_generation = 0;							// s_generationCounter at the last change of this style
+		mutable size_t m_chainGeneration = 0;				// newest generation of this style and its extended styles
+		mutable size_t m_chainCheckedAt = SIZE_MAX;			// s_generationCounter when m_chainGeneration was computed
+		mutable size_t m_cachedGeneration = SIZE_MAX;		// chain generation m_cachedStyle was generated from
+
+		// bumped by every change of any style
+		static inline size_t s_generationCounter = 0;
 
 		void SetStyleDirty();
+		bool IsCacheOutdated() const;
+		/**
+		* @brief Parses the attribute again after it was set or removed, a composite updates all its attributes
+		*/
+		void CompileAttribute(State state, const std::string& name);
+		/**
+		* @brief Parses a single attribute from the attributes of the state.
+		* An attribute that is set directly wins over a composite that also sets it
+		*/
+		void CompileSingleAttribute(State state, const StyleAttribute& attribute);
 		/**
 		* @brief Generates a cached style by combining all extended styles and this style's attributes
 		*
@@ -159,8 +226,11 @@ namespace EngineCore::UI {
 		*/
 		void GenerateCachedStyle() const;
 
-		SubscriberID SubDirtCallbackInter(StyleDirtyCallback callback);
-		void CallDirty();
+
+		// merged styles by (base, style), see GetMerged
+		static inline std::map<std::pair<const Style*, const Style*>, std::weak_ptr<Style>> s_mergedStyles;
+		// s_mergedStyles size after the last removal of expired entries
+		static inline size_t s_mergedStylesCleanSize = 0;
 	};
 
 }
\ No newline at end of file
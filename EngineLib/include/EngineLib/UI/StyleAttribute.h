@@ -21,6 +21,9 @@ namespace EngineCore::UI {
 	*/
 	class StyleAttribute {
 	public:
+		// id of attributes that are not registered
+		static constexpr size_t INVALID_ID = SIZE_MAX;
+
 		/**
 		* @brief Default constructor initializes the attribute as undefined.
 		*/
@@ -57,6 +60,11 @@ namespace EngineCore::UI {
 		*/
 		const std::string& GetName() const;
 		/**
+		* @brief Returns the dense id the attribute got on registration, used to index compiled styles.
+		* @return INVALID_ID if the attribute is not registered.
+		*/
+		size_t GetID() const;
+		/**
 		* @brief Returns the description text of the attribute.
 		*/
 		const std::string& GetDesc() const;
@@ -93,6 +101,7 @@ namespace EngineCore::UI {
 
 		bool m_isComposite = false;
 		std::vector<std::string> m_mappedAttributes;
+		size_t m_id = INVALID_ID;
 
 	public:
 		/**
@@ -116,6 +125,20 @@ namespace EngineCore::UI {
 		*/
 		static const StyleAttribute& GetAttribute(const std::string& name);
 		/**
+		* @brief Finds a registered attribute by name without logging.
+		* @return nullptr if the attribute does not exist.
+		*/
+		static const StyleAttribute* FindAttribute(const std::string& name);
+		/**
+		* @brief Returns a registered attribute by its id.
+		* Logs an error and returns a dummy attribute if it does not exist.
+		*/
+		static const StyleAttribute& GetAttribute(size_t id);
+		/**
+		* @brief Returns the number of registered attributes, all ids are smaller than it.
+		*/
+		static size_t GetAttributeCount();
+		/**
 		* @brief Attempts to find a registered attribute by name.
 		* @param name Attribute name.
 		* @param outValue Output reference to the found attribute.
@@ -154,12 +177,19 @@ namespace EngineCore::UI {
 			composite.m_isComposite = true;
 			composite.m_mappedAttributes = { args... };
 
-			m_registeredStyleAttributes[composite.GetName()] = composite;
+			AddToRegistry(composite);
 		}
 
 	private:
 		// Global registry of all known StyleAttributes.
 		static inline std::unordered_map<std::string, StyleAttribute> m_registeredStyleAttributes;
+		// Registered attributes by id, points into m_registeredStyleAttributes
+		static inline std::vector<const StyleAttribute*> m_attributesByID;
+
+		/**
+		* @brief Stores the attribute in the registry, an attribute that replaces another one keeps its id.
+		*/
+		static void AddToRegistry(const StyleAttribute& attribute);
 	};
 
 }
\ No newline at end of file
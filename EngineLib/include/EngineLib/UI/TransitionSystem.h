@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <CoreLib/Math/Vector4.h>
+
+#include "EngineLib/UI/UITypes.h"
+
+namespace EngineCore::UI {
+
+    class ElementBase;
+
+    /*
+    * @brief Running style transitions of all elements, owned by the UIManager.
+    *
+    * A transition moves one property of one element from its current value to the value of the new style.
+    * The transitions are stored as flat arrays (one entry per transition and channel), so advancing all of
+    * them is a few branch free loops the compiler can vectorize. Only the elements with a running transition
+    * get their values set and are marked dirty. Finished transitions are removed.
+    */
+    class TransitionSystem {
+    public:
+        /*
+        * @brief Starts a transition, a running transition of the same property continues from its current value.
+        * Nothing starts if the property already has the target value or is already moving towards it
+        * @param unit unit of the value, only used by the width and height
+        */
+        void Start(ElementBase* element, TransitionProperty property, const Vector4& from, const Vector4& to,
+            float duration, Easing easing, StyleUnit::Unit unit);
+        /*
+        * @brief Stops the transition of one property, the value stays where it is
+        */
+        void Stop(const ElementBase* element, TransitionProperty property);
+        /*
+        * @brief Stops all transitions of an element, has to be called before the element is deleted
+        */
+        void Remove(const ElementBase* element);
+        void Clear();
+
+        /*
+        * @brief Moves every transition forward and sets the new values on the elements
+        */
+        void Advance(float deltaTime);
+
+        bool IsRunning(const ElementBase* element, TransitionProperty property) const;
+        size_t GetCount() const;
+
+    private:
+        std::vector<ElementBase*> m_elements;
+        std::vector<TransitionProperty> m_properties;
+        std::vector<StyleUnit::Unit> m_units;
+        std::vector<float> m_elapsed;
+        std::vector<float> m_invDuration;
+        // easing curve as a cubic: ((a * t + b) * t + c) * t
+        std::vector<float> m_easeA;
+        std::vector<float> m_easeB;
+        std::vector<float> m_easeC;
+        std::vector<float> m_progress;// eased progress of the current Advance
+        // per channel (x, y, z, w), single value properties only use x
+        std::array<std::vector<float>, 4> m_from;
+        std::array<std::vector<float>, 4> m_to;
+        std::array<std::vector<float>, 4> m_value;
+        // element id and property to the index of the transition
+        std::unordered_map<uint64_t, size_t> m_lookup;
+
+        static uint64_t GetKey(const ElementBase* element, TransitionProperty property);
+        /*
+        * @brief Removes a transition by moving the last one into its place
+        */
+        void RemoveAt(size_t index);
+    };
+
+}
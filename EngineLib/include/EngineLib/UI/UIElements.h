@@ -1,4 +1,5 @@
 #pragma once
 
 #include "Elements/Element.h"
-#include "Elements/Panel.h"
\ No newline at end of file
+#include "Elements/Panel.h"
+#include "Elements/VirtualList.h"
\ No newline at end of file
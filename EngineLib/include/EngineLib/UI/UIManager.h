@@ -9,6 +9,8 @@
 
 #include "AttributeNames.h"
 #include "UIElements.h"
+#include "HitGrid.h"
+#include "TransitionSystem.h"
 #include "../IDManager.h"
 #include "../EngineTypes.h"
 
@@ -16,12 +18,28 @@ namespace EngineCore {
 
 	class Engine;
 	class Renderer;
+	namespace UI {
+		class VirtualList;
+		class ElementBase;
+	}
+
 	class UIManager {
 		friend class Engine;
 		friend class Renderer;
+		// creates and deletes its item elements
+		friend class UI::VirtualList;
+		// starts the transitions of its style values
+		friend class UI::ElementBase;
 	public:
 		static void Init();
 		static void Shutdown();
+		/*
+		* @brief Runs one UI frame: input, element states, transitions, layout and styles.
+		* The engine calls it every frame, headless tools can drive the UI with it without a window
+		* @param width, height size of the window in pixels
+		* @param deltaTime seconds the style transitions advance
+		*/
+		static void Update(int width, int height, float deltaTime);
 
 		UIManager(const UIManager&) = delete;
 		UIManager& operator=(const UIManager&) = delete;
@@ -136,9 +154,22 @@ namespace EngineCore {
 
 		static inline std::shared_ptr<UI::ElementBase> m_rootElement;
 		static inline std::vector<std::shared_ptr<UI::ElementBase>> m_roots;
+		static inline std::vector<std::weak_ptr<UI::ElementBase>> m_elementsByID;// indexed by UIElementID::value, the ids are small and get reused
 		static inline std::stack<std::shared_ptr<UI::ElementBase>> m_elementStack;// is used for creating ui hierarchy
 		// the element what stat was last modified
 		static inline std::shared_ptr<UI::ElementBase> m_lastChangeElement;
+		// screen rects of all elements for hover tests
+		static inline UI::HitGrid m_hitGrid;
+		// elements that got a new position in the current layout pass
+		static inline std::vector<UI::ElementBase*> m_movedElements;
+		// textures of the cached elements, released with Shutdown while the device still exists
+		static inline std::vector<std::unique_ptr<UI::LayerCache>> m_layers;
+		// running style transitions of all elements
+		static inline UI::TransitionSystem m_transitions;
+		// result of the last hover test, reused while the mouse and the hit grid stay the same
+		static inline std::shared_ptr<UI::ElementBase> m_hoverElement;
+		static inline Vector2 m_hoverMousePos{ -1, -1 };
+		static inline size_t m_hoverGeneration = SIZE_MAX;
 		// map containg all elemetns that have a force state
 		static inline std::unordered_map<UIElementID, UI::State> m_forceStateMap;
 
@@ -160,10 +191,14 @@ namespace EngineCore {
 		
 		static void BeginRootElement();
 		static void EndRootElement();
+		/*
+		* @brief Gets a new element id and counts the element
+		* @return ENGINE_INVALID_ID if no free id is left
+		*/
+		static UIElementID CreateElementID();
 		
 		static void WindowResize(int width, int height);
 
-		static void Update(int width, int height);
 		static void UpdateInput();
 		static void UpdateElementState();
 		
@@ -177,6 +212,16 @@ namespace EngineCore {
 		// Sends the Draw Commands of the UI::Elements
 		static void SendDrawCommands();
 		static void SendChildDrawCommands(std::shared_ptr<UI::ElementBase> element);
+		/*
+		* @brief Redraws the dirty part of the layer of a cached element and submits the layer quad
+		* @return false if the element has no usable layer and has to be drawn directly
+		*/
+		static bool SendLayerDrawCommands(const std::shared_ptr<UI::ElementBase>& element);
+		/*
+		* @brief Submits the element and its children that overlap the area the layer redraws
+		*/
+		static void SendLayerElementDrawCommands(const std::shared_ptr<UI::ElementBase>& element, UI::LayerCache& layer);
+		static void DeleteLayerInternal(UI::ElementBase* element);
 		static float CalculateUIScaleFactor(int width, int height);
 		static void CalculateOrthograpicMatrix(int width, int height);
 		/**
@@ -185,20 +230,23 @@ namespace EngineCore {
 		*/
 		static void FreeIDsInternal(std::shared_ptr<UI::ElementBase> element);
 		/**
-		* @brief Searches for a UI element in a given list and its children recursively.
-		* @param list The list of elements to search in.
-		* @param elementID The unique identifier of the element to search for.
-		* @return Shared pointer to the element if found, nullptr otherwise.
+		* @brief Adds a newly created element to the id index used by GetElement.
+		* @param element The element to register, its id must be valid.
 		*/
-		static std::shared_ptr<UI::ElementBase> SearchElementInternal(std::vector<std::shared_ptr<UI::ElementBase>>& list, UIElementID elementID);
+		static void RegisterElementInternal(const std::shared_ptr<UI::ElementBase>& element);
+		/**
+		* @brief Removes an element from a child or root list, using its stored list position.
+		* The elements after it move up by one and get their list position updated.
+		* @param list The list that contains the element.
+		* @param element The element to remove.
+		*/
+		static void EraseFromListInternal(std::vector<std::shared_ptr<UI::ElementBase>>& list, const std::shared_ptr<UI::ElementBase>& element);
 		
 		/*
 		* @brief trys to get the current element that is hovered
 		*/
 		static bool TryGetHoverElement(std::shared_ptr<UI::ElementBase>& outElement);
 
-		static void GetHoverElementInternal(std::shared_ptr<UI::ElementBase>& outElement);
-
 		/**
 		* @brief Recursively builds a string representation of a UI element and its children.
 		* @param elementPtr Pointer to the element to process.
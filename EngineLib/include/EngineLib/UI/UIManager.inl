@@ -18,7 +18,9 @@ namespace EngineCore {
         if (m_elementStack.empty()) {
             // Add root element
             std::shared_ptr<UI::ElementBase> element = m_roots.emplace_back(std::make_shared<T>(id, std::forward<Args>(args)...));
+            element->m_listPosition = m_roots.size() - 1;
             element->Init();
+            RegisterElementInternal(element);
             m_elementStack.push(element);
 #ifndef NDEBUG
             if (m_isDebug)
@@ -30,6 +32,7 @@ namespace EngineCore {
             // Add child element
             auto& parent = m_elementStack.top();
             std::shared_ptr<UI::ElementBase> element = parent->AddChild<T>(id, std::forward<Args>(args)...);
+            RegisterElementInternal(element);
             m_elementStack.push(element);
 #ifndef NDEBUG
             if (m_isDebug)
@@ -56,6 +59,7 @@ namespace EngineCore {
 
         auto& parent = m_elementStack.top();
         std::shared_ptr<UI::ElementBase> element = parent->AddChild<T>(id, std::forward<Args>(args)...);
+        RegisterElementInternal(element);
 #ifndef NDEBUG
         if (m_isDebug)
             Log::Debug("UIManager: Added element {}({})", element->GetName(), id.value);
@@ -30,10 +30,44 @@ namespace EngineCore::UI {
         None,
         // like flex CSS
         Flex,
-        // like grid CSS (Not implemented)
+        // equally sized cells, row by row
         Grid
     };
 
+    /**
+    * @brief Curve of a style transition (similar to CSS transition-timing-function).
+    */
+    enum class Easing {
+        Linear,
+        EaseIn,
+        EaseOut,
+        EaseInOut
+    };
+
+    /**
+    * @brief Numeric element values that change smoothly between styles (see Attribute::duration).
+    */
+    enum class TransitionProperty {
+        BackgroundColor,
+        BorderColor,
+        BorderRadius,
+        BorderTop,
+        BorderRight,
+        BorderBottom,
+        BorderLeft,
+        MarginTop,
+        MarginRight,
+        MarginBottom,
+        MarginLeft,
+        PaddingTop,
+        PaddingRight,
+        PaddingBottom,
+        PaddingLeft,
+        Width,
+        Height,
+        Count
+    };
+
     /**
     * @brief Converts a UI::State enum value into a human-readable string.
     * @param s The UI state to convert.
@@ -50,6 +84,15 @@ namespace EngineCore::UI {
 
     std::string ToString(LayoutType layoutType);
 
+    /**
+    * @brief Converts a string into a corresponding Easing enum value.
+    * @param easingStr Input string (e.g., "linear", "ease-in", "ease-out", "ease-in-out").
+    * @return Corresponding Easing enum, defaults to EaseInOut if invalid.
+    */
+    Easing ToEasing(const std::string& easingStr);
+
+    std::string ToString(Easing easing);
+
     namespace Flex {
 
         /**
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include "EngineLib\Application.h"
 
 #include "EngineLib\Shader.h"
+#include "EngineLib\Profiler.h"
 #include "CoreLib\Log.h"
 #include "CoreLib\Math.h"
 
@@ -19,6 +21,8 @@ void Application::Shutdown() {}
 void Application::OnWindowResize(int newWidth, int newHeight) {}
 void Application::OnWindowFocusLost() {}
 void Application::OnWindowFocusGain() {}
+void Application::OnFrameBudgetExceeded(double frameTimeMs) {}
+void Application::OnOffscreenFrame(uint64_t frameIndex, int width, int height, const std::vector<unsigned char>& pixels) {}
 
 #pragma region get_funcs
 
@@ -136,6 +140,81 @@ bool Application::App_Debug_Get_IsDebugCameraActive() const {
     return m_appDebugIsDebugCameraActive;
 }
 
+// Profiler
+bool Application::App_Profiler_Get_Capture() const {
+    return m_appProfilerCapture;
+}
+
+EngineCore::KeyCode Application::App_Profiler_Get_CaptureKey() const {
+    return m_appProfilerCaptureKey;
+}
+
+std::string Application::App_Profiler_Get_CapturePath() const {
+    return m_appProfilerCapturePath;
+}
+
+float Application::App_Profiler_Get_FrameBudget() const {
+    return m_appProfilerFrameBudget;
+}
+
+// Benchmark
+bool Application::App_Benchmark_Get_Enabled() const {
+    return m_appBenchmarkEnabled;
+}
+
+double Application::App_Benchmark_Get_FixedDeltaTime() const {
+    return m_appBenchmarkFixedDeltaTime;
+}
+
+uint64_t Application::App_Benchmark_Get_FrameLimit() const {
+    return m_appBenchmarkFrameLimit;
+}
+
+double Application::App_Benchmark_Get_DurationLimit() const {
+    return m_appBenchmarkDurationLimit;
+}
+
+std::string Application::App_Benchmark_Get_OutputPath() const {
+    return m_appBenchmarkOutputPath;
+}
+
+uint64_t Application::App_Benchmark_Get_WarmupFrames() const {
+    return m_appBenchmarkWarmupFrames;
+}
+
+std::string Application::App_Benchmark_Get_Baseline() const {
+    return m_appBenchmarkBaseline;
+}
+
+double Application::App_Benchmark_Get_Threshold() const {
+    return m_appBenchmarkThreshold;
+}
+
+bool Application::App_Benchmark_Get_UpdateBaseline() const {
+    return m_appBenchmarkUpdateBaseline;
+}
+
+// Offscreen
+bool Application::App_Offscreen_Get_Enabled() const {
+    return m_appOffscreenEnabled;
+}
+
+Application::ContextAPI Application::App_Offscreen_Get_ContextAPI() const {
+    return m_appOffscreenContextAPI;
+}
+
+size_t Application::App_Offscreen_Get_ReadbackBufferCount() const {
+    return m_appOffscreenReadbackBufferCount;
+}
+
+std::string Application::App_Offscreen_Get_DumpPath() const {
+    return m_appOffscreenDumpPath;
+}
+
+uint64_t Application::App_Offscreen_Get_DumpInterval() const {
+    return m_appOffscreenDumpInterval;
+}
+
 #pragma endregion
 
 #pragma region set_funcs
@@ -286,6 +365,95 @@ void Application::App_Debug_Set_DebugKey(EngineCore::KeyCode key) {
     m_appDebugKey = key;
 }
 
+//Profiler
+void Application::App_Profiler_Set_Capture(bool value) {
+    if (value && !EngineCore::Profiler::IsCapturing())
+        EngineCore::Profiler::StartCapture();
+    else if (!value)
+        EngineCore::Profiler::StopCapture();
+
+    m_appProfilerCapture = value;
+}
+
+void Application::App_Profiler_Set_CaptureKey(EngineCore::KeyCode key) {
+    m_appProfilerCaptureKey = key;
+}
+
+void Application::App_Profiler_Set_CapturePath(const std::string& path) {
+    m_appProfilerCapturePath = path;
+}
+
+void Application::App_Profiler_Set_FrameBudget(float milliseconds) {
+    m_appProfilerFrameBudget = std::max(milliseconds, 0.0f);
+    EngineCore::Profiler::SetFrameBudget(static_cast<double>(m_appProfilerFrameBudget) / 1000.0);
+}
+
+// Benchmark
+void Application::App_Benchmark_Set_Enabled(bool value) {
+    m_appBenchmarkEnabled = value;
+}
+
+void Application::App_Benchmark_Set_FixedDeltaTime(double seconds) {
+    if (seconds <= 0.0) {
+        Log::Warn("Application: Benchmark delta time has to be greater than 0, was {}", seconds);
+        return;
+    }
+    m_appBenchmarkFixedDeltaTime = seconds;
+}
+
+void Application::App_Benchmark_Set_FrameLimit(uint64_t frames) {
+    m_appBenchmarkFrameLimit = frames;
+}
+
+void Application::App_Benchmark_Set_DurationLimit(double seconds) {
+    m_appBenchmarkDurationLimit = std::max(seconds, 0.0);
+}
+
+void Application::App_Benchmark_Set_Clock(std::function<double()> clock) {
+    m_appBenchmarkClock = std::move(clock);
+}
+
+void Application::App_Benchmark_Set_OutputPath(const std::string& path) {
+    m_appBenchmarkOutputPath = path;
+}
+
+void Application::App_Benchmark_Set_WarmupFrames(uint64_t frames) {
+    m_appBenchmarkWarmupFrames = frames;
+}
+
+void Application::App_Benchmark_Set_Baseline(const std::string& path) {
+    m_appBenchmarkBaseline = path;
+}
+
+void Application::App_Benchmark_Set_Threshold(double threshold) {
+    m_appBenchmarkThreshold = std::max(threshold, 0.0);
+}
+
+void Application::App_Benchmark_Set_UpdateBaseline(bool value) {
+    m_appBenchmarkUpdateBaseline = value;
+}
+
+// Offscreen
+void Application::App_Offscreen_Set_Enabled(bool value) {
+    m_appOffscreenEnabled = value;
+}
+
+void Application::App_Offscreen_Set_ContextAPI(ContextAPI api) {
+    m_appOffscreenContextAPI = api;
+}
+
+void Application::App_Offscreen_Set_ReadbackBufferCount(size_t count) {
+    m_appOffscreenReadbackBufferCount = std::max<size_t>(count, 1);
+}
+
+void Application::App_Offscreen_Set_DumpPath(const std::string& path) {
+    m_appOffscreenDumpPath = path;
+}
+
+void Application::App_Offscreen_Set_DumpInterval(uint64_t frames) {
+    m_appOffscreenDumpInterval = std::max<uint64_t>(frames, 1);
+}
+
 #pragma endregion
 
 #pragma region other_funcs
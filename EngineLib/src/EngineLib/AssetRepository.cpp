@@ -16,9 +16,11 @@ EngineCore::MeshID g_engineMeshUIPlainID = EngineCore::MeshID(EngineCore::ENGINE
 EngineCore::ShaderID g_engineShaderDefaultID = EngineCore::ShaderID(EngineCore::ENGINE_INVALID_ID);
 EngineCore::ShaderID g_engineShaderDefaultTextID = EngineCore::ShaderID(EngineCore::ENGINE_INVALID_ID);
 EngineCore::ShaderID g_engineShaderDefaultUIID = EngineCore::ShaderID(EngineCore::ENGINE_INVALID_ID);
+EngineCore::ShaderID g_engineShaderDefaultUILayerID = EngineCore::ShaderID(EngineCore::ENGINE_INVALID_ID);
 EngineCore::MaterialID g_engineMaterialDefaultID = EngineCore::MaterialID(EngineCore::ENGINE_INVALID_ID);
 EngineCore::MaterialID g_engineMaterialDefaultTextID = EngineCore::MaterialID(EngineCore::ENGINE_INVALID_ID);
 EngineCore::MaterialID g_engineMaterialDefaultUIID = EngineCore::MaterialID(EngineCore::ENGINE_INVALID_ID);
+EngineCore::MaterialID g_engineMaterialDefaultUILayerID = EngineCore::MaterialID(EngineCore::ENGINE_INVALID_ID);
 EngineCore::FontID g_engineFontDefaultID = EngineCore::FontID(EngineCore::ENGINE_INVALID_ID);
 
 namespace EngineCore::ASSETS::ENGINE::TEXTURE {
@@ -36,12 +38,14 @@ namespace EngineCore::ASSETS::ENGINE::SHADER {
     ShaderID Default() { return g_engineShaderDefaultID; }
     ShaderID DefaultText() { return g_engineShaderDefaultTextID; }
     ShaderID DefaultUI() { return g_engineShaderDefaultUIID; }
+    ShaderID DefaultUILayer() { return g_engineShaderDefaultUILayerID; }
 }
 
 namespace EngineCore::ASSETS::ENGINE::MATERIAL {
     MaterialID Default() { return g_engineMaterialDefaultID; }
     MaterialID DefaultText() { return g_engineMaterialDefaultTextID; }
     MaterialID DefaultUI() { return g_engineMaterialDefaultUIID; }
+    MaterialID DefaultUILayer() { return g_engineMaterialDefaultUILayerID; }
 }
 
 namespace EngineCore::ASSETS::ENGINE::FONT {
@@ -182,30 +186,34 @@ namespace EngineCore {
                 layout(location = 1) in vec2 aTexCoord;
                 layout(location = 2) in vec3 aNormal;
                 layout(location = 3) in mat4 instanceModel;
+                layout(location = 7) in vec4 instanceColor;
+                layout(location = 8) in vec4 instanceUVRect;
                 
                 out vec2 TexCoord;
+                out vec4 MeshColor;
                 uniform mat4 view;
                 uniform mat4 projection;
                 
                 void main() {
                     gl_Position = projection * view * instanceModel * vec4(aPos, 1.0);
-                    TexCoord = aTexCoord;
+                    TexCoord = instanceUVRect.xy + aTexCoord * instanceUVRect.zw;
+                    MeshColor = instanceColor;
                 }
             )";
             std::string frag = R"(
                 #version 330 core
                 out vec4 FragColor;
                 in vec2 TexCoord;
+                in vec4 MeshColor;
 
                 uniform sampler2D utexture;
-                uniform vec4 umeshColor;
 
                 void main()
                 {
                     vec4 texColor = texture(utexture, TexCoord);
                     if(texColor.a < 0.1)
                         discard;
-                	FragColor = texColor * umeshColor;
+                	FragColor = texColor * MeshColor;
                 }
             )";
             g_engineShaderDefaultID = rm->AddShaderFromMemory(vert, frag);
@@ -257,14 +265,29 @@ namespace EngineCore {
                 layout(location = 0) in vec3 aPos;
                 layout(location = 1) in vec2 aTexCoord;
                 layout(location = 3) in mat4 instanceModel;
+                layout(location = 7) in vec4 instanceColor;     // background color
+                layout(location = 8) in vec4 instanceUVRect;    // border color
+                layout(location = 9) in vec4 instanceParams;    // border width
+                layout(location = 10) in vec4 instanceCustom;   // border radius
                 
                 out vec2 vTexCoord;
+                flat out vec4 vBackgroundColor;
+                flat out vec4 vBorderColor;
+                flat out vec4 vBorderWidth;
+                flat out vec4 vBorderRadius;
+                flat out vec2 vSize;
                 
                 uniform mat4 projection;
                 
                 void main() {
                     gl_Position = projection * instanceModel * vec4(aPos, 1.0);
                     vTexCoord = aTexCoord;
+                    vBackgroundColor = instanceColor;
+                    vBorderColor = instanceUVRect;
+                    vBorderWidth = instanceParams;
+                    vBorderRadius = instanceCustom;
+                    // the model scales the unit plane to the element size, rotation keeps the length
+                    vSize = vec2(length(instanceModel[0].xyz), length(instanceModel[1].xyz));
                 }
             )";
 
@@ -273,11 +296,11 @@ namespace EngineCore {
                 in vec2 vTexCoord;
                 out vec4 FragColor;
                 
-                uniform vec4 uBackgroundColor;
-                uniform vec4 uBorderColor;
-                uniform vec4 uBorderRadius;   // top-left, top-right, bottom-right, bottom-left (px)
-                uniform vec4 uBorderWidth;    // top, right, bottom, left (px)
-                uniform vec2 uSize;           // element size (px)
+                flat in vec4 vBackgroundColor;
+                flat in vec4 vBorderColor;
+                flat in vec4 vBorderRadius;   // top-left, top-right, bottom-right, bottom-left (px)
+                flat in vec4 vBorderWidth;    // top, right, bottom, left (px)
+                flat in vec2 vSize;           // element size (px)
                 uniform bool uFlipY;
                 
                 // Accurate AA smoothing
@@ -320,19 +343,19 @@ namespace EngineCore {
                 }
                 
                 void main() {
-                    vec2 coord = vec2(vTexCoord.x * uSize.x,
-                                      (uFlipY ? (1.0 - vTexCoord.y) : vTexCoord.y) * uSize.y);
+                    vec2 coord = vec2(vTexCoord.x * vSize.x,
+                                      (uFlipY ? (1.0 - vTexCoord.y) : vTexCoord.y) * vSize.y);
                 
                     // Outer and inner radius setup
-                    vec4 rOut = clamp(uBorderRadius, vec4(0.0), vec4(min(uSize.x, uSize.y) * 0.5));
+                    vec4 rOut = clamp(vBorderRadius, vec4(0.0), vec4(min(vSize.x, vSize.y) * 0.5));
 
                     // Are inverted
-                    float top    = uBorderWidth.z;
-                    float right  = uBorderWidth.y;
-                    float bottom = uBorderWidth.x;
-                    float left   = uBorderWidth.w;
+                    float top    = vBorderWidth.z;
+                    float right  = vBorderWidth.y;
+                    float bottom = vBorderWidth.x;
+                    float left   = vBorderWidth.w;
                 
-                    vec2 innerSize = vec2(uSize.x - (left + right), uSize.y - (top + bottom));
+                    vec2 innerSize = vec2(vSize.x - (left + right), vSize.y - (top + bottom));
                     innerSize = max(innerSize, vec2(0.0));
                 
                     vec4 rIn = vec4(
@@ -342,7 +365,7 @@ namespace EngineCore {
                         max(rOut.w - max(bottom, left), 0.0)
                     );
                 
-                    float sdOuter = sdRoundRectCSS(coord, uSize, rOut);
+                    float sdOuter = sdRoundRectCSS(coord, vSize, rOut);
                     float sdInner = sdRoundRectCSS(coord - vec2(left, bottom), innerSize, rIn);
                 
                     float outerMask = aaSmooth(sdOuter);
@@ -351,10 +374,10 @@ namespace EngineCore {
                     float fillMask = outerMask * innerMask;
                     float borderMask = outerMask * (1.0 - innerMask);
                 
-                    float borderA = borderMask * uBorderColor.a;
-                    float fillA   = fillMask * uBackgroundColor.a;
+                    float borderA = borderMask * vBorderColor.a;
+                    float fillA   = fillMask * vBackgroundColor.a;
                     float outA = borderA + fillA * (1.0 - borderA);
-                    vec3 outRGB = uBorderColor.rgb * borderA + uBackgroundColor.rgb * fillA * (1.0 - borderA);
+                    vec3 outRGB = vBorderColor.rgb * borderA + vBackgroundColor.rgb * fillA * (1.0 - borderA);
                 
                     FragColor = vec4(outRGB, outA);
                 }
@@ -363,6 +386,43 @@ namespace EngineCore {
         }
         #pragma endregion
 
+        #pragma region SHADER::DefaultUILayer
+        {
+            std::string vert = R"(
+                #version 330 core
+                layout(location = 0) in vec3 aPos;
+                layout(location = 1) in vec2 aTexCoord;
+                layout(location = 3) in mat4 instanceModel;
+                layout(location = 8) in vec4 instanceUVRect;
+                
+                out vec2 TexCoord;
+                uniform mat4 projection;
+                
+                void main() {
+                    gl_Position = projection * instanceModel * vec4(aPos, 1.0);
+                    TexCoord = instanceUVRect.xy + aTexCoord * instanceUVRect.zw;
+                }
+            )";
+            std::string frag = R"(
+                #version 330 core
+                out vec4 FragColor;
+                in vec2 TexCoord;
+
+                uniform sampler2D utexture;
+
+                void main()
+                {
+                    // the layer holds premultiplied colors, the blending multiplies with alpha again
+                    vec4 texColor = texture(utexture, TexCoord);
+                    if(texColor.a <= 0.0)
+                        discard;
+                    FragColor = vec4(texColor.rgb / texColor.a, texColor.a);
+                }
+            )";
+            g_engineShaderDefaultUILayerID = rm->AddShaderFromMemory(vert, frag);
+        }
+        #pragma endregion
+
         #pragma region MATERIAL::Default
         {
             g_engineMaterialDefaultID = rm->AddMaterial(g_engineShaderDefaultID);
@@ -383,6 +443,12 @@ namespace EngineCore {
         }
         #pragma endregion
 
+        #pragma region MATERIAL::DefaultUILayer
+        {
+            g_engineMaterialDefaultUILayerID = rm->AddMaterial(g_engineShaderDefaultUILayerID);
+        }
+        #pragma endregion
+
         #pragma region FONT::Default
         {
            g_engineFontDefaultID = rm->AddFontFromMemory(StaticFont::Nurom_Bold_ttf, StaticFont::Nurom_Bold_ttf_len);
@@ -102,7 +102,7 @@ namespace EngineCore {
 
 	bool ComponentBase::IsDead(const std::string& msg) const {
 		if (!m_alive) {
-			Log::Warn("{}: {}, Component was deleted!", m_name, msg);
+			Log::Limited::Warn("{}: {}, Component was deleted!", m_name, msg);
 			return true;
 		}
 		return false;
@@ -1,8 +1,8 @@
 #include <CoreLib/Log.h>
 #include <CoreLib/Math/Matrix4x4.h>
 
+#include "EngineLib/OffscreenTarget.h"
 #include "EngineLib/RenderLayerManager.h"
-#include "EngineLib/Time.h"
 #include "EngineLib/GameObject.h"
 #include "EngineLib/Components\Camera_C.h"
 
@@ -18,6 +18,7 @@ namespace EngineCore {
 			ComponentBase(compName, gameObjectID) {
 			m_gameObject = GetGameObject();
 			m_renderLayers.push_back(RenderLayerManager::GetLayerID("Default"));
+			m_renderLayerMask = RenderLayerManager::GetLayerMask(m_renderLayers);
 		}
 
 		void Camera::OnInspectorGUIImpl(IComponentUIRenderer& ui) {
@@ -67,6 +68,7 @@ namespace EngineCore {
 								m_renderLayers.erase(it);
 							}
 						}
+						m_renderLayerMask = RenderLayerManager::GetLayerMask(m_renderLayers);
 					}
 				}
 			}
@@ -118,33 +120,75 @@ namespace EngineCore {
 			return m_farPlane;
 		}
 
-		Matrix4x4 Camera::GetProjectionMatrix() {
+		const Matrix4x4& Camera::GetProjectionMatrix() {
 			if (IsDead("Cant get Projection-Matrix")) {
-				return Matrix4x4();
+				static const Matrix4x4 dummy;
+				return dummy;
 			}
-			float aspectRatio = CalculateAspectRatio();
+			UpdateProjectionMatrix();
+			return m_projection;
+		}
 
-			if (m_projectionChanged || (m_calculateAspectRatioWithWindow && m_lastAspectRatio != aspectRatio)) {
-				m_lastAspectRatio = aspectRatio;
-				CreateProjectionMatrix(aspectRatio);
-				m_projectionChanged = false;
+		const Matrix4x4& Camera::GetViewMatrix() {
+			if (IsDead("Cant get View-Matrix")) {
+				static const Matrix4x4 dummy;
+				return dummy;
 			}
+			UpdateViewMatrix();
+			return m_view;
+		}
 
-			return m_projection;
+		const Matrix4x4& Camera::GetViewProjectionMatrix() {
+			if (IsDead("Cant get View-Projection-Matrix")) {
+				static const Matrix4x4 dummy;
+				return dummy;
+			}
+			UpdateViewProjection();
+			return m_viewProjection;
 		}
 
+		const Frustum& Camera::GetFrustum() {
+			if (IsDead("Cant get Frustum")) {
+				static const Frustum dummy;
+				return dummy;
+			}
+			UpdateViewProjection();
+			return m_frustum;
+		}
 
-		Matrix4x4 Camera::GetViewMatrix() {
-			if (IsDead("Cant get View-Matrix")) {
-				return Matrix4x4();
+		int Camera::GetPriority() const {
+			if (IsDead("Cant get priority")) {
+				return 0;
 			}
-			static int lastFrame = -1;
-			if (lastFrame < Time::GetFrameCount()) {
-				CreateViewMatrix();
-				lastFrame = Time::GetFrameCount();
+			return m_priority;
+		}
+
+		bool Camera::IsAdditional() const {
+			if (IsDead("Cant get is additional")) {
+				return false;
+			}
+			return m_isAdditional;
+		}
+
+		Vector4 Camera::GetViewport() const {
+			if (IsDead("Cant get viewport")) {
+				return Vector4(0, 0, 1, 1);
 			}
+			return m_viewport;
+		}
 
-			return m_view;
+		OffscreenTarget* Camera::GetRenderTarget() const {
+			if (IsDead("Cant get render target")) {
+				return nullptr;
+			}
+			return m_renderTarget;
+		}
+
+		Vector4 Camera::GetBackgroundColor() const {
+			if (IsDead("Cant get background color")) {
+				return Vector4();
+			}
+			return m_backgroundColor;
 		}
 
 		const std::vector<RenderLayerID>& Camera::GetRenderLayers() const {
@@ -155,6 +199,13 @@ namespace EngineCore {
 			return m_renderLayers;
 		}
 
+		RenderLayerMask Camera::GetRenderLayerMask() const {
+			if (IsDead("Cant get RenderLayer mask")) {
+				return 0;
+			}
+			return m_renderLayerMask;
+		}
+
 		#pragma endregion
 
 		#pragma region Set
@@ -230,11 +281,52 @@ namespace EngineCore {
 			return this;
 		}
 
+		Camera* Camera::SetPriority(int priority) {
+			if (IsDead("Cant set priority")) {
+				return this;
+			}
+			m_priority = priority;
+			return this;
+		}
+
+		Camera* Camera::SetAdditional(bool value) {
+			if (IsDead("Cant set is additional")) {
+				return this;
+			}
+			m_isAdditional = value;
+			return this;
+		}
+
+		Camera* Camera::SetViewport(float x, float y, float width, float height) {
+			if (IsDead("Cant set viewport")) {
+				return this;
+			}
+			m_viewport.Set(x, y, width, height);
+			return this;
+		}
+
+		Camera* Camera::SetRenderTarget(OffscreenTarget* target) {
+			if (IsDead("Cant set render target")) {
+				return this;
+			}
+			m_renderTarget = target;
+			return this;
+		}
+
+		Camera* Camera::SetBackgroundColor(const Vector4& color) {
+			if (IsDead("Cant set background color")) {
+				return this;
+			}
+			m_backgroundColor = color;
+			return this;
+		}
+
 		Camera* Camera::SetCameraLayers(std::vector<RenderLayerID> renderLayers) {
 			if (IsDead("Cant get RenderLayers")) {
 				return this;
 			}
 			m_renderLayers = renderLayers;
+			m_renderLayerMask = RenderLayerManager::GetLayerMask(m_renderLayers);
 			return this;
 		}
 
@@ -243,6 +335,7 @@ namespace EngineCore {
 				return this;
 			}
 			m_renderLayers.push_back(renderLayer);
+			m_renderLayerMask |= RenderLayerManager::GetLayerMask(renderLayer);
 			return this;
 		}
 
@@ -251,9 +344,13 @@ namespace EngineCore {
 		#pragma region Other
 		
 		float Camera::CalculateAspectRatio() const {
-			return m_calculateAspectRatioWithWindow
-				? static_cast<float>(m_windowWidth) / static_cast<float>(m_windowHeight)
-				: m_aspectRatio;
+			if (!m_calculateAspectRatioWithWindow)
+				return m_aspectRatio;
+
+			// the viewport is a part of the window or of the render target
+			float width = static_cast<float>((m_renderTarget) ? m_renderTarget->GetWidth() : m_windowWidth) * m_viewport.z;
+			float height = static_cast<float>((m_renderTarget) ? m_renderTarget->GetHeight() : m_windowHeight) * m_viewport.w;
+			return (height > 0.0f) ? width / height : m_aspectRatio;
 		}
 
 		void Camera::CreateProjectionMatrix(float aspectRatio) {
@@ -283,10 +380,42 @@ namespace EngineCore {
 		}
 
 		void Camera::CreateViewMatrix() {
+			auto trans = m_gameObject->GetTransform();
+			m_view = GLTransform4x4::LookAt(m_viewPosition, m_viewPosition + m_viewForward, trans->GetUp(m_viewForward));
+		}
+
+		void Camera::UpdateProjectionMatrix() {
+			float aspectRatio = CalculateAspectRatio();
+			if (m_projectionChanged || (m_calculateAspectRatioWithWindow && m_lastAspectRatio != aspectRatio)) {
+				m_lastAspectRatio = aspectRatio;
+				CreateProjectionMatrix(aspectRatio);
+				m_projectionChanged = false;
+				m_viewProjectionChanged = true;
+			}
+		}
+
+		void Camera::UpdateViewMatrix() {
+			// per camera, every camera can move on its own
 			auto trans = m_gameObject->GetTransform();
 			Vector3 worldPos = trans->GetWorldPosition();
 			Vector3 forward = trans->GetForward();
-			m_view = GLTransform4x4::LookAt(worldPos, worldPos + forward, trans->GetUp(forward));
+			if (m_viewChanged || worldPos != m_viewPosition || forward != m_viewForward) {
+				m_viewPosition = worldPos;
+				m_viewForward = forward;
+				CreateViewMatrix();
+				m_viewChanged = false;
+				m_viewProjectionChanged = true;
+			}
+		}
+
+		void Camera::UpdateViewProjection() {
+			UpdateProjectionMatrix();
+			UpdateViewMatrix();
+			if (m_viewProjectionChanged) {
+				m_viewProjection = m_projection * m_view;
+				m_frustum.Set(m_viewProjection);
+				m_viewProjectionChanged = false;
+			}
 		}
 
 		void Camera::SetWindowDimensions(int width, int height) {
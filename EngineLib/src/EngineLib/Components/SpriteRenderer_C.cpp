@@ -52,6 +52,13 @@ namespace EngineCore {
 			return m_invertMesh;
 		}
 
+		Vector4 SpriteRenderer::GetUVRect() const {
+			if (IsDead("Cant get uv rect")) {
+				return Vector4();
+			}
+			return m_uvRect;
+		}
+
 		SpriteRenderer* SpriteRenderer::SetSprite(Texture2DID id) {
 			if (IsDead("Cant set Sprite")) {
 				return this;
@@ -60,8 +67,22 @@ namespace EngineCore {
 			auto* rm = ResourceManager::GetInstance();
 			auto* texture = rm->GetTexture2D(id);
 			if (texture) {
+				m_textureID = id;
 				m_isTransparent = (texture->GetNrChannels() > 3);
-				m_shaderBindObject.SetParam("texture", id);
+
+				SpriteAtlas& atlas = rm->GetSpriteAtlas();
+				SpriteAtlas::Region region;
+				if (atlas.Pack(id, region)) {
+					m_shaderBindObject.SetParam("texture", region.texture);
+					m_uvRect = region.uvRect;
+					m_regionSerial = region.serial;
+					m_atlasGeneration = atlas.GetGeneration();
+				}
+				else {
+					m_shaderBindObject.SetParam("texture", id);
+					m_uvRect.Set(0, 0, 1, 1);
+					m_regionSerial = 0;
+				}
 			}
 			else {
 				Log::Error("SpriteRenderer: Cant set sprite, spirte is nullptr!");
@@ -106,7 +127,27 @@ namespace EngineCore {
 			return this;
 		}
 
+		void SpriteRenderer::ValidateRegion() {
+			SpriteAtlas& atlas = ResourceManager::GetInstance()->GetSpriteAtlas();
+			if (atlas.GetGeneration() == m_atlasGeneration)
+				return;
+			m_atlasGeneration = atlas.GetGeneration();
+
+			SpriteAtlas::Region region;
+			if (atlas.TryGetRegion(m_textureID, region) && region.serial == m_regionSerial)
+				return;
+
+			// the texture was deleted, binds nothing like a deleted texture that is not packed
+			m_textureID = Texture2DID(ENGINE_INVALID_ID);
+			m_regionSerial = 0;
+			m_shaderBindObject.SetParam("texture", m_textureID);
+			m_uvRect.Set(0, 0, 1, 1);
+		}
+
 		void SpriteRenderer::SubmitDrawCall() {
+			if (m_regionSerial != 0)
+				ValidateRegion();
+
 			m_cmd.type = RenderCommandType::Mesh;
 			m_cmd.invertMesh = m_invertMesh;
 			m_cmd.materialID = ASSETS::ENGINE::MATERIAL::Default();
@@ -116,6 +157,7 @@ namespace EngineCore {
 			m_cmd.zOrder = m_zOrder;
 			m_cmd.modelMatrix = m_gameObject->GetTransform()->GetWorldModelMatrixPtr();
 			m_cmd.meshColor = m_meshColor;
+			m_cmd.uvRect = m_uvRect;
 			m_cmd.isTransparent = (m_isTransparent || m_meshColor.w < 1.0);
 
 			m_renderer->Submit(m_cmd);
@@ -50,7 +50,10 @@ namespace EngineCore::Component {
 		m_cmd.modelMatrix = m_gameObject->GetTransform()->GetWorldModelMatrixPtr();
 		m_cmd.fontID = m_fontID;
 		m_cmd.pixelSize = m_textResolution;
-		m_cmd.textQuads = GetTextQuads();
+		// the quads stay in m_textQuads, the command only points at them
+		const std::vector<TextQuad>& quads = GetTextQuads();
+		m_cmd.textQuads = quads.data();
+		m_cmd.textQuadCount = quads.size();
 		m_cmd.meshColor = m_textColor;
 		m_cmd.isTransparent = true;
 
@@ -19,6 +19,7 @@
 #include "EngineLib/GameObjectManager.h"
 #include "EngineLib/Application.h"
 #include "EngineLib/RenderLayerManager.h"
+#include "EngineLib/Profiler.h"
 #include "EngineLib/Debugger.h"
 #include "EngineLib/Engine.h"
 #include "EngineLib/DebuggerWindows.h"
@@ -138,6 +139,9 @@ namespace EngineCore {
                     ImGui::BulletText("%s (%u Priority: %u)", layerNames[i].c_str(), rID.value, RenderLayerManager::GetLayerPriority(rID));
                 }
             }
+
+            if (ImGui::CollapsingHeader("Frame Phases"))
+                FramePhasesTable();
         }
 
         auto pos = ImGui::GetWindowPos();
@@ -148,6 +152,43 @@ namespace EngineCore {
         m_firstStatsWin = false;
     }
 
+    void DebuggerWindows::FramePhasesTable() {
+        std::vector<double> frameTimes = Profiler::GetFrameTimes();
+        std::vector<float> frameTimesMs(frameTimes.size());
+        for (size_t i = 0; i < frameTimes.size(); i++)
+            frameTimesMs[i] = static_cast<float>(frameTimes[i] * 1000.0);
+
+        float budgetMs = static_cast<float>(Profiler::GetFrameBudget() * 1000.0);
+        ImGui::PlotLines("##FrameTimes", frameTimesMs.data(), static_cast<int>(frameTimesMs.size()),
+            0, "frame ms", 0.0f, (budgetMs > 0.0f) ? budgetMs * 2.0f : FLT_MAX, ImVec2(-1, 50));
+        if (budgetMs > 0.0f)
+            ImGui::Text("Budget: %.2f ms (exceeded %llu times)", budgetMs, static_cast<unsigned long long>(Profiler::GetFrameBudgetExceededCount()));
+
+        // engine phases are the zones of the main thread directly below Engine::Update
+        ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp;
+        if (!ImGui::BeginTable("FramePhases", 3, flags))
+            return;
+
+        ImGui::TableSetupColumn("Phase");
+        ImGui::TableSetupColumn("avg ms");
+        ImGui::TableSetupColumn("p95 ms");
+        ImGui::TableHeadersRow();
+
+        for (const auto& section : Profiler::GetSectionData()) {
+            if (section.threadIndex != 0 || section.depth > 1)
+                continue;
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%s%s", (section.depth > 0) ? "  " : "", section.name.c_str());
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.3f", section.average * 1000.0);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.3f", section.p95 * 1000.0);
+        }
+        ImGui::EndTable();
+    }
+
     void DebuggerWindows::CameraWindow() {
         if (m_firstCameraWin) {
             ImGui::SetNextWindowPos(ImVec2(m_cameraWinState.x, m_cameraWinState.y));
@@ -371,57 +412,64 @@ namespace EngineCore {
             ImGui::SameLine();
             static bool autoScroll = true;
             ImGui::Checkbox("Auto-scroll", &autoScroll);
+            ImGui::SameLine();
+            ImGui::Checkbox("Call sites", &m_logSitesView);
 
             ImGui::Separator();
 
-            // Filter options (check boxes for log levels)
-            ImGui::Text("Filter:");
-            ImGui::SameLine();
-            bool showInfo = (m_logMask & 0b0001) != 0;
-            bool showWarning = (m_logMask & 0b0010) != 0;
-            bool showError = (m_logMask & 0b0100) != 0;
-            bool showDebug = (m_logMask & 0b1000) != 0;
-
-            if (ImGui::Checkbox("Info", &showInfo)) {
-                if (showInfo) m_logMask |= 0b0001;
-                else          m_logMask &= ~0b0001;
-            }
-            ImGui::SameLine();
-            if (ImGui::Checkbox("Warning", &showWarning)) {
-                if (showWarning) m_logMask |= 0b0010;
-                else             m_logMask &= ~0b0010;
-            }
-            ImGui::SameLine();
-            if (ImGui::Checkbox("Error", &showError)) {
-                if (showError) m_logMask |= 0b0100;
-                else           m_logMask &= ~0b0100;
-            }
-            ImGui::SameLine();
-            if (ImGui::Checkbox("Debug", &showDebug)) {
-                if (showDebug) m_logMask |= 0b1000;
-                else           m_logMask &= ~0b1000;
+            if (m_logSitesView) {
+                LogSitesTable();
             }
+            else {
+                // Filter options (check boxes for log levels)
+                ImGui::Text("Filter:");
+                ImGui::SameLine();
+                bool showInfo = (m_logMask & 0b0001) != 0;
+                bool showWarning = (m_logMask & 0b0010) != 0;
+                bool showError = (m_logMask & 0b0100) != 0;
+                bool showDebug = (m_logMask & 0b1000) != 0;
+
+                if (ImGui::Checkbox("Info", &showInfo)) {
+                    if (showInfo) m_logMask |= 0b0001;
+                    else          m_logMask &= ~0b0001;
+                }
+                ImGui::SameLine();
+                if (ImGui::Checkbox("Warning", &showWarning)) {
+                    if (showWarning) m_logMask |= 0b0010;
+                    else             m_logMask &= ~0b0010;
+                }
+                ImGui::SameLine();
+                if (ImGui::Checkbox("Error", &showError)) {
+                    if (showError) m_logMask |= 0b0100;
+                    else           m_logMask &= ~0b0100;
+                }
+                ImGui::SameLine();
+                if (ImGui::Checkbox("Debug", &showDebug)) {
+                    if (showDebug) m_logMask |= 0b1000;
+                    else           m_logMask &= ~0b1000;
+                }
 
-            ImGui::Separator();
+                ImGui::Separator();
 
-            ImGui::BeginChild("ConsoleScrollRegion", ImVec2(0, 0), false,
-                ImGuiWindowFlags_HorizontalScrollbar);
+                ImGui::BeginChild("ConsoleScrollRegion", ImVec2(0, 0), false,
+                    ImGuiWindowFlags_HorizontalScrollbar);
 
-            for (auto& log : m_log) {
-                if ((log.m_logLevel == Log::levelInfo && (m_logMask & 0b0001)) ||
-                    (log.m_logLevel == Log::levelWarning && (m_logMask & 0b0010)) ||
-                    (log.m_logLevel == Log::levelError && (m_logMask & 0b0100)) ||
-                    (log.m_logLevel == Log::levelDebug && (m_logMask & 0b1000)))
-                {
-                    ImGui::TextUnformatted(log.m_msg.c_str());
+                for (auto& log : m_log) {
+                    if ((log.m_logLevel == Log::levelInfo && (m_logMask & 0b0001)) ||
+                        (log.m_logLevel == Log::levelWarning && (m_logMask & 0b0010)) ||
+                        (log.m_logLevel == Log::levelError && (m_logMask & 0b0100)) ||
+                        (log.m_logLevel == Log::levelDebug && (m_logMask & 0b1000)))
+                    {
+                        ImGui::TextUnformatted(log.m_msg.c_str());
+                    }
                 }
-            }
 
-            if (autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
-                ImGui::SetScrollHereY(1.0f);
-            }
+                if (autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
+                    ImGui::SetScrollHereY(1.0f);
+                }
 
-            ImGui::EndChild();
+                ImGui::EndChild();
+            }
         }
 
         auto pos = ImGui::GetWindowPos();
@@ -433,6 +481,42 @@ namespace EngineCore {
         m_firstConsoleWin = false;
     }
 
+    void DebuggerWindows::LogSitesTable() {
+        if (ImGui::Button("Reset counters")) {
+            Log::ResetSiteStats();
+        }
+
+        ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+            ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+        if (!ImGui::BeginTable("LogSites", 4, flags))
+            return;
+
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Level", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Suppressed", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Format", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+
+        static const char* levelNames[] = { "Error", "Warning", "Info", "Debug" };
+        for (const auto& site : Log::GetSiteStats()) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(levelNames[site.level]);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%llu", static_cast<unsigned long long>(site.count));
+            ImGui::TableSetColumnIndex(2);
+            if (site.suppressed > 0)
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "%llu", static_cast<unsigned long long>(site.suppressed));
+            else
+                ImGui::TextUnformatted("0");
+            ImGui::TableSetColumnIndex(3);
+            ImGui::TextUnformatted(site.format);
+        }
+
+        ImGui::EndTable();
+    }
+
     void DebuggerWindows::DrawUIElementNode(const std::shared_ptr<UI::ElementBase>& elem) {
         if (!elem) return;
 
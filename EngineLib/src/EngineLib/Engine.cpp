@@ -1,6 +1,8 @@
 #ifndef NDEBUG
 #include "EngineLib/Debugger.h"
 #endif
+#include <CoreLib/ImageUtils.h>
+
 #include "EngineLib/Renderer.h"
 #include "EngineLib/AssetRepository.h"
 #include "EngineLib/Engine.h"
@@ -16,16 +18,32 @@ namespace EngineCore {
 	int Engine::EngineStart() {
 		if (m_app == nullptr) 
 			return ENGINE_FAILURE;
-		if (GLFWInit() != ENGINE_SUCCESS) 
+
+		// log calls only capture their arguments, formatting and writing happens on the log thread
+		Log::StartAsync();
+
+		// without window there is no GL context, the render path runs on the recording device
+		bool hasGLContext = m_app->m_appApplicationHeader || m_app->m_appOffscreenEnabled;
+		Renderer::InitBackend((hasGLContext) ? RenderBackend::OpenGL : RenderBackend::Recording);
+
+		// a headless benchmark runs on its own clock and does not need GLFW at all
+		bool needsGLFW = hasGLContext || !m_app->m_appBenchmarkEnabled;
+		if (needsGLFW && GLFWInit() != ENGINE_SUCCESS) 
 			return ENGINE_FAILURE;
 
-		if (m_app->m_appApplicationHeader) {
+		if (m_app->m_appBenchmarkEnabled)
+			StartBenchmark();
+
+		if (hasGLContext) {
 			if (GLFWCreateWindow() != ENGINE_SUCCESS) 
 				return ENGINE_FAILURE;
 			if (GLADInit() != ENGINE_SUCCESS) 
 				return ENGINE_FAILURE;
 		}
 
+		if (m_app->m_appOffscreenEnabled && OffscreenInit() != ENGINE_SUCCESS)
+			return ENGINE_FAILURE;
+
 		if (ResourceManager::Init() == ENGINE_FAILURE)
 			return ENGINE_FAILURE;
 
@@ -35,13 +53,17 @@ namespace EngineCore {
 		GameObjectManager::Init();
 		m_gameObjectManager = GameObjectManager::GetInstance();
 
+		m_maxTextureUnits = static_cast<GLint>(Renderer::GetDevice()->GetMaxTextureUnits());
 		ShaderBindObject::m_maxTextureUnits = m_maxTextureUnits;
 
 		LoadBaseAsset();
 
 #ifndef NDEBUG
-		m_debugger = std::unique_ptr<Debugger>(new Debugger(this));
-		m_debugger->Init();
+		// ImGui needs a visible window
+		if (m_window != nullptr && !m_offscreenTarget) {
+			m_debugger = std::unique_ptr<Debugger>(new Debugger(this));
+			m_debugger->Init();
+		}
 #endif
 
 		PrintApplicationHeader();
@@ -49,21 +71,35 @@ namespace EngineCore {
 		
 		RenderLayerManager::SetupDefaultRenderLayers();
 		InputLayerManager::SetupDefaultInputLayers();
+		Profiler::SetFrameBudgetCallback([this](uint64_t frameIndex, double frameTime, const std::vector<Profiler::FrameZone>& zones) {
+			// rate limited, a sustained slowdown would dump the zones every frame
+			Log::Limited::Warn("Engine: Frame {} took {} ms, budget is {} ms\n{}",
+				frameIndex, frameTime * 1000.0, m_app->m_appProfilerFrameBudget, Profiler::FormatFrameZones(zones));
+			m_app->OnFrameBudgetExceeded(frameTime * 1000.0);
+		});
 		m_app->Start();
 		RenderLayerManager::Lock();
 		return ENGINE_SUCCESS;
 	}
 
-	void Engine::EngineLoop() {
+	int Engine::EngineLoop() {
+		Profiler::StartFrame();
 		while (m_isEngineRunning) {
 			bool hasWindow = m_window != nullptr;
 
 			if (hasWindow) {
-				glfwSwapBuffers(m_window);
+				ENGINE_PROFILE_ZONE("Engine::SwapBuffers");
+				// the offscreen target is read back instead of shown
+				if (!m_offscreenTarget)
+					glfwSwapBuffers(m_window);
 				glfwPollEvents();
 			}
 
-			Update(glfwGetTime());
+			Update(Time::GetTimeDouble());
+			Profiler::EndFrame();
+
+			if (m_app->m_appBenchmarkEnabled)
+				RecordBenchmarkFrame();
 
 			if (hasWindow && glfwWindowShouldClose(m_window)) {
 				if (m_app->m_appApplicationCloseAppOnWindowClose)
@@ -73,9 +109,11 @@ namespace EngineCore {
 		}
 
 		Shutdown();
+		return m_exitCode;
 	}
 
 	void Engine::Update(double currentTimeSec) {
+		ENGINE_PROFILE_ZONE("Engine::Update");
 		m_frameCount++;
 
 		Time::UpdateTime(currentTimeSec);
@@ -98,25 +136,54 @@ namespace EngineCore {
 		Component::Camera::SetWindowDimensions(screenWidth, screenHeight);
 		m_app->m_appApplicationFramesPerSecond = m_framesPerSecond;
 
-		m_gameObjectManager->UpdateGameObjects();
-		m_app->Update();
-		UIManager::Update(screenWidth, screenHeight);
-		if (m_gameObjectManager->m_mainCamera.lock()) {
+		// every phase is its own zone, see Profiler::GetSectionData / the Stats window
+		{
+			ENGINE_PROFILE_ZONE("GameObjects::Update");
+			m_gameObjectManager->UpdateGameObjects();
+		}
+		{
+			ENGINE_PROFILE_ZONE("Application::Update");
+			m_app->Update();
+		}
+		{
+			ENGINE_PROFILE_ZONE("UIManager::Update");
+			UIManager::Update(screenWidth, screenHeight, Time::GetDeltaTime());
+		}
+		if (!m_gameObjectManager->m_mainCamera.expired()) {
 			static Renderer* renderer = Renderer::GetInstance();
-			UIManager::SendDrawCommands();
-			m_gameObjectManager->SendDrawCommands();
-			renderer->DrawAll();
+			if (m_offscreenTarget)
+				renderer->BeginFrame(m_offscreenTarget->GetFramebuffer(), m_offscreenTarget->GetWidth(), m_offscreenTarget->GetHeight());
+			else
+				renderer->BeginFrame(0, screenWidth, screenHeight);
+			{
+				ENGINE_PROFILE_ZONE("SendDrawCommands");
+				UIManager::SendDrawCommands();
+				m_gameObjectManager->SendDrawCommands();
+			}
+			{
+				ENGINE_PROFILE_ZONE("Renderer::DrawAll");
+				renderer->DrawAll();
+			}
 		}
 		else {
-			Log::Warn("Engine: No camera available");
+			Log::Limited::Warn("Engine: No camera available");
+		}
+
+		if (m_offscreenTarget) {
+			ENGINE_PROFILE_ZONE("Offscreen::Readback");
+			m_offscreenTarget->RequestReadback(static_cast<uint64_t>(m_frameCount));
 		}
 
 		LateUpdate();
 	}
 
 	void Engine::LateUpdate() {
+		ENGINE_PROFILE_FUNCTION();
+		// subscribers (e.g. the debugger console) get the messages of this frame on the main thread
+		Log::DispatchSubscribers();
+
 #ifndef NDEBUG
-		if (Input::KeyJustPressed(m_app->m_appDebugKey))
+		if (m_debugger && Input::KeyJustPressed(m_app->m_appDebugKey))
 			m_app->m_appDebugActive = !m_app->m_appDebugActive;
 
 		if (m_app->m_appDebugActive) {
@@ -136,19 +203,157 @@ namespace EngineCore {
 		}
 #endif 
 
+		if (Input::KeyJustPressed(m_app->m_appProfilerCaptureKey))
+			SaveProfilerCapture();
+
 		Input::LateUpdate();
 	}
 
+	void Engine::SaveProfilerCapture() {
+		if (!Profiler::IsCapturing()) {
+			Profiler::StartCapture();
+			m_app->m_appProfilerCapture = true;
+			Log::Info("Engine: Profiler capture started, press {} again to save it", static_cast<int>(m_app->m_appProfilerCaptureKey));
+			return;
+		}
+
+		std::string path = m_app->m_appProfilerCapturePath + "_" + 
+			TimeUtils::GetCurrentDateString() + "_" + TimeUtils::GetCurrentTimeString() + ".json";
+		Profiler::WriteChromeTrace(path);
+	}
+
+	void Engine::StartBenchmark() {
+		// frame n is at n * delta time, so the first frame has a regular delta time
+		m_benchmarkFrame = 1;
+		if (m_app->m_appBenchmarkClock) {
+			Time::SetClock(m_app->m_appBenchmarkClock);
+		}
+		else {
+			double deltaTime = m_app->m_appBenchmarkFixedDeltaTime;
+			Time::SetClock([this, deltaTime]() { return static_cast<double>(m_benchmarkFrame) * deltaTime; });
+		}
+
+		if (m_app->m_appBenchmarkFrameLimit > 0)
+			m_frameRecorder.Reserve(static_cast<size_t>(m_app->m_appBenchmarkFrameLimit));
+
+		Log::Info("Engine: Benchmark mode, delta time {} s, warmup {}, frame limit {}, duration limit {} s, renderer {}",
+			m_app->m_appBenchmarkFixedDeltaTime, m_app->m_appBenchmarkWarmupFrames, m_app->m_appBenchmarkFrameLimit, m_app->m_appBenchmarkDurationLimit,
+			std::string((Renderer::GetBackend() == RenderBackend::Recording) ? "recording" : "OpenGL"));
+	}
+
+	void Engine::RecordBenchmarkFrame() {
+		static Renderer* renderer = Renderer::GetInstance();
+		double time = Time::m_lastFrameTimeSec;
+		uint64_t warmupFrames = m_app->m_appBenchmarkWarmupFrames;
+		if (m_benchmarkFrame > warmupFrames)
+			m_frameRecorder.Record(m_benchmarkFrame, time, Profiler::GetLastFrameTime(), Profiler::GetLastFrameZones(), renderer->GetStats());
+
+		bool frameLimitReached = m_app->m_appBenchmarkFrameLimit > 0 && m_benchmarkFrame >= warmupFrames + m_app->m_appBenchmarkFrameLimit;
+		bool durationLimitReached = m_app->m_appBenchmarkDurationLimit > 0.0 && time >= m_app->m_appBenchmarkDurationLimit;
+		if (frameLimitReached || durationLimitReached)
+			m_isEngineRunning = false;
+
+		m_benchmarkFrame++;
+	}
+
+	int Engine::FinishBenchmark() {
+		const std::string& path = m_app->m_appBenchmarkOutputPath;
+		bool ok = m_frameRecorder.WriteCSV(path + ".csv");
+		ok = m_frameRecorder.WriteJson(path + ".json") && ok;
+		if (ok)
+			Log::Info("Engine: Benchmark frames written to '{}.csv' and '{}.json'", path, path);
+
+		FrameRecorder::Summary summary = m_frameRecorder.GetSummary();
+		Log::Info("Engine: Benchmark {} frames, avg {} ms, p50 {} ms, p95 {} ms, p99 {} ms, max {} ms",
+			summary.frameCount, summary.average * 1000.0, summary.p50 * 1000.0, summary.p95 * 1000.0,
+			summary.p99 * 1000.0, summary.max * 1000.0);
+		for (const auto& phase : m_frameRecorder.GetPhaseNames()) {
+			FrameRecorder::Summary phaseSummary = m_frameRecorder.GetPhaseSummary(phase);
+			Log::Info("Engine:   {}: avg {} ms, p95 {} ms", phase, phaseSummary.average * 1000.0, phaseSummary.p95 * 1000.0);
+		}
+
+		const std::string& baselinePath = m_app->m_appBenchmarkBaseline;
+		if (baselinePath.empty())
+			return ENGINE_SUCCESS;
+
+		if (m_app->m_appBenchmarkUpdateBaseline) {
+			if (!m_frameRecorder.WriteBaseline(baselinePath))
+				return ENGINE_FAILURE;
+			Log::Info("Engine: Benchmark baseline written to '{}'", baselinePath);
+			return ENGINE_SUCCESS;
+		}
+
+		std::unordered_map<std::string, double> baseline;
+		if (!FrameRecorder::LoadBaseline(baselinePath, baseline))
+			return ENGINE_FAILURE;
+
+		int regressions = 0;
+		for (const auto& c : m_frameRecorder.CompareWithBaseline(baseline, m_app->m_appBenchmarkThreshold)) {
+			if (c.isRegression)
+				regressions++;
+		}
+
+		if (regressions > 0) {
+			Log::Error("Engine: {} benchmark metric(s) regressed by more than {}% against '{}'",
+				regressions, m_app->m_appBenchmarkThreshold * 100.0, baselinePath);
+			return ENGINE_FAILURE;
+		}
+
+		Log::Info("Engine: No benchmark regressions against '{}'", baselinePath);
+		return ENGINE_SUCCESS;
+	}
+
 	void Engine::Shutdown() {
+		if (m_app->m_appBenchmarkEnabled)
+			m_exitCode = FinishBenchmark();
+
+		// the app gets the last frames before it shuts down
+		if (m_offscreenTarget) {
+			m_offscreenTarget->Finish();
+			Log::Info("Engine: Offscreen readback stalled {} times", m_offscreenTarget->GetStallCount());
+		}
+
 		m_app->Shutdown();
 #ifndef NDEBUG
-		m_debugger->Shutdown();
+		if (m_debugger)
+			m_debugger->Shutdown();
 #endif 
 		UIManager::Shutdown();
 		GameObjectManager::Shutdown();
 		ResourceManager::Shutdown();
+		// the target needs the GL context
+		m_offscreenTarget.reset();
 
 		glfwTerminate();
+		Log::StopAsync();
+	}
+
+	int Engine::OffscreenInit() {
+		m_offscreenTarget = std::make_unique<OffscreenTarget>();
+		int width = m_app->m_appApplicationWindowWidth, height = m_app->m_appApplicationWindowHeight;
+		if (!m_offscreenTarget->Create(width, height, m_app->m_appOffscreenReadbackBufferCount)) {
+			Log::Error("Engine: Could not create the offscreen target {}x{}", width, height);
+			m_offscreenTarget.reset();
+			return ENGINE_FAILURE;
+		}
+
+		m_offscreenTarget->SetFrameCallback([this](const OffscreenTarget::Frame& frame) { OnOffscreenFrame(frame); });
+		m_offscreenTarget->Bind();
+		Log::Info("Engine: Offscreen mode {}x{}, {} readback buffers", width, height, m_app->m_appOffscreenReadbackBufferCount);
+		return ENGINE_SUCCESS;
+	}
+
+	void Engine::OnOffscreenFrame(const OffscreenTarget::Frame& frame) {
+		const std::string& dumpPath = m_app->m_appOffscreenDumpPath;
+		if (!dumpPath.empty() && frame.index % m_app->m_appOffscreenDumpInterval == 0) {
+			ENGINE_PROFILE_ZONE("Offscreen::DumpPNG");
+			std::string index = std::to_string(frame.index);
+			if (index.size() < 6)
+				index.insert(0, 6 - index.size(), '0');
+			ImageUtils::WritePNG(dumpPath + "_" + index + ".png", frame.pixels.data(), frame.width, frame.height, 4);
+		}
+
+		m_app->OnOffscreenFrame(frame.index, frame.width, frame.height, frame.pixels);
 	}
 
 	void Engine::OnWindowResize(int width, int height) {
@@ -159,6 +364,9 @@ namespace EngineCore {
 
 	int Engine::GLFWInit() {
 		glfwSetErrorCallback(GLFWErrorCallback);
+		// the null platform needs no display server, the context then comes from EGL or OSMesa
+		if (m_app->m_appOffscreenEnabled && m_app->m_appOffscreenContextAPI != Application::ContextAPI::Native)
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
 		if (!glfwInit())
 		{
 			Log::Error("Engine::GLFW: Initialization of GLFW faild!");
@@ -170,7 +378,7 @@ namespace EngineCore {
 	}
 
 	int Engine::GLFWCreateWindow() {
-		if (!m_app->m_appApplicationHeader) return ENGINE_SUCCESS;
+		if (!m_app->m_appApplicationHeader && !m_app->m_appOffscreenEnabled) return ENGINE_SUCCESS;
 
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, m_app->m_appOpenGLVersionMajor);
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, m_app->m_appOpenGLVersionMinor);
@@ -184,6 +392,20 @@ namespace EngineCore {
 		glfwWindowHint(GLFW_FLOATING, m_app->m_appApplicationWindowFloating);
 		glfwWindowHint(GLFW_VISIBLE, m_app->m_appApplicationWindowVisibility);
 
+		if (m_app->m_appOffscreenEnabled) {
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+			switch (m_app->m_appOffscreenContextAPI) {
+			case Application::ContextAPI::EGL:
+				glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+				break;
+			case Application::ContextAPI::OSMesa:
+				glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+				break;
+			default:
+				break;
+			}
+		}
+
 		m_window = glfwCreateWindow(m_app->m_appApplicationWindowWidth, m_app->m_appApplicationWindowHeight, m_app->m_appApplicationName.c_str(), NULL, NULL);
 		
 		if (!m_window)
@@ -261,7 +483,6 @@ namespace EngineCore {
 
 		glPolygonMode(GL_FRONT, GL_FILL);
 		glViewport(0, 0, m_app->m_appApplicationWindowWidth, m_app->m_appApplicationWindowHeight);
-		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &m_maxTextureUnits);
 		if (m_app->m_appOpenGLDepthTesting)
 			glEnable(GL_DEPTH_TEST);
 		else
@@ -7,6 +7,7 @@
 #include <CoreLib/Log.h>
 
 #include "EngineLib/Nurom_Bold_ttf.h"
+#include "EngineLib/Renderer.h"
 #include "EngineLib/FontAsset.h"
 
 namespace EngineCore {
@@ -105,7 +106,8 @@ namespace EngineCore {
     void FontAsset::DeleteFontAtlas(int pixelSize) {
         auto it = m_atlases.find(pixelSize);
         if (it != m_atlases.end()) {
-            glDeleteTextures(1, &it->second.glTextureID);
+            if (it->second.glTextureID != ENGINE_INVALID_ID)
+                Renderer::GetDevice()->DeleteTexture(it->second.glTextureID);
             m_atlases.erase(it);
             return;
         }
@@ -115,7 +117,7 @@ namespace EngineCore {
     void FontAsset::DeleteAllAtlases() {
         for (auto& [size, atlas] : m_atlases) {
             if (atlas.glTextureID != ENGINE_INVALID_ID) {
-                glDeleteTextures(1, &atlas.glTextureID);
+                Renderer::GetDevice()->DeleteTexture(atlas.glTextureID);
                 atlas.glTextureID = ENGINE_INVALID_ID;
             }
         }
@@ -192,28 +194,18 @@ namespace EngineCore {
             xOffset += bmp.width + padding;
         }
 
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-        unsigned int texID;
-        glGenTextures(1, &texID);
-        glBindTexture(GL_TEXTURE_2D, texID);
-        glTexImage2D(GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            paddedAtlasWidth,
-            paddedAtlasHeight,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            atlasBuffer.data());
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        TextureDesc desc;
+        desc.width = paddedAtlasWidth;
+        desc.height = paddedAtlasHeight;
+        desc.channels = 1;
+        desc.wrapX = GL_CLAMP_TO_EDGE;
+        desc.wrapY = GL_CLAMP_TO_EDGE;
+        desc.filterMin = GL_LINEAR;
+        desc.filterMag = GL_LINEAR;
+        GpuHandle texID = Renderer::GetDevice()->CreateTexture2D(desc, atlasBuffer.data());
 
         atlas.lastUsedFrame = ++m_accessCounter;
-        atlas.glTextureID = texID;
+        atlas.glTextureID = (texID != 0) ? texID : ENGINE_INVALID_ID;
         m_atlases[pixelSize] = atlas;
 
         EnforceAtlasLimit();
@@ -239,7 +231,8 @@ namespace EngineCore {
             else
                 Log::Print(Log::levelDebug, "                    {}", m_path);
 #endif
-            glDeleteTextures(1, &lru->second.glTextureID);
+            if (lru->second.glTextureID != ENGINE_INVALID_ID)
+                Renderer::GetDevice()->DeleteTexture(lru->second.glTextureID);
             m_atlases.erase(lru);
         }
     }
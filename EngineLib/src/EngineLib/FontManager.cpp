@@ -1,8 +1,9 @@
-﻿#include <glad\glad.h>
+﻿#include <cstddef>
 #include <CoreLib/File.h>
 #include <CoreLib/Log.h>
 
 #include "EngineLib/ResourceManager.h"
+#include "EngineLib/Renderer.h"
 #include "EngineLib/FontManager.h"
 
 namespace EngineCore {
@@ -95,56 +96,42 @@ namespace EngineCore {
 	}
 
 	void FontManager::InitTextRenderer() {
-		glGenVertexArrays(1, &m_textVAO);
-		glGenBuffers(1, &m_textVBO);
-		glGenBuffers(1, &m_textEBO);
+		RenderDevice* device = Renderer::GetDevice();
 
-		glBindVertexArray(m_textVAO);
+		// VBO for 4 vertices, rewritten for every quad
+		m_textVBO = device->CreateBuffer(BufferType::Vertex, nullptr, sizeof(TextVertex) * 4, BufferUsage::Dynamic);
 
-		// VBO für 4 Vertices
-		glBindBuffer(GL_ARRAY_BUFFER, m_textVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(TextVertex) * 4, nullptr, GL_DYNAMIC_DRAW);
-
-		// EBO für Quad-Indizes
 		unsigned int indices[6] = { 0,1,2,2,3,0 };
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_textEBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-		// Vertex-Attribs: position (vec3) + uv (vec2)
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)0);
-
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, uv));
-
-		glBindVertexArray(0);
+		m_textEBO = device->CreateBuffer(BufferType::Index, indices, sizeof(indices), BufferUsage::Static);
+
+		// position (vec3) + uv (vec2)
+		std::vector<VertexAttribute> attributes = {
+			{ 0, 3, sizeof(TextVertex), 0, m_textVBO, false },
+			{ 1, 2, sizeof(TextVertex), offsetof(TextVertex, uv), m_textVBO, false },
+		};
+		m_textVAO = device->CreateVertexArray(attributes, m_textEBO);
 	}
 
 	void FontManager::ShutdownTextRenderer() {
+		RenderDevice* device = Renderer::GetDevice();
 		if (m_textVAO != ENGINE_INVALID_ID) {
-			glDeleteTextures(1, &m_textVAO);
+			device->DeleteVertexArray(m_textVAO);
 			m_textVAO = ENGINE_INVALID_ID;
 		}
 		if (m_textVBO != ENGINE_INVALID_ID) {
-			glDeleteTextures(1, &m_textVBO);
+			device->DeleteBuffer(m_textVBO);
 			m_textVBO = ENGINE_INVALID_ID;
 		}
 		if (m_textEBO != ENGINE_INVALID_ID) {
-			glDeleteTextures(1, &m_textEBO);
+			device->DeleteBuffer(m_textEBO);
 			m_textEBO = ENGINE_INVALID_ID;
 		}
 	}
 
 	void FontManager::DrawQuad(const TextQuad& quad) {
-		glBindVertexArray(m_textVAO);
-
-		// Quad-Daten hochladen (dynamisch)
-		glBindBuffer(GL_ARRAY_BUFFER, m_textVBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(quad.vertices), quad.vertices);
-
-		// Zeichnen
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
+		RenderDevice* device = Renderer::GetDevice();
+		device->UpdateBufferData(m_textVBO, BufferType::Vertex, quad.vertices, sizeof(quad.vertices), 0);
+		device->DrawIndexed(m_textVAO, 6);
 	}
 	
 }
\ No newline at end of file
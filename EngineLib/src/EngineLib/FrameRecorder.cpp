@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <CoreLib/File.h>
+#include <CoreLib/Log.h>
+
+#include "EngineLib/FrameRecorder.h"
+
+namespace EngineCore {
+
+    void FrameRecorder::Reserve(size_t frameCount) {
+        m_frames.reserve(frameCount);
+    }
+
+    void FrameRecorder::Clear() {
+        m_frames.clear();
+        m_phaseNames.clear();
+    }
+
+    void FrameRecorder::Record(uint64_t index, double time, double frameTime, const std::vector<Profiler::FrameZone>& zones, const RenderStats& renderStats) {
+        Frame& frame = m_frames.emplace_back();
+        frame.index = index;
+        frame.time = time;
+        frame.frameTime = frameTime;
+        frame.renderStats = renderStats;
+        frame.phaseTimes.assign(m_phaseNames.size(), 0.0);
+
+        for (const auto& zone : zones) {
+            if (zone.threadIndex != 0 || zone.depth > MAX_PHASE_DEPTH)
+                continue;
+
+            size_t phase = GetPhaseIndex(zone.name);
+            if (phase >= frame.phaseTimes.size())
+                frame.phaseTimes.resize(phase + 1, 0.0);
+            // the same zone name under different parents is summed up
+            frame.phaseTimes[phase] += zone.time;
+        }
+    }
+
+    const std::vector<FrameRecorder::Frame>& FrameRecorder::GetFrames() const {
+        return m_frames;
+    }
+
+    const std::vector<std::string>& FrameRecorder::GetPhaseNames() const {
+        return m_phaseNames;
+    }
+
+    FrameRecorder::Summary FrameRecorder::GetSummary() const {
+        std::vector<double> values;
+        values.reserve(m_frames.size());
+        for (const auto& frame : m_frames)
+            values.push_back(frame.frameTime);
+        return CreateSummary(std::move(values));
+    }
+
+    FrameRecorder::Summary FrameRecorder::GetPhaseSummary(const std::string& phaseName) const {
+        auto it = std::find(m_phaseNames.begin(), m_phaseNames.end(), phaseName);
+        if (it == m_phaseNames.end())
+            return Summary{};
+
+        size_t phase = static_cast<size_t>(it - m_phaseNames.begin());
+        std::vector<double> values;
+        values.reserve(m_frames.size());
+        for (const auto& frame : m_frames)
+            values.push_back((phase < frame.phaseTimes.size()) ? frame.phaseTimes[phase] : 0.0);
+        return CreateSummary(std::move(values));
+    }
+
+    std::vector<FrameRecorder::Metric> FrameRecorder::GetMetrics() const {
+        std::vector<Metric> metrics;
+        if (m_frames.empty())
+            return metrics;
+
+        Summary summary = GetSummary();
+        metrics.push_back({ "frame_avg_ms", summary.average * 1000.0 });
+        metrics.push_back({ "frame_p95_ms", summary.p95 * 1000.0 });
+
+        for (const auto& name : m_phaseNames)
+            metrics.push_back({ name + "_avg_ms", GetPhaseSummary(name).average * 1000.0 });
+
+        double commands = 0.0;
+        double drawCalls = 0.0;
+        double instances = 0.0;
+        for (const auto& frame : m_frames) {
+            commands += static_cast<double>(frame.renderStats.commands);
+            drawCalls += static_cast<double>(frame.renderStats.drawCalls);
+            instances += static_cast<double>(frame.renderStats.instances);
+        }
+        double frameCount = static_cast<double>(m_frames.size());
+        metrics.push_back({ "commands", commands / frameCount });
+        metrics.push_back({ "draw_calls", drawCalls / frameCount });
+        metrics.push_back({ "instances", instances / frameCount });
+        return metrics;
+    }
+
+    bool FrameRecorder::WriteCSV(const std::string& path) const {
+        std::string csv = "frame,time,frame_ms,commands,draw_calls,instances";
+        for (const auto& name : m_phaseNames)
+            csv += "," + name + "_ms";
+        csv += '\n';
+
+        char buffer[128];
+        for (const auto& frame : m_frames) {
+            std::snprintf(buffer, sizeof(buffer), "%llu,%.6f,%.6f,%zu,%zu,%zu",
+                static_cast<unsigned long long>(frame.index), frame.time, frame.frameTime * 1000.0,
+                frame.renderStats.commands, frame.renderStats.drawCalls, frame.renderStats.instances);
+            csv += buffer;
+
+            for (size_t i = 0; i < m_phaseNames.size(); i++) {
+                double phaseTime = (i < frame.phaseTimes.size()) ? frame.phaseTimes[i] : 0.0;
+                std::snprintf(buffer, sizeof(buffer), ",%.6f", phaseTime * 1000.0);
+                csv += buffer;
+            }
+            csv += '\n';
+        }
+
+        return WriteFile(path, csv);
+    }
+
+    static void AppendSummary(std::string& json, const FrameRecorder::Summary& summary) {
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer), "{\"frames\":%zu,\"avg_ms\":%.6f,\"p50_ms\":%.6f,\"p95_ms\":%.6f,\"p99_ms\":%.6f,\"max_ms\":%.6f}",
+            summary.frameCount, summary.average * 1000.0, summary.p50 * 1000.0, summary.p95 * 1000.0,
+            summary.p99 * 1000.0, summary.max * 1000.0);
+        json += buffer;
+    }
+
+    bool FrameRecorder::WriteJson(const std::string& path) const {
+        // phase names are engine zone names (identifiers, no escaping needed)
+        std::string json = "{\n\"summary\":";
+        AppendSummary(json, GetSummary());
+
+        json += ",\n\"phases\":{";
+        for (size_t i = 0; i < m_phaseNames.size(); i++) {
+            json += (i > 0) ? ",\n" : "\n";
+            json += "\"" + m_phaseNames[i] + "\":";
+            AppendSummary(json, GetPhaseSummary(m_phaseNames[i]));
+        }
+
+        json += "},\n\"metrics\":";
+        AppendMetrics(json, GetMetrics());
+
+        json += ",\n\"frames\":[";
+        char buffer[128];
+        for (size_t f = 0; f < m_frames.size(); f++) {
+            const Frame& frame = m_frames[f];
+            std::snprintf(buffer, sizeof(buffer), "%s\n{\"frame\":%llu,\"time\":%.6f,\"frame_ms\":%.6f,\"commands\":%zu,\"draw_calls\":%zu,\"instances\":%zu,\"phases_ms\":[",
+                (f > 0) ? "," : "", static_cast<unsigned long long>(frame.index), frame.time, frame.frameTime * 1000.0,
+                frame.renderStats.commands, frame.renderStats.drawCalls, frame.renderStats.instances);
+            json += buffer;
+
+            for (size_t i = 0; i < m_phaseNames.size(); i++) {
+                double phaseTime = (i < frame.phaseTimes.size()) ? frame.phaseTimes[i] : 0.0;
+                std::snprintf(buffer, sizeof(buffer), "%s%.6f", (i > 0) ? "," : "", phaseTime * 1000.0);
+                json += buffer;
+            }
+            json += "]}";
+        }
+        json += "\n]\n}\n";
+
+        return WriteFile(path, json);
+    }
+
+    bool FrameRecorder::WriteBaseline(const std::string& path) const {
+        std::string json = "{\n\"metrics\":";
+        AppendMetrics(json, GetMetrics());
+        json += "\n}\n";
+        return WriteFile(path, json);
+    }
+
+    bool FrameRecorder::LoadBaseline(const std::string& path, std::unordered_map<std::string, double>& outBaseline) {
+        File file(path);
+        std::string content;
+        if (!file.Open(FILE_READ) || !file.ReadAll(content)) {
+            Log::Error("FrameRecorder: Could not read baseline '{}'", path);
+            return false;
+        }
+
+        // only understands the flat "metrics" object that AppendMetrics writes: "name":value pairs
+        size_t pos = content.find("\"metrics\"");
+        size_t objStart = (pos != std::string::npos) ? content.find('{', pos) : std::string::npos;
+        size_t objEnd = (objStart != std::string::npos) ? content.find('}', objStart) : std::string::npos;
+        if (objEnd == std::string::npos) {
+            Log::Error("FrameRecorder: Baseline '{}' has no metrics", path);
+            return false;
+        }
+
+        pos = objStart;
+        while ((pos = content.find('"', pos + 1)) != std::string::npos && pos < objEnd) {
+            size_t nameEnd = content.find('"', pos + 1);
+            size_t valueStart = content.find(':', nameEnd);
+            size_t valueEnd = content.find_first_of(",}", valueStart);
+            if (nameEnd == std::string::npos || valueStart == std::string::npos || valueEnd == std::string::npos)
+                break;
+
+            std::string name = content.substr(pos + 1, nameEnd - pos - 1);
+            try {
+                outBaseline[name] = std::stod(content.substr(valueStart + 1, valueEnd - valueStart - 1));
+            }
+            catch (const std::exception&) {
+                Log::Warn("FrameRecorder: Baseline metric '{}' has an invalid value", name);
+            }
+            pos = valueEnd;
+        }
+
+        return !outBaseline.empty();
+    }
+
+    std::vector<FrameRecorder::Comparison> FrameRecorder::CompareWithBaseline(const std::unordered_map<std::string, double>& baseline, double threshold) const {
+        std::vector<Comparison> comparisons;
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer), "%-40s %12s %12s %9s", "metric", "baseline", "current", "change");
+        Log::Info("FrameRecorder: {}", std::string(buffer));
+
+        for (const auto& metric : GetMetrics()) {
+            auto it = baseline.find(metric.name);
+            if (it == baseline.end() || it->second <= 0.0)
+                continue;
+
+            Comparison& c = comparisons.emplace_back();
+            c.name = metric.name;
+            c.baseline = it->second;
+            c.current = metric.value;
+            c.ratio = c.current / c.baseline;
+            c.isRegression = c.ratio > 1.0 + threshold && c.current - c.baseline > MIN_REGRESSION_DELTA;
+
+            std::snprintf(buffer, sizeof(buffer), "%-40s %12.4f %12.4f %+8.1f%% %s",
+                c.name.c_str(), c.baseline, c.current, (c.ratio - 1.0) * 100.0, c.isRegression ? "REGRESSION" : "");
+            if (c.isRegression)
+                Log::Error("FrameRecorder: {}", std::string(buffer));
+            else
+                Log::Info("FrameRecorder: {}", std::string(buffer));
+        }
+        return comparisons;
+    }
+
+    size_t FrameRecorder::GetPhaseIndex(const char* name) {
+        for (size_t i = 0; i < m_phaseNames.size(); i++) {
+            if (std::strcmp(m_phaseNames[i].c_str(), name) == 0)
+                return i;
+        }
+        m_phaseNames.emplace_back(name);
+        return m_phaseNames.size() - 1;
+    }
+
+    FrameRecorder::Summary FrameRecorder::CreateSummary(std::vector<double> values) {
+        Summary summary;
+        summary.frameCount = values.size();
+        if (values.empty())
+            return summary;
+
+        std::sort(values.begin(), values.end());
+        double sum = 0.0;
+        for (double value : values)
+            sum += value;
+
+        // nearest rank
+        auto percentile = [&values](double p) {
+            size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size())));
+            return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+        };
+
+        summary.average = sum / static_cast<double>(values.size());
+        summary.p50 = percentile(0.50);
+        summary.p95 = percentile(0.95);
+        summary.p99 = percentile(0.99);
+        summary.max = values.back();
+        return summary;
+    }
+
+    void FrameRecorder::AppendMetrics(std::string& json, const std::vector<Metric>& metrics) {
+        char buffer[64];
+        json += "{";
+        for (size_t i = 0; i < metrics.size(); i++) {
+            std::snprintf(buffer, sizeof(buffer), ":%.6f", metrics[i].value);
+            json += (i > 0) ? ",\n\"" : "\n\"";
+            json += metrics[i].name + "\"" + buffer;
+        }
+        json += "\n}";
+    }
+
+    bool FrameRecorder::WriteFile(const std::string& path, const std::string& content) {
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        if (!directory.empty())
+            File::CreateDir(directory);
+
+        File file(path);
+        if (!file.Open(FILE_WRITE)) {
+            Log::Error("FrameRecorder: Could not open '{}' for writing", path);
+            return false;
+        }
+        bool ok = file.Write(content);
+        file.Close();
+        return ok;
+    }
+
+}
@@ -0,0 +1,38 @@
+#include <cmath>
+#include <CoreLib/Math/Matrix4x4.h>
+
+#include "EngineLib/Frustum.h"
+
+namespace EngineCore {
+
+    void Frustum::Set(const Matrix4x4& viewProjection) {
+        // rows of the row-major matrix (Gribb/Hartmann)
+        const float* m = viewProjection.GetData();
+        Vector4 row0(m[0], m[1], m[2], m[3]);
+        Vector4 row1(m[4], m[5], m[6], m[7]);
+        Vector4 row2(m[8], m[9], m[10], m[11]);
+        Vector4 row3(m[12], m[13], m[14], m[15]);
+
+        m_planes[0] = row3 + row0;
+        m_planes[1] = row3 - row0;
+        m_planes[2] = row3 + row1;
+        m_planes[3] = row3 - row1;
+        m_planes[4] = row3 + row2;
+        m_planes[5] = row3 - row2;
+
+        for (auto& plane : m_planes) {
+            float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f)
+                plane = plane / length;
+        }
+    }
+
+    bool Frustum::IntersectsSphere(const Vector3& center, float radius) const {
+        for (const auto& plane : m_planes) {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,454 @@
+#include <cstdint>
+#include <cstring>
+#include <glad/glad.h>
+#include <CoreLib/Log.h>
+
+#include "EngineLib/GLRenderDevice.h"
+
+namespace EngineCore {
+
+    static GLenum ToGLTarget(BufferType type) {
+        return (type == BufferType::Index) ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+    }
+
+    static GLenum ToGLUsage(BufferUsage usage) {
+        return (usage == BufferUsage::Dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+    }
+
+    GpuHandle GLRenderDevice::CreateBuffer(BufferType type, const void* data, size_t size, BufferUsage usage) {
+        GpuHandle buffer = 0;
+        glGenBuffers(1, &buffer);
+        SetBufferData(buffer, type, data, size, usage);
+        return buffer;
+    }
+
+    void GLRenderDevice::SetBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, BufferUsage usage) {
+        GLenum target = ToGLTarget(type);
+        glBindBuffer(target, buffer);
+        glBufferData(target, static_cast<GLsizeiptr>(size), data, ToGLUsage(usage));
+    }
+
+    void GLRenderDevice::UpdateBufferData(GpuHandle buffer, BufferType type, const void* data, size_t size, size_t offset) {
+        GLenum target = ToGLTarget(type);
+        glBindBuffer(target, buffer);
+        glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    }
+
+    void GLRenderDevice::DeleteBuffer(GpuHandle buffer) {
+        if (buffer != 0)
+            glDeleteBuffers(1, &buffer);
+    }
+
+    GpuHandle GLRenderDevice::CreateVertexArray(const std::vector<VertexAttribute>& attributes, GpuHandle indexBuffer) {
+        GpuHandle vertexArray = 0;
+        glGenVertexArrays(1, &vertexArray);
+        glBindVertexArray(vertexArray);
+
+        // the element buffer binding is part of the vertex array state
+        if (indexBuffer != 0)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+        for (const auto& attribute : attributes) {
+            glBindBuffer(GL_ARRAY_BUFFER, attribute.buffer);
+            glEnableVertexAttribArray(attribute.location);
+            glVertexAttribPointer(attribute.location, attribute.components, GL_FLOAT, GL_FALSE,
+                static_cast<GLsizei>(attribute.stride), reinterpret_cast<void*>(attribute.offset));
+            if (attribute.perInstance)
+                glVertexAttribDivisor(attribute.location, 1);
+        }
+
+        glBindVertexArray(0);
+        return vertexArray;
+    }
+
+    void GLRenderDevice::DeleteVertexArray(GpuHandle vertexArray) {
+        if (vertexArray != 0)
+            glDeleteVertexArrays(1, &vertexArray);
+    }
+
+    GpuHandle GLRenderDevice::CreateTexture2D(const TextureDesc& desc, const unsigned char* data) {
+        GLenum dataFormat, internalFormat;
+        if (desc.channels == 1) {
+            dataFormat = GL_RED;
+            internalFormat = GL_R8;
+        }
+        else if (desc.channels == 3) {
+            dataFormat = GL_RGB;
+            internalFormat = GL_RGB8;
+        }
+        else if (desc.channels == 4) {
+            dataFormat = GL_RGBA;
+            internalFormat = GL_RGBA8;
+        }
+        else {
+            return 0;
+        }
+
+        GpuHandle texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        if (m_activeUnit < m_boundTextures.size())
+            m_boundTextures[m_activeUnit] = texture;
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, desc.wrapX);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, desc.wrapY);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filterMin);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filterMag);
+
+        int rowBytes = desc.width * desc.channels;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, (rowBytes % 4 != 0) ? 1 : 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, desc.width, desc.height, 0,
+            dataFormat, GL_UNSIGNED_BYTE, data);
+
+        if (desc.mipmaps)
+            glGenerateMipmap(GL_TEXTURE_2D);
+        return texture;
+    }
+
+    void GLRenderDevice::UpdateTexture2D(GpuHandle texture, int x, int y, int width, int height, int channels, const unsigned char* data) {
+        GLenum dataFormat;
+        if (channels == 1)
+            dataFormat = GL_RED;
+        else if (channels == 3)
+            dataFormat = GL_RGB;
+        else if (channels == 4)
+            dataFormat = GL_RGBA;
+        else
+            return;
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        if (m_activeUnit < m_boundTextures.size())
+            m_boundTextures[m_activeUnit] = texture;
+
+        int rowBytes = width * channels;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, (rowBytes % 4 != 0) ? 1 : 4);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, dataFormat, GL_UNSIGNED_BYTE, data);
+    }
+
+    void GLRenderDevice::DeleteTexture(GpuHandle texture) {
+        if (texture == 0)
+            return;
+        glDeleteTextures(1, &texture);
+        for (auto& bound : m_boundTextures) {
+            if (bound == texture)
+                bound = 0;
+        }
+    }
+
+    void GLRenderDevice::BindTexture(unsigned int unit, GpuHandle texture) {
+        SetActiveUnit(unit);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        if (unit >= m_boundTextures.size())
+            m_boundTextures.resize(unit + 1, 0);
+        m_boundTextures[unit] = texture;
+    }
+
+    GpuHandle GLRenderDevice::GetBoundTexture(unsigned int unit) const {
+        return (unit < m_boundTextures.size()) ? m_boundTextures[unit] : 0;
+    }
+
+    unsigned int GLRenderDevice::GetMaxTextureUnits() const {
+        GLint maxUnits = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+        return static_cast<unsigned int>(maxUnits);
+    }
+
+    GpuHandle GLRenderDevice::CreateFramebuffer(int width, int height) {
+        GpuHandle framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+        FramebufferAttachments attachments;
+        glGenTextures(1, &attachments.color);
+        glBindTexture(GL_TEXTURE_2D, attachments.color);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, attachments.color, 0);
+        // restore the texture the active unit had
+        glBindTexture(GL_TEXTURE_2D, GetBoundTexture(m_activeUnit));
+
+        glGenRenderbuffers(1, &attachments.depthStencil);
+        glBindRenderbuffer(GL_RENDERBUFFER, attachments.depthStencil);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, attachments.depthStencil);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_boundFramebuffer);
+        m_framebuffers[framebuffer] = attachments;
+
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            Log::Error("GLRenderDevice: Framebuffer {}x{} is incomplete (status {})", width, height, static_cast<unsigned int>(status));
+            DeleteFramebuffer(framebuffer);
+            return 0;
+        }
+        return framebuffer;
+    }
+
+    GpuHandle GLRenderDevice::CreateTextureFramebuffer(GpuHandle colorTexture, int width, int height) {
+        GpuHandle framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_boundFramebuffer);
+
+        FramebufferAttachments attachments;
+        attachments.color = colorTexture;
+        attachments.ownsColor = false;
+        m_framebuffers[framebuffer] = attachments;
+
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            Log::Error("GLRenderDevice: Framebuffer {}x{} of texture {} is incomplete (status {})", width, height, colorTexture, static_cast<unsigned int>(status));
+            DeleteFramebuffer(framebuffer);
+            return 0;
+        }
+        return framebuffer;
+    }
+
+    void GLRenderDevice::DeleteFramebuffer(GpuHandle framebuffer) {
+        auto it = m_framebuffers.find(framebuffer);
+        if (it == m_framebuffers.end())
+            return;
+
+        if (m_boundFramebuffer == framebuffer)
+            BindFramebuffer(0);
+        glDeleteFramebuffers(1, &framebuffer);
+        if (it->second.depthStencil != 0)
+            glDeleteRenderbuffers(1, &it->second.depthStencil);
+        if (it->second.ownsColor)
+            DeleteTexture(it->second.color);
+        m_framebuffers.erase(it);
+    }
+
+    void GLRenderDevice::BindFramebuffer(GpuHandle framebuffer) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        m_boundFramebuffer = framebuffer;
+    }
+
+    void GLRenderDevice::SetViewport(int x, int y, int width, int height) {
+        glViewport(x, y, width, height);
+    }
+
+    void GLRenderDevice::SetScissor(bool enabled, int x, int y, int width, int height) {
+        if (!enabled) {
+            glDisable(GL_SCISSOR_TEST);
+            return;
+        }
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x, y, width, height);
+    }
+
+    GpuHandle GLRenderDevice::CreateReadbackBuffer(size_t size) {
+        GpuHandle buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return buffer;
+    }
+
+    void GLRenderDevice::DeleteReadbackBuffer(GpuHandle readbackBuffer) {
+        if (readbackBuffer == 0)
+            return;
+        DeleteReadbackFence(readbackBuffer);
+        glDeleteBuffers(1, &readbackBuffer);
+    }
+
+    void GLRenderDevice::ReadPixelsAsync(GpuHandle framebuffer, int width, int height, GpuHandle readbackBuffer) {
+        // with a pack buffer bound glReadPixels only queues the copy
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_boundFramebuffer);
+
+        DeleteReadbackFence(readbackBuffer);
+        m_readbackFences[readbackBuffer] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        // without a flush the fence may never reach the GPU
+        glFlush();
+    }
+
+    bool GLRenderDevice::IsReadbackReady(GpuHandle readbackBuffer) {
+        auto it = m_readbackFences.find(readbackBuffer);
+        if (it == m_readbackFences.end())
+            return true;
+
+        GLenum result = glClientWaitSync(static_cast<GLsync>(it->second), 0, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    bool GLRenderDevice::ReadReadbackBuffer(GpuHandle readbackBuffer, void* outData, size_t size) {
+        auto it = m_readbackFences.find(readbackBuffer);
+        if (it != m_readbackFences.end()) {
+            GLenum result = glClientWaitSync(static_cast<GLsync>(it->second), GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+            DeleteReadbackFence(readbackBuffer);
+            if (result == GL_WAIT_FAILED) {
+                Log::Error("GLRenderDevice: Waiting for readback buffer {} failed", readbackBuffer);
+                return false;
+            }
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffer);
+        void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT);
+        bool ok = mapped != nullptr;
+        if (ok) {
+            std::memcpy(outData, mapped, size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        else {
+            Log::Error("GLRenderDevice: Could not map readback buffer {}", readbackBuffer);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return ok;
+    }
+
+    void GLRenderDevice::DeleteReadbackFence(GpuHandle readbackBuffer) {
+        auto it = m_readbackFences.find(readbackBuffer);
+        if (it == m_readbackFences.end())
+            return;
+        glDeleteSync(static_cast<GLsync>(it->second));
+        m_readbackFences.erase(it);
+    }
+
+    GpuHandle GLRenderDevice::CreateProgram(const std::string& vertexCode, const std::string& fragmentCode) {
+        GpuHandle vertex = CompileShader(GL_VERTEX_SHADER, vertexCode, "VERTEX");
+        GpuHandle fragment = CompileShader(GL_FRAGMENT_SHADER, fragmentCode, "FRAGMENT");
+
+        GpuHandle program = glCreateProgram();
+        glAttachShader(program, vertex);
+        glAttachShader(program, fragment);
+        glLinkProgram(program);
+
+        int success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            char infoLog[512];
+            glGetProgramInfoLog(program, 512, NULL, infoLog);
+            Log::Error("GLRenderDevice: PROGRAM::LINKING_FAILED\n{}", infoLog);
+        }
+
+        // the shaders are linked into the program and no longer necessary
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+        return program;
+    }
+
+    GpuHandle GLRenderDevice::CompileShader(unsigned int stage, const std::string& code, const char* stageName) {
+        const char* source = code.c_str();
+        GpuHandle shader = glCreateShader(stage);
+        glShaderSource(shader, 1, &source, NULL);
+        glCompileShader(shader);
+
+        int success;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            char infoLog[512];
+            glGetShaderInfoLog(shader, 512, NULL, infoLog);
+            Log::Error("GLRenderDevice: {}::COMPILATION_FAILED\n{}", stageName, infoLog);
+        }
+        return shader;
+    }
+
+    void GLRenderDevice::DeleteProgram(GpuHandle program) {
+        if (program == 0)
+            return;
+        glDeleteProgram(program);
+        if (m_currentProgram == program)
+            m_currentProgram = 0;
+    }
+
+    void GLRenderDevice::UseProgram(GpuHandle program) {
+        glUseProgram(program);
+        m_currentProgram = program;
+    }
+
+    GpuHandle GLRenderDevice::GetCurrentProgram() const {
+        return m_currentProgram;
+    }
+
+    int GLRenderDevice::GetUniformLocation(GpuHandle program, const std::string& name) {
+        return glGetUniformLocation(program, name.c_str());
+    }
+
+    void GLRenderDevice::SetUniformInt(int location, int value) {
+        glUniform1i(location, value);
+    }
+
+    void GLRenderDevice::SetUniformFloats(int location, const float* values, int components) {
+        switch (components) {
+        case 1: glUniform1f(location, values[0]); break;
+        case 2: glUniform2f(location, values[0], values[1]); break;
+        case 3: glUniform3f(location, values[0], values[1], values[2]); break;
+        case 4: glUniform4f(location, values[0], values[1], values[2], values[3]); break;
+        default:
+            Log::Warn("GLRenderDevice: Invalid uniform component count {}", components);
+            break;
+        }
+    }
+
+    void GLRenderDevice::SetUniformMatrix(int location, int columns, int rows, const float* data) {
+        switch (columns * 10 + rows) {
+        case 22: glUniformMatrix2fv(location, 1, GL_FALSE, data); break;
+        case 33: glUniformMatrix3fv(location, 1, GL_FALSE, data); break;
+        case 44: glUniformMatrix4fv(location, 1, GL_FALSE, data); break;
+        case 23: glUniformMatrix2x3fv(location, 1, GL_FALSE, data); break;
+        case 32: glUniformMatrix3x2fv(location, 1, GL_FALSE, data); break;
+        case 24: glUniformMatrix2x4fv(location, 1, GL_FALSE, data); break;
+        case 42: glUniformMatrix4x2fv(location, 1, GL_FALSE, data); break;
+        case 34: glUniformMatrix3x4fv(location, 1, GL_FALSE, data); break;
+        case 43: glUniformMatrix4x3fv(location, 1, GL_FALSE, data); break;
+        default:
+            Log::Warn("GLRenderDevice: Invalid uniform matrix size {}x{}", columns, rows);
+            break;
+        }
+    }
+
+    void GLRenderDevice::SetDepthTest(bool enabled) {
+        if (enabled)
+            glEnable(GL_DEPTH_TEST);
+        else
+            glDisable(GL_DEPTH_TEST);
+    }
+
+    void GLRenderDevice::SetFrontFace(FrontFace frontFace) {
+        glFrontFace((frontFace == FrontFace::Clockwise) ? GL_CW : GL_CCW);
+    }
+
+    void GLRenderDevice::SetBlendMode(BlendMode mode) {
+        if (mode == BlendMode::Layer)
+            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        else
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    void GLRenderDevice::ClearDepth() {
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
+
+    void GLRenderDevice::ClearColor(float r, float g, float b, float a) {
+        glClearColor(r, g, b, a);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    void GLRenderDevice::DrawIndexed(GpuHandle vertexArray, int indexCount) {
+        glBindVertexArray(vertexArray);
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+    }
+
+    void GLRenderDevice::DrawIndexedInstanced(GpuHandle vertexArray, int indexCount, int instanceCount) {
+        glBindVertexArray(vertexArray);
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, instanceCount);
+    }
+
+    void GLRenderDevice::SetActiveUnit(unsigned int unit) {
+        // always set, other GL code (ImGui) can change the active unit
+        glActiveTexture(GL_TEXTURE0 + unit);
+        m_activeUnit = unit;
+    }
+
+}
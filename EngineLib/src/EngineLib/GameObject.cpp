@@ -76,6 +76,10 @@ namespace EngineCore {
 		m_gameObjectManager->SetMainCamera(camera);
 	}
 
+	const std::vector<std::weak_ptr<Component::Camera>>& GameObject::GetCameras() {
+		return m_gameObjectManager->m_cameras;
+	}
+
 	#pragma endregion
 
 	std::shared_ptr<GameObject> GameObject::Get(GameObjectID id) {
@@ -398,7 +402,7 @@ namespace EngineCore {
 
 	bool GameObject::IsDead(const std::string& msg) const {
 		if (!m_alive) {
-			Log::Warn("GameObject: {}, GameObject '{}({})' was deleted!", msg, m_name, m_id.value);
+			Log::Limited::Warn("GameObject: {}, GameObject '{}({})' was deleted!", msg, m_name, m_id.value);
 			return true;
 		}
 		return false;
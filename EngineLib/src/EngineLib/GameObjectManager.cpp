@@ -4,6 +4,7 @@
 
 #include "EngineLib/Time.h"
 #include "EngineLib/Renderer.h"
+#include "EngineLib/Profiler.h"
 #include "EngineLib/EngineTypes.h"
 #include "EngineLib/GameObjectManager.h"
 
@@ -35,6 +36,7 @@ namespace EngineCore {
 	}
 
 	void GameObjectManager::SendDrawCommands() {
+		ENGINE_PROFILE_ZONE("GameObjects::SendDrawCommands");
 		static Renderer* renderer = Renderer::GetInstance();
 		renderer->ReserveCommands(m_gameObjects.size());
 		for (auto& go : m_gameObjects) {
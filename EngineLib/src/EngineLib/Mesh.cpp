@@ -1,12 +1,10 @@
-#define GLAD_GL_IMPLEMENTATION
-#include <glad/glad.h>
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <CoreLib\Log.h>
-#include <CoreLib\Math\Matrix4x4.h>
 
 #include "EngineLib\Vertex.h"
+#include "EngineLib\Renderer.h"
 #include "EngineLib\Mesh.h"
 
 
@@ -31,7 +29,8 @@ namespace EngineCore {
             m_indices.clear();
         }
 
-        m_indexCount = static_cast<GLsizei>(m_indices.size());
+        m_indexCount = static_cast<int>(m_indices.size());
+        CalculateBoundingSphere();
         CreateGL();
     }
 
@@ -39,79 +38,79 @@ namespace EngineCore {
        DeleteGL();
     }
 
-    void Mesh::DrawInstanced(int instanceCount, const std::vector<Matrix4x4>& matrices) {
-        if (!m_exists) {
-            CreateGL();
+    const Vector4& Mesh::GetBoundingSphere() const {
+        return m_boundingSphere;
+    }
+
+    void Mesh::CalculateBoundingSphere() {
+        if (m_vertices.empty()) {
+            m_boundingSphere.Set(0, 0, 0, -1);
+            return;
+        }
+
+        // center of the bounding box, radius to the farthest vertex
+        Vector3 min = m_vertices[0].position;
+        Vector3 max = m_vertices[0].position;
+        for (const auto& vertex : m_vertices) {
+            min.Set(std::min(min.x, vertex.position.x), std::min(min.y, vertex.position.y), std::min(min.z, vertex.position.z));
+            max.Set(std::max(max.x, vertex.position.x), std::max(max.y, vertex.position.y), std::max(max.z, vertex.position.z));
         }
+        Vector3 center = (min + max) * 0.5f;
 
-        std::vector<float> glMatrices;
-        glMatrices.reserve(instanceCount * 16);
-        for (const auto& m : matrices) {
-            const float* data = m.ToOpenGLData();
-            glMatrices.insert(glMatrices.end(), data, data + 16);
+        float radiusSquared = 0.0f;
+        for (const auto& vertex : m_vertices) {
+            radiusSquared = std::max(radiusSquared, Vector3::SquaredDistance(center, vertex.position));
         }
+        m_boundingSphere.Set(center.x, center.y, center.z, std::sqrt(radiusSquared));
+    }
 
-        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
-        glBufferData(GL_ARRAY_BUFFER, glMatrices.size() * sizeof(float), glMatrices.data(), GL_DYNAMIC_DRAW);
+    void Mesh::DrawInstanced(const std::vector<InstanceData>& instances) {
+        if (!m_exists) {
+            CreateGL();
+        }
 
-        glBindVertexArray(m_vao);
-        glDrawElementsInstanced(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0, instanceCount);
+        RenderDevice* device = Renderer::GetDevice();
+        device->SetBufferData(m_instanceVBO, BufferType::Vertex, instances.data(), instances.size() * sizeof(InstanceData), BufferUsage::Dynamic);
+        device->DrawIndexedInstanced(m_vao, m_indexCount, static_cast<int>(instances.size()));
     }
 
     void Mesh::CreateGL() {
         if (m_exists) return;
 
-        glGenVertexArrays(1, &m_vao);
-        glGenBuffers(1, &m_vbo);
-        glGenBuffers(1, &m_ebo);
-
-        glBindVertexArray(m_vao);
-
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_STATIC_DRAW);
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(unsigned int), m_indices.data(), GL_STATIC_DRAW);
-
-        // Attribute setzen (Position, UV, Normals etc.)
-        GLsizei vertexSize = 8 * sizeof(float);
-        // position attribute
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertexSize, (void*)0);
-        glEnableVertexAttribArray(0);
-        // UV attribute
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, vertexSize, (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        // Normal attribute
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, vertexSize, (void*)(5 * sizeof(float)));
-        glEnableVertexAttribArray(2);
-
-        // Instance buffer fort modelMatrix (4x4)
-        glGenBuffers(1, &m_instanceVBO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
-        // reserve data (fill later)
-        glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
-
-        // Attribut-Location 3..6 fr die Matrix-Spalten
-        size_t vec4Size = sizeof(float) * 4;
-        size_t mat4Size = sizeof(float) * 16;
-
-        for (int i = 0; i < 4; i++) {
-            glEnableVertexAttribArray(3 + i);
-            glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE,static_cast<GLsizei>(mat4Size), (void*)(i * vec4Size));
-            glVertexAttribDivisor(3 + i, 1); // per instance
-        }
-
-        glBindVertexArray(0);
+        RenderDevice* device = Renderer::GetDevice();
+        m_vbo = device->CreateBuffer(BufferType::Vertex, m_vertices.data(), m_vertices.size() * sizeof(Vertex), BufferUsage::Static);
+        m_ebo = device->CreateBuffer(BufferType::Index, m_indices.data(), m_indices.size() * sizeof(unsigned int), BufferUsage::Static);
+        // Instance buffer for the InstanceData, filled by DrawInstanced
+        m_instanceVBO = device->CreateBuffer(BufferType::Vertex, nullptr, 0, BufferUsage::Dynamic);
 
+        size_t vertexSize = 8 * sizeof(float);
+        size_t vec4Size = sizeof(float) * 4;
+        size_t instanceSize = sizeof(InstanceData);
+        std::vector<VertexAttribute> attributes = {
+            { 0, 3, vertexSize, 0, m_vbo, false },                  // position
+            { 1, 2, vertexSize, 3 * sizeof(float), m_vbo, false },  // UV
+            { 2, 3, vertexSize, 5 * sizeof(float), m_vbo, false },  // normal
+        };
+        // locations 3..6 are the matrix columns, 7..10 the vec4 properties (see InstanceData)
+        for (unsigned int i = 0; i < 4; i++)
+            attributes.push_back({ 3 + i, 4, instanceSize, i * vec4Size, m_instanceVBO, true });
+        attributes.push_back({ 7, 4, instanceSize, offsetof(InstanceData, color), m_instanceVBO, true });
+        attributes.push_back({ 8, 4, instanceSize, offsetof(InstanceData, uvRect), m_instanceVBO, true });
+        attributes.push_back({ 9, 4, instanceSize, offsetof(InstanceData, params), m_instanceVBO, true });
+        attributes.push_back({ 10, 4, instanceSize, offsetof(InstanceData, custom), m_instanceVBO, true });
+
+        m_vao = device->CreateVertexArray(attributes, m_ebo);
         m_exists = true;
     }
 
     void Mesh::DeleteGL() {
         if (!m_exists) return;
 
-        glDeleteVertexArrays(1, &m_vao);
-        glDeleteBuffers(1, &m_vbo);
-        glDeleteBuffers(1, &m_ebo);
+        RenderDevice* device = Renderer::GetDevice();
+        device->DeleteVertexArray(m_vao);
+        device->DeleteBuffer(m_vbo);
+        device->DeleteBuffer(m_ebo);
+        device->DeleteBuffer(m_instanceVBO);
 
         m_exists = false;
     }
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstring>
+#include <CoreLib/Log.h>
+
+#include "EngineLib/Renderer.h"
+#include "EngineLib/OffscreenTarget.h"
+
+namespace EngineCore {
+
+    OffscreenTarget::~OffscreenTarget() {
+        Destroy();
+    }
+
+    bool OffscreenTarget::Create(int width, int height, size_t readbackBufferCount) {
+        Destroy();
+        if (width <= 0 || height <= 0) {
+            Log::Error("OffscreenTarget: Invalid size {}x{}", width, height);
+            return false;
+        }
+
+        RenderDevice* device = Renderer::GetDevice();
+        m_framebuffer = device->CreateFramebuffer(width, height);
+        if (m_framebuffer == 0)
+            return false;
+
+        m_width = width;
+        m_height = height;
+
+        m_slots.resize(std::max<size_t>(readbackBufferCount, 1));
+        for (auto& slot : m_slots)
+            slot.buffer = device->CreateReadbackBuffer(GetFrameSize());
+        m_nextSlot = 0;
+
+        m_frame.pixels.resize(GetFrameSize());
+        m_rowBuffer.resize(static_cast<size_t>(m_width) * 4);
+        return true;
+    }
+
+    void OffscreenTarget::Destroy() {
+        if (!IsValid())
+            return;
+
+        RenderDevice* device = Renderer::GetDevice();
+        for (auto& slot : m_slots)
+            device->DeleteReadbackBuffer(slot.buffer);
+        m_slots.clear();
+
+        device->DeleteFramebuffer(m_framebuffer);
+        m_framebuffer = 0;
+        m_width = 0;
+        m_height = 0;
+    }
+
+    bool OffscreenTarget::Resize(int width, int height) {
+        if (width == m_width && height == m_height)
+            return IsValid();
+
+        Finish();
+        size_t readbackBufferCount = m_slots.size();
+        return Create(width, height, readbackBufferCount);
+    }
+
+    void OffscreenTarget::Bind() {
+        RenderDevice* device = Renderer::GetDevice();
+        device->BindFramebuffer(m_framebuffer);
+        device->SetViewport(0, 0, m_width, m_height);
+    }
+
+    void OffscreenTarget::Unbind() {
+        Renderer::GetDevice()->BindFramebuffer(0);
+    }
+
+    void OffscreenTarget::SetFrameCallback(FrameCallback callback) {
+        m_frameCallback = std::move(callback);
+    }
+
+    void OffscreenTarget::RequestReadback(uint64_t frameIndex) {
+        if (!IsValid())
+            return;
+
+        Poll();
+
+        // the ring is full, the oldest readback has to be finished before its buffer can be reused
+        ReadbackSlot& slot = m_slots[m_nextSlot];
+        if (slot.pending) {
+            m_stallCount++;
+            Deliver(slot);
+        }
+
+        Renderer::GetDevice()->ReadPixelsAsync(m_framebuffer, m_width, m_height, slot.buffer);
+        slot.frameIndex = frameIndex;
+        slot.pending = true;
+        m_nextSlot = (m_nextSlot + 1) % m_slots.size();
+    }
+
+    void OffscreenTarget::Poll() {
+        RenderDevice* device = Renderer::GetDevice();
+        // oldest first, stops at the first unfinished readback so frames stay in order
+        for (size_t i = 0; i < m_slots.size(); i++) {
+            ReadbackSlot& slot = m_slots[(m_nextSlot + i) % m_slots.size()];
+            if (!slot.pending)
+                continue;
+            if (!device->IsReadbackReady(slot.buffer))
+                break;
+            Deliver(slot);
+        }
+    }
+
+    void OffscreenTarget::Finish() {
+        for (size_t i = 0; i < m_slots.size(); i++) {
+            ReadbackSlot& slot = m_slots[(m_nextSlot + i) % m_slots.size()];
+            if (slot.pending)
+                Deliver(slot);
+        }
+    }
+
+    bool OffscreenTarget::IsValid() const {
+        return m_framebuffer != 0;
+    }
+
+    int OffscreenTarget::GetWidth() const {
+        return m_width;
+    }
+
+    int OffscreenTarget::GetHeight() const {
+        return m_height;
+    }
+
+    GpuHandle OffscreenTarget::GetFramebuffer() const {
+        return m_framebuffer;
+    }
+
+    size_t OffscreenTarget::GetPendingCount() const {
+        return static_cast<size_t>(std::count_if(m_slots.begin(), m_slots.end(),
+            [](const ReadbackSlot& slot) { return slot.pending; }));
+    }
+
+    uint64_t OffscreenTarget::GetStallCount() const {
+        return m_stallCount;
+    }
+
+    size_t OffscreenTarget::GetFrameSize() const {
+        return static_cast<size_t>(m_width) * static_cast<size_t>(m_height) * 4;
+    }
+
+    void OffscreenTarget::Deliver(ReadbackSlot& slot) {
+        slot.pending = false;
+        if (!Renderer::GetDevice()->ReadReadbackBuffer(slot.buffer, m_frame.pixels.data(), m_frame.pixels.size()))
+            return;
+
+        // GL reads bottom row first
+        size_t rowSize = m_rowBuffer.size();
+        unsigned char* pixels = m_frame.pixels.data();
+        for (int y = 0; y < m_height / 2; y++) {
+            unsigned char* top = pixels + static_cast<size_t>(y) * rowSize;
+            unsigned char* bottom = pixels + static_cast<size_t>(m_height - 1 - y) * rowSize;
+            std::memcpy(m_rowBuffer.data(), top, rowSize);
+            std::memcpy(top, bottom, rowSize);
+            std::memcpy(bottom, m_rowBuffer.data(), rowSize);
+        }
+
+        m_frame.index = slot.frameIndex;
+        m_frame.width = m_width;
+        m_frame.height = m_height;
+        if (m_frameCallback)
+            m_frameCallback(m_frame);
+    }
+
+}
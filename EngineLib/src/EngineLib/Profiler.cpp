@@ -1,13 +1,247 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <CoreLib/File.h>
+#include <CoreLib/FormatUtils.h>
+#include <CoreLib/Log.h>
+
 #include "EngineLib/Profiler.h"
 #include "EngineLib/Time.h"
 
 namespace EngineCore {
 
+    /*
+    * Call tree of one thread. Only the owning thread opens and closes zones,
+    * EndFrame reads the running totals (single writer, so relaxed atomics are enough).
+    */
+    class Profiler::ThreadData {
+    public:
+        static constexpr uint32_t NONE = UINT32_MAX;
+        static constexpr int MAX_DEPTH = 64;
+
+        struct Node {
+            Node(const ZoneSite* site, uint32_t parent, int depth)
+                : site(site), parent(parent), depth(depth) {
+            }
+
+            const ZoneSite* site;
+            uint32_t parent;
+            int depth;
+            uint32_t firstChild = NONE;
+            uint32_t nextSibling = NONE;
+
+            // written by the owning thread
+            std::atomic<uint64_t> ticks = 0;
+            std::atomic<uint64_t> calls = 0;
+
+            // only used by EndFrame
+            uint64_t lastTicks = 0;
+            uint64_t lastCalls = 0;
+            uint64_t frameTicks = 0;
+            uint64_t frameCalls = 0;
+            uint64_t frames = 0;
+            uint64_t framesCalls = 0;
+            RingHistory history;
+        };
+
+        struct StackEntry {
+            uint32_t node;
+            uint64_t startTicks;
+        };
+
+        // one captured zone, site is nullptr for frame markers
+        struct CaptureEvent {
+            const ZoneSite* site;
+            uint64_t startTicks;
+            uint64_t endTicks;
+            uint64_t frameIndex;
+        };
+
+        // slot of the capture ring buffer, can be read by another thread while the owner overwrites it
+        struct CaptureSlot {
+            std::atomic<const ZoneSite*> site = nullptr;
+            std::atomic<uint64_t> startTicks = 0;
+            std::atomic<uint64_t> endTicks = 0;
+            std::atomic<uint64_t> frameIndex = 0;
+
+            void Store(const CaptureEvent& e) {
+                site.store(e.site, std::memory_order_relaxed);
+                startTicks.store(e.startTicks, std::memory_order_relaxed);
+                endTicks.store(e.endTicks, std::memory_order_relaxed);
+                frameIndex.store(e.frameIndex, std::memory_order_relaxed);
+            }
+
+            CaptureEvent Load() const {
+                return { site.load(std::memory_order_relaxed), startTicks.load(std::memory_order_relaxed),
+                    endTicks.load(std::memory_order_relaxed), frameIndex.load(std::memory_order_relaxed) };
+            }
+        };
+
+        ThreadData(size_t index)
+            : m_index(index) {
+            // root, parent of all top level zones
+            m_nodes.emplace_back(nullptr, NONE, -1);
+        }
+
+        bool Begin(const ZoneSite& site) {
+            if (m_depth >= MAX_DEPTH)
+                return false;
+
+            uint32_t parent = (m_depth > 0) ? m_stack[m_depth - 1].node : 0;
+            uint32_t node = FindChild(parent, site);
+            m_stack[m_depth++] = { node, GetTicks() };
+            return true;
+        }
+
+        void End() {
+            uint64_t end = GetTicks();
+            const StackEntry& entry = m_stack[--m_depth];
+            Node& node = m_nodes[entry.node];
+            node.ticks.store(node.ticks.load(std::memory_order_relaxed) + (end - entry.startTicks), std::memory_order_relaxed);
+            node.calls.store(node.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            if (m_capturing.load(std::memory_order_relaxed))
+                Record(node.site, entry.startTicks, end, 0);
+        }
+
+        // only called by the owning thread
+        void Record(const ZoneSite* site, uint64_t startTicks, uint64_t endTicks, uint64_t frameIndex) {
+            uint64_t epoch = m_captureEpoch.load(std::memory_order_acquire);
+            if (m_epoch.load(std::memory_order_relaxed) != epoch) {
+                // first event of a new capture, the buffer is allocated once and never moves
+                if (!m_eventStorage) {
+                    m_eventStorage = std::make_unique<CaptureSlot[]>(m_captureEventsPerThread);
+                    m_events.store(m_eventStorage.get(), std::memory_order_release);
+                }
+                m_eventsWritten.store(0, std::memory_order_relaxed);
+                m_epoch.store(epoch, std::memory_order_release);
+            }
+
+            // a reader that sees the new slot values also sees m_eventsStarted, so it knows the old event is gone
+            uint64_t written = m_eventsWritten.load(std::memory_order_relaxed);
+            m_eventsStarted.store(written + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_eventStorage[written & (m_captureEventsPerThread - 1)].Store({ site, startTicks, endTicks, frameIndex });
+            m_eventsWritten.store(written + 1, std::memory_order_release);
+        }
+
+        /*
+        * @brief Copies the events of a capture, oldest first. Empty if this thread did not record in it.
+        * The owning thread can keep recording, events it overwrote while copying are left out
+        */
+        void CopyCapture(uint64_t epoch, std::vector<CaptureEvent>& out) const {
+            out.clear();
+            if (m_epoch.load(std::memory_order_acquire) != epoch)
+                return;
+            const CaptureSlot* events = m_events.load(std::memory_order_acquire);
+            if (!events)
+                return;
+
+            uint64_t capacity = m_captureEventsPerThread;
+            uint64_t written = m_eventsWritten.load(std::memory_order_acquire);
+            uint64_t count = std::min<uint64_t>(written, capacity);
+            uint64_t first = written - count;
+            out.reserve(count);
+            for (uint64_t i = first; i < written; i++)
+                out.push_back(events[i & (capacity - 1)].Load());
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t started = m_eventsStarted.load(std::memory_order_relaxed);
+            if (m_epoch.load(std::memory_order_relaxed) != epoch || started < written) {
+                out.clear();
+                return;
+            }
+            uint64_t firstValid = (started > capacity) ? started - capacity : 0;
+            if (firstValid > first)
+                out.erase(out.begin(), out.begin() + static_cast<ptrdiff_t>(std::min(firstValid - first, count)));
+        }
+
+        size_t GetIndex() const {
+            return m_index;
+        }
+
+        std::mutex& GetNodeMutex() {
+            return m_nodeMutex;
+        }
+
+        // lock the node mutex before using it from another thread
+        std::deque<Node>& GetNodes() {
+            return m_nodes;
+        }
+
+    private:
+        uint32_t FindChild(uint32_t parent, const ZoneSite& site) {
+            for (uint32_t child = m_nodes[parent].firstChild; child != NONE; child = m_nodes[child].nextSibling) {
+                if (m_nodes[child].site == &site)
+                    return child;
+            }
+
+            // first call of this zone under this parent
+            std::lock_guard<std::mutex> lock(m_nodeMutex);
+            uint32_t index = static_cast<uint32_t>(m_nodes.size());
+            Node& node = m_nodes.emplace_back(&site, parent, m_nodes[parent].depth + 1);
+            node.history.Resize(m_maxSampleCount);
+            node.nextSibling = m_nodes[parent].firstChild;
+            m_nodes[parent].firstChild = index;
+            return index;
+        }
+
+        size_t m_index;
+        // deque keeps the nodes in place when new ones are added
+        std::deque<Node> m_nodes;
+        std::mutex m_nodeMutex;
+        StackEntry m_stack[MAX_DEPTH];
+        int m_depth = 0;
+
+        // ring buffer of m_captureEventsPerThread events (a power of two)
+        std::unique_ptr<CaptureSlot[]> m_eventStorage;
+        std::atomic<CaptureSlot*> m_events = nullptr;
+        std::atomic<uint64_t> m_eventsStarted = 0; // set before a slot is written
+        std::atomic<uint64_t> m_eventsWritten = 0; // set after a slot is written
+        // capture the written events belong to
+        std::atomic<uint64_t> m_epoch = 0;
+    };
+
+    void Profiler::RingHistory::Resize(size_t capacity) {
+        m_samples.assign(capacity, 0.0);
+        m_next = 0;
+        m_count = 0;
+    }
+
+    void Profiler::RingHistory::Push(double value) {
+        if (m_samples.empty())
+            return;
+
+        m_samples[m_next] = value;
+        m_next = (m_next + 1) % m_samples.size();
+        if (m_count < m_samples.size())
+            m_count++;
+    }
+
+    size_t Profiler::RingHistory::Size() const {
+        return m_count;
+    }
+
+    void Profiler::RingHistory::CopyTo(std::vector<double>& out) const {
+        out.clear();
+        out.reserve(m_count);
+        size_t start = (m_next + m_samples.size() - m_count) % std::max<size_t>(m_samples.size(), 1);
+        for (size_t i = 0; i < m_count; i++)
+            out.push_back(m_samples[(start + i) % m_samples.size()]);
+    }
+
     void Profiler::Start(int fps) {
         if (Time::GetTime() < 2)
             return;
-        
-        if (m_fpsList.empty()) {
+
+        if (m_fpsList.Size() == 0) {
+            m_fpsList.Resize(m_maxSampleCount);
             m_highestFPS = fps;
             m_lowestFPS = fps;
         }
@@ -15,67 +249,192 @@ namespace EngineCore {
         if (fps > m_highestFPS) m_highestFPS = fps;
         if (fps < m_lowestFPS) m_lowestFPS = fps;
 
-        if (m_maxSampleCount > 0 && m_fpsList.size() >= m_maxSampleCount) {
-            m_fpsList.erase(m_fpsList.begin());
-        }
+        m_fpsList.Push(static_cast<double>(fps));
+    }
 
-        m_fpsList.push_back(fps);
+    std::vector<std::unique_ptr<Profiler::ThreadData>>& Profiler::GetThreads() {
+        static std::vector<std::unique_ptr<ThreadData>> threads;
+        return threads;
     }
 
-    void Profiler::SectionStart(const std::string& sectionName) {
-        m_currentSection = sectionName;
-        m_currentStartTime = Time::GetTimeDouble();
+    Profiler::ThreadData& Profiler::GetThreadData() {
+        thread_local ThreadData* threadData = nullptr;
+        if (!threadData) {
+            std::lock_guard<std::mutex> lock(m_threadsMutex);
+            auto& threads = GetThreads();
+            threadData = threads.emplace_back(std::make_unique<ThreadData>(threads.size())).get();
+        }
+        return *threadData;
     }
 
-    void Profiler::SectionEnd() {
-        double delta = Time::GetTimeDouble() - m_currentStartTime;
+    bool Profiler::Begin(const ZoneSite& site) {
+        return GetThreadData().Begin(site);
+    }
 
-        auto& obj = m_sections[m_currentSection];
+    void Profiler::End() {
+        GetThreadData().End();
+    }
 
-        if (obj.m_deltaTimes.empty()) {
-            obj.m_index = indexCount++;
-            obj.m_longestTime = delta;
-            obj.m_shortestTime = delta;
-        }
-        else {
-            if (delta > obj.m_longestTime) obj.m_longestTime = delta;
-            if (delta < obj.m_shortestTime) obj.m_shortestTime = delta;
+    void Profiler::UpdateTickFrequency() {
+#ifdef ENGINE_PROFILER_RDTSC
+        using Clock = std::chrono::steady_clock;
+        if (m_calibrationStartTicks == 0) {
+            // first estimate, refined every frame with the growing time span
+            m_calibrationStartTicks = GetTicks();
+            m_calibrationStartTime = Clock::now();
+            while (Clock::now() - m_calibrationStartTime < std::chrono::milliseconds(2)) {}
         }
 
-        if (m_maxSampleCount > 0 && obj.m_deltaTimes.size() >= m_maxSampleCount) {
-            obj.m_deltaTimes.erase(obj.m_deltaTimes.begin());
-        }
+        double seconds = std::chrono::duration<double>(Clock::now() - m_calibrationStartTime).count();
+        uint64_t ticks = GetTicks() - m_calibrationStartTicks;
+        if (ticks > 0)
+            m_secondsPerTick.store(seconds / static_cast<double>(ticks), std::memory_order_relaxed);
+#else
+        m_secondsPerTick.store(static_cast<double>(std::chrono::steady_clock::period::num) /
+            static_cast<double>(std::chrono::steady_clock::period::den), std::memory_order_relaxed);
+#endif
+    }
+
+    double Profiler::TicksToSeconds(uint64_t ticks) {
+        if (m_secondsPerTick.load(std::memory_order_relaxed) == 0.0)
+            UpdateTickFrequency();
+        return static_cast<double>(ticks) * m_secondsPerTick.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::StartFrame() {
+        UpdateTickFrequency();
+        m_frameStartTicks = GetTicks();
+    }
+
+    void Profiler::EndFrame() {
+        UpdateTickFrequency();
+
+        uint64_t now = GetTicks();
+        bool hasFrame = (m_frameStartTicks != 0);
+        if (m_capturing.load(std::memory_order_relaxed) && hasFrame)
+            GetThreadData().Record(nullptr, m_frameStartTicks, now, m_frameIndex);
+        double frameTime = hasFrame ? TicksToSeconds(now - m_frameStartTicks) : 0.0;
+        uint64_t frameIndex = m_frameIndex;
+        m_frameStartTicks = now;
+        m_frameIndex++;
 
-        obj.m_deltaTimes.push_back(delta);
+        if (m_frameTimes.Size() == 0)
+            m_frameTimes.Resize(m_maxSampleCount);
+        if (hasFrame)
+            m_frameTimes.Push(frameTime);
+        m_lastFrameTime = frameTime;
 
-        m_currentSection.clear();
-        m_currentStartTime = 0;
+        m_lastFrameZones.clear();
+        {
+            std::lock_guard<std::mutex> threadsLock(m_threadsMutex);
+            std::vector<uint32_t> stack;
+            for (auto& thread : GetThreads()) {
+                std::lock_guard<std::mutex> nodeLock(thread->GetNodeMutex());
+                auto& nodes = thread->GetNodes();
+                for (size_t i = 1; i < nodes.size(); i++) {
+                    auto& node = nodes[i];
+                    uint64_t ticks = node.ticks.load(std::memory_order_relaxed);
+                    uint64_t calls = node.calls.load(std::memory_order_relaxed);
+                    node.frameTicks = ticks - node.lastTicks;
+                    node.frameCalls = calls - node.lastCalls;
+                    // zones that did not run this frame get no sample
+                    if (node.frameCalls == 0)
+                        continue;
+
+                    node.history.Push(TicksToSeconds(node.frameTicks));
+                    node.frames++;
+                    node.framesCalls += node.frameCalls;
+                    node.lastTicks = ticks;
+                    node.lastCalls = calls;
+                }
+
+                // breakdown of this frame, depth first. The sibling list is newest first,
+                // so pushing it in list order pops the children in the order they were first called
+                stack.clear();
+                for (uint32_t child = nodes[0].firstChild; child != ThreadData::NONE; child = nodes[child].nextSibling)
+                    stack.push_back(child);
+                while (!stack.empty()) {
+                    auto& node = nodes[stack.back()];
+                    stack.pop_back();
+                    if (node.frameCalls == 0)
+                        continue;
+
+                    m_lastFrameZones.push_back({ node.site->name, node.depth, thread->GetIndex(), TicksToSeconds(node.frameTicks), node.frameCalls });
+                    for (uint32_t child = node.firstChild; child != ThreadData::NONE; child = nodes[child].nextSibling)
+                        stack.push_back(child);
+                }
+            }
+        }
+
+        // callback runs without the locks, it may use the profiler itself
+        if (m_frameBudget > 0.0 && frameTime > m_frameBudget) {
+            m_frameBudgetExceeded++;
+            if (m_frameBudgetCallback) {
+                m_frameBudgetCallback(frameIndex, frameTime, m_lastFrameZones);
+            }
+            else {
+                // a sustained slowdown would dump the zones every frame, the count keeps every frame
+                Log::Limited::Warn("Profiler: Frame {} took {} ms (budget {} ms)\n{}",
+                    frameIndex, frameTime * 1000.0, m_frameBudget * 1000.0, FormatFrameZones(m_lastFrameZones));
+            }
+        }
     }
 
+    static double GetPercentile(const std::vector<double>& sorted, double percentile) {
+        if (sorted.empty())
+            return 0.0;
+        // nearest rank
+        size_t rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
 
     std::vector<Profiler::Section> Profiler::GetSectionData() {
         std::vector<Profiler::Section> sections;
-        sections.reserve(m_sections.size());
+        std::vector<double> sorted;
 
-        for (auto& [name, obj] : m_sections) {
-            Section s;
+        std::lock_guard<std::mutex> threadsLock(m_threadsMutex);
+        for (auto& thread : GetThreads()) {
+            std::lock_guard<std::mutex> nodeLock(thread->GetNodeMutex());
+            auto& nodes = thread->GetNodes();
 
-            s.name = name;
-            s.m_longestTime = obj.m_longestTime;
-            s.m_shortestTime = obj.m_shortestTime;
-            s.m_deltaTimes = obj.m_deltaTimes;
+            // depth first, children in the order they were first called
+            std::vector<std::vector<uint32_t>> children(nodes.size());
+            for (uint32_t i = 1; i < nodes.size(); i++)
+                children[nodes[i].parent].push_back(i);
 
-            double sum = 0.0;
-            for (auto& delta : obj.m_deltaTimes) {
-                sum += delta;
-            }
+            std::vector<uint32_t> stack(children[0].rbegin(), children[0].rend());
+            while (!stack.empty()) {
+                uint32_t index = stack.back();
+                stack.pop_back();
+                stack.insert(stack.end(), children[index].rbegin(), children[index].rend());
+
+                auto& node = nodes[index];
+                if (node.history.Size() == 0)
+                    continue;
+
+                Section& s = sections.emplace_back();
+                s.name = node.site->name;
+                s.file = node.site->file;
+                s.line = node.site->line;
+                s.depth = node.depth;
+                s.threadIndex = thread->GetIndex();
+                s.averageCalls = (node.frames > 0) ? static_cast<double>(node.framesCalls) / static_cast<double>(node.frames) : 0.0;
 
-            if (!obj.m_deltaTimes.empty())
-                s.average = sum / static_cast<double>(obj.m_deltaTimes.size());
-            else
-                s.average = 0.0;
+                node.history.CopyTo(s.m_deltaTimes);
+                sorted = s.m_deltaTimes;
+                std::sort(sorted.begin(), sorted.end());
 
-            sections.push_back(s);
+                double sum = 0.0;
+                for (double delta : sorted)
+                    sum += delta;
+
+                s.m_shortestTime = sorted.front();
+                s.m_longestTime = sorted.back();
+                s.average = sum / static_cast<double>(sorted.size());
+                s.p50 = GetPercentile(sorted, 0.50);
+                s.p95 = GetPercentile(sorted, 0.95);
+                s.p99 = GetPercentile(sorted, 0.99);
+            }
         }
 
         return sections;
@@ -90,12 +449,12 @@ namespace EngineCore {
         result += "\n";
 
         for (const auto& s : sections) {
-            result += "Section: " + s.name + "\n";
-            result += "  Longest Time: " + std::to_string(s.m_longestTime) + " s\n";
-            result += "  Shortest Time: " + std::to_string(s.m_shortestTime) + " s\n";
-            result += "  Average Time: " + std::to_string(s.average) + " s\n";
-            result += "  Samples: " + std::to_string(s.m_deltaTimes.size()) + "\n";
-            result += "\n";
+            std::string indent(static_cast<size_t>(s.depth) * 2, ' ');
+            result += indent + "Zone: " + s.name + " (thread " + std::to_string(s.threadIndex) + ")\n";
+            result += indent + FormatUtils::formatString("  avg {} ms, p50 {} ms, p95 {} ms, p99 {} ms\n",
+                s.average * 1000.0, s.p50 * 1000.0, s.p95 * 1000.0, s.p99 * 1000.0);
+            result += indent + FormatUtils::formatString("  min {} ms, max {} ms, calls/frame {}, samples {}\n",
+                s.m_shortestTime * 1000.0, s.m_longestTime * 1000.0, s.averageCalls, s.m_deltaTimes.size());
         }
 
         return result;
@@ -106,13 +465,180 @@ namespace EngineCore {
     }
 
     float Profiler::GetAverageFPS() {
-        if (m_fpsList.empty()) return 0.0f;
-        int fpsSum = 0;
-        for (int fps : m_fpsList) fpsSum += fps;
-        return static_cast<float>(fpsSum) / m_fpsList.size();
+        std::vector<double> fpsList;
+        m_fpsList.CopyTo(fpsList);
+        if (fpsList.empty()) return 0.0f;
+        double fpsSum = 0;
+        for (double fps : fpsList) fpsSum += fps;
+        return static_cast<float>(fpsSum / fpsList.size());
     }
 
     void Profiler::SetMaxSampleCount(size_t sampleCount) {
         m_maxSampleCount = sampleCount;
+        m_fpsList.Resize(sampleCount);
+        m_frameTimes.Resize(sampleCount);
+
+        std::lock_guard<std::mutex> threadsLock(m_threadsMutex);
+        for (auto& thread : GetThreads()) {
+            std::lock_guard<std::mutex> nodeLock(thread->GetNodeMutex());
+            for (auto& node : thread->GetNodes()) {
+                node.history.Resize(sampleCount);
+                node.frames = 0;
+                node.framesCalls = 0;
+            }
+        }
+    }
+
+    void Profiler::SetFrameBudget(double seconds) {
+        m_frameBudget = std::max(seconds, 0.0);
+    }
+
+    double Profiler::GetFrameBudget() {
+        return m_frameBudget;
+    }
+
+    void Profiler::SetFrameBudgetCallback(FrameBudgetCallback callback) {
+        m_frameBudgetCallback = std::move(callback);
+    }
+
+    uint64_t Profiler::GetFrameBudgetExceededCount() {
+        return m_frameBudgetExceeded;
+    }
+
+    std::vector<double> Profiler::GetFrameTimes() {
+        std::vector<double> frameTimes;
+        m_frameTimes.CopyTo(frameTimes);
+        return frameTimes;
+    }
+
+    double Profiler::GetLastFrameTime() {
+        return m_lastFrameTime;
+    }
+
+    const std::vector<Profiler::FrameZone>& Profiler::GetLastFrameZones() {
+        return m_lastFrameZones;
+    }
+
+    std::string Profiler::FormatFrameZones(const std::vector<FrameZone>& zones) {
+        std::string result;
+        for (const auto& zone : zones) {
+            result += std::string(static_cast<size_t>(zone.depth) * 2, ' ');
+            result += FormatUtils::formatString("{}: {} ms ({} calls, thread {})\n",
+                std::string(zone.name), zone.time * 1000.0, zone.calls, zone.threadIndex);
+        }
+        return result;
+    }
+
+    void Profiler::StartCapture(size_t eventsPerThread) {
+        m_capturing.store(false, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        size_t capacity = std::bit_ceil(std::max<size_t>(eventsPerThread, 64));
+        if (m_captureEventsPerThread == 0)
+            m_captureEventsPerThread = capacity;
+        else if (capacity != m_captureEventsPerThread)
+            Log::Warn("Profiler: The capture buffers already hold {} events per thread, {} is ignored", m_captureEventsPerThread, capacity);
+
+        // the threads drop the events of the last capture with their next recorded event
+        m_captureStartTicks = GetTicks();
+        m_captureEpoch.fetch_add(1, std::memory_order_release);
+        m_capturing.store(true, std::memory_order_release);
+    }
+
+    void Profiler::StopCapture() {
+        m_capturing.store(false, std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsCapturing() {
+        return m_capturing.load(std::memory_order_relaxed);
+    }
+
+    static void AppendJsonString(std::string& out, const char* str) {
+        out += '"';
+        for (const char* c = str; *c != '\0'; c++) {
+            switch (*c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            default:   out += *c; break;
+            }
+        }
+        out += '"';
+    }
+
+    bool Profiler::WriteChromeTrace(const std::string& path) {
+        bool wasCapturing = m_capturing.exchange(false, std::memory_order_relaxed);
+        UpdateTickFrequency();
+
+        // frame markers get their own track
+        constexpr size_t FRAME_TRACK = 1000;
+        std::string json;
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        json += FormatUtils::formatString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{\"name\":\"Frames\"}}", FRAME_TRACK);
+
+        std::vector<ThreadData::CaptureEvent> events;
+        size_t eventCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_threadsMutex);
+            for (auto& thread : GetThreads()) {
+                size_t tid = thread->GetIndex();
+                json += FormatUtils::formatString(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{\"name\":\"Thread {}\"}}", tid, tid);
+
+                thread->CopyCapture(m_captureEpoch.load(std::memory_order_acquire), events);
+                for (const auto& e : events) {
+                    // events from before the capture started (zone was open while StartCapture was called)
+                    if (e.startTicks < m_captureStartTicks)
+                        continue;
+
+                    char buffer[128];
+                    double ts = TicksToSeconds(e.startTicks - m_captureStartTicks) * 1e6;
+                    double dur = TicksToSeconds(e.endTicks - e.startTicks) * 1e6;
+
+                    json += ",\n{\"name\":";
+                    if (e.site) {
+                        AppendJsonString(json, e.site->name);
+                        std::snprintf(buffer, sizeof(buffer), ",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%zu,\"args\":{\"file\":", ts, dur, tid);
+                        json += buffer;
+                        AppendJsonString(json, e.site->file);
+                        json += ",\"line\":" + std::to_string(e.site->line) + "}}";
+                    }
+                    else {
+                        std::snprintf(buffer, sizeof(buffer), "\"Frame %llu\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%zu}",
+                            static_cast<unsigned long long>(e.frameIndex), ts, dur, FRAME_TRACK);
+                        json += buffer;
+                    }
+                    eventCount++;
+                }
+            }
+        }
+        json += "\n]}\n";
+
+        if (wasCapturing)
+            m_capturing.store(true, std::memory_order_relaxed);
+
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        if (!directory.empty())
+            File::CreateDir(directory);
+
+        File file(path);
+        if (!file.Open(FILE_WRITE)) {
+            Log::Error("Profiler: Could not open '{}' for writing", path);
+            return false;
+        }
+        bool ok = file.Write(json);
+        file.Close();
+
+        if (ok)
+            Log::Info("Profiler: Wrote {} events to '{}'", eventCount, path);
+        return ok;
+    }
+
+    void Profiler::SetEnabled(bool value) {
+        m_enabled = value;
+    }
+
+    bool Profiler::IsEnabled() {
+        return m_enabled;
     }
-}
\ No newline at end of file
+
+}
@@ -0,0 +1,275 @@
+#include <cstdio>
+#include <cstring>
+
+#include "EngineLib/RecordingRenderDevice.h"
+
+namespace EngineCore {
+
+    const char* RenderCallToString(RenderCall call) {
+        switch (call) {
+        case RenderCall::CreateBuffer:          return "CreateBuffer";
+        case RenderCall::SetBufferData:         return "SetBufferData";
+        case RenderCall::UpdateBufferData:      return "UpdateBufferData";
+        case RenderCall::DeleteBuffer:          return "DeleteBuffer";
+        case RenderCall::CreateVertexArray:     return "CreateVertexArray";
+        case RenderCall::DeleteVertexArray:     return "DeleteVertexArray";
+        case RenderCall::CreateTexture2D:       return "CreateTexture2D";
+        case RenderCall::UpdateTexture2D:       return "UpdateTexture2D";
+        case RenderCall::DeleteTexture:         return "DeleteTexture";
+        case RenderCall::BindTexture:           return "BindTexture";
+        case RenderCall::CreateFramebuffer:     return "CreateFramebuffer";
+        case RenderCall::DeleteFramebuffer:     return "DeleteFramebuffer";
+        case RenderCall::BindFramebuffer:       return "BindFramebuffer";
+        case RenderCall::SetViewport:           return "SetViewport";
+        case RenderCall::CreateReadbackBuffer:  return "CreateReadbackBuffer";
+        case RenderCall::DeleteReadbackBuffer:  return "DeleteReadbackBuffer";
+        case RenderCall::ReadPixels:            return "ReadPixels";
+        case RenderCall::ReadReadbackBuffer:    return "ReadReadbackBuffer";
+        case RenderCall::CreateProgram:         return "CreateProgram";
+        case RenderCall::DeleteProgram:         return "DeleteProgram";
+        case RenderCall::UseProgram:            return "UseProgram";
+        case RenderCall::SetUniform:            return "SetUniform";
+        case RenderCall::SetDepthTest:          return "SetDepthTest";
+        case RenderCall::SetFrontFace:          return "SetFrontFace";
+        case RenderCall::ClearDepth:            return "ClearDepth";
+        case RenderCall::ClearColor:            return "ClearColor";
+        case RenderCall::DrawIndexed:           return "DrawIndexed";
+        case RenderCall::DrawIndexedInstanced:  return "DrawIndexedInstanced";
+        case RenderCall::SetScissor:            return "SetScissor";
+        case RenderCall::SetBlendMode:          return "SetBlendMode";
+        default:                                return "Unknown";
+        }
+    }
+
+    void RecordingRenderDevice::SetCapture(bool value) {
+        m_capture = value;
+    }
+
+    bool RecordingRenderDevice::IsCapturing() const {
+        return m_capture;
+    }
+
+    const std::vector<RecordingRenderDevice::RecordedCall>& RecordingRenderDevice::GetCapturedCalls() const {
+        return m_calls;
+    }
+
+    void RecordingRenderDevice::ClearCapturedCalls() {
+        m_calls.clear();
+    }
+
+    std::string RecordingRenderDevice::FormatCapturedCalls() const {
+        std::string result;
+        result.reserve(m_calls.size() * 40);
+        char buffer[160];
+        for (const auto& call : m_calls) {
+            std::snprintf(buffer, sizeof(buffer), "%s %u %lld %lld %lld %lld\n", RenderCallToString(call.call), call.handle,
+                static_cast<long long>(call.a), static_cast<long long>(call.b), static_cast<long long>(call.c), static_cast<long long>(call.d));
+            result += buffer;
+        }
+        return result;
+    }
+
+    uint64_t RecordingRenderDevice::GetCallCount(RenderCall call) const {
+        size_t index = static_cast<size_t>(call);
+        return (index < m_callCounts.size()) ? m_callCounts[index] : 0;
+    }
+
+    void RecordingRenderDevice::ResetCallCounts() {
+        m_callCounts.fill(0);
+    }
+
+    void RecordingRenderDevice::Record(RenderCall call, GpuHandle handle, int64_t a, int64_t b, int64_t c, int64_t d) {
+        m_callCounts[static_cast<size_t>(call)]++;
+        if (m_capture)
+            m_calls.push_back({ call, handle, a, b, c, d });
+    }
+
+    GpuHandle RecordingRenderDevice::CreateBuffer(BufferType type, const void* /*data*/, size_t size, BufferUsage /*usage*/) {
+        GpuHandle buffer = m_nextHandle++;
+        Record(RenderCall::CreateBuffer, buffer, static_cast<int64_t>(size), static_cast<int64_t>(type));
+        return buffer;
+    }
+
+    void RecordingRenderDevice::SetBufferData(GpuHandle buffer, BufferType type, const void* /*data*/, size_t size, BufferUsage /*usage*/) {
+        Record(RenderCall::SetBufferData, buffer, static_cast<int64_t>(size), static_cast<int64_t>(type));
+    }
+
+    void RecordingRenderDevice::UpdateBufferData(GpuHandle buffer, BufferType /*type*/, const void* /*data*/, size_t size, size_t offset) {
+        Record(RenderCall::UpdateBufferData, buffer, static_cast<int64_t>(size), static_cast<int64_t>(offset));
+    }
+
+    void RecordingRenderDevice::DeleteBuffer(GpuHandle buffer) {
+        Record(RenderCall::DeleteBuffer, buffer);
+    }
+
+    GpuHandle RecordingRenderDevice::CreateVertexArray(const std::vector<VertexAttribute>& attributes, GpuHandle indexBuffer) {
+        GpuHandle vertexArray = m_nextHandle++;
+        Record(RenderCall::CreateVertexArray, vertexArray, static_cast<int64_t>(attributes.size()), indexBuffer);
+        return vertexArray;
+    }
+
+    void RecordingRenderDevice::DeleteVertexArray(GpuHandle vertexArray) {
+        Record(RenderCall::DeleteVertexArray, vertexArray);
+    }
+
+    GpuHandle RecordingRenderDevice::CreateTexture2D(const TextureDesc& desc, const unsigned char* /*data*/) {
+        if (desc.channels != 1 && desc.channels != 3 && desc.channels != 4)
+            return 0;
+        GpuHandle texture = m_nextHandle++;
+        Record(RenderCall::CreateTexture2D, texture, desc.width, desc.height);
+        return texture;
+    }
+
+    void RecordingRenderDevice::UpdateTexture2D(GpuHandle texture, int /*x*/, int /*y*/, int width, int height, int /*channels*/, const unsigned char* /*data*/) {
+        Record(RenderCall::UpdateTexture2D, texture, width, height);
+    }
+
+    void RecordingRenderDevice::DeleteTexture(GpuHandle texture) {
+        Record(RenderCall::DeleteTexture, texture);
+        for (auto& bound : m_boundTextures) {
+            if (bound == texture)
+                bound = 0;
+        }
+    }
+
+    void RecordingRenderDevice::BindTexture(unsigned int unit, GpuHandle texture) {
+        Record(RenderCall::BindTexture, texture, unit);
+        if (unit < MAX_TEXTURE_UNITS)
+            m_boundTextures[unit] = texture;
+    }
+
+    GpuHandle RecordingRenderDevice::GetBoundTexture(unsigned int unit) const {
+        return (unit < MAX_TEXTURE_UNITS) ? m_boundTextures[unit] : 0;
+    }
+
+    unsigned int RecordingRenderDevice::GetMaxTextureUnits() const {
+        return MAX_TEXTURE_UNITS;
+    }
+
+    GpuHandle RecordingRenderDevice::CreateFramebuffer(int width, int height) {
+        GpuHandle framebuffer = m_nextHandle++;
+        Record(RenderCall::CreateFramebuffer, framebuffer, width, height);
+        return framebuffer;
+    }
+
+    GpuHandle RecordingRenderDevice::CreateTextureFramebuffer(GpuHandle /*colorTexture*/, int width, int height) {
+        GpuHandle framebuffer = m_nextHandle++;
+        Record(RenderCall::CreateFramebuffer, framebuffer, width, height);
+        return framebuffer;
+    }
+
+    void RecordingRenderDevice::DeleteFramebuffer(GpuHandle framebuffer) {
+        Record(RenderCall::DeleteFramebuffer, framebuffer);
+    }
+
+    void RecordingRenderDevice::BindFramebuffer(GpuHandle framebuffer) {
+        Record(RenderCall::BindFramebuffer, framebuffer);
+    }
+
+    void RecordingRenderDevice::SetViewport(int x, int y, int width, int height) {
+        Record(RenderCall::SetViewport, 0, x, y, width, height);
+    }
+
+    void RecordingRenderDevice::SetScissor(bool enabled, int x, int y, int width, int height) {
+        Record(RenderCall::SetScissor, enabled ? 1 : 0, x, y, width, height);
+    }
+
+    GpuHandle RecordingRenderDevice::CreateReadbackBuffer(size_t size) {
+        GpuHandle buffer = m_nextHandle++;
+        Record(RenderCall::CreateReadbackBuffer, buffer, static_cast<int64_t>(size));
+        return buffer;
+    }
+
+    void RecordingRenderDevice::DeleteReadbackBuffer(GpuHandle readbackBuffer) {
+        Record(RenderCall::DeleteReadbackBuffer, readbackBuffer);
+    }
+
+    void RecordingRenderDevice::ReadPixelsAsync(GpuHandle /*framebuffer*/, int width, int height, GpuHandle readbackBuffer) {
+        Record(RenderCall::ReadPixels, readbackBuffer, width, height);
+    }
+
+    bool RecordingRenderDevice::IsReadbackReady(GpuHandle /*readbackBuffer*/) {
+        return true;
+    }
+
+    bool RecordingRenderDevice::ReadReadbackBuffer(GpuHandle readbackBuffer, void* outData, size_t size) {
+        Record(RenderCall::ReadReadbackBuffer, readbackBuffer, static_cast<int64_t>(size));
+        std::memset(outData, 0, size);
+        return true;
+    }
+
+    GpuHandle RecordingRenderDevice::CreateProgram(const std::string& /*vertexCode*/, const std::string& /*fragmentCode*/) {
+        GpuHandle program = m_nextHandle++;
+        Record(RenderCall::CreateProgram, program);
+        return program;
+    }
+
+    void RecordingRenderDevice::DeleteProgram(GpuHandle program) {
+        Record(RenderCall::DeleteProgram, program);
+        m_uniformLocations.erase(program);
+        if (m_currentProgram == program)
+            m_currentProgram = 0;
+    }
+
+    void RecordingRenderDevice::UseProgram(GpuHandle program) {
+        Record(RenderCall::UseProgram, program);
+        m_currentProgram = program;
+    }
+
+    GpuHandle RecordingRenderDevice::GetCurrentProgram() const {
+        return m_currentProgram;
+    }
+
+    int RecordingRenderDevice::GetUniformLocation(GpuHandle program, const std::string& name) {
+        // every uniform exists, there is no shader source to check against
+        auto& locations = m_uniformLocations[program];
+        auto it = locations.find(name);
+        if (it != locations.end())
+            return it->second;
+
+        int location = static_cast<int>(locations.size());
+        locations.emplace(name, location);
+        return location;
+    }
+
+    void RecordingRenderDevice::SetUniformInt(int location, int /*value*/) {
+        Record(RenderCall::SetUniform, m_currentProgram, location, 1);
+    }
+
+    void RecordingRenderDevice::SetUniformFloats(int location, const float* /*values*/, int components) {
+        Record(RenderCall::SetUniform, m_currentProgram, location, components);
+    }
+
+    void RecordingRenderDevice::SetUniformMatrix(int location, int columns, int rows, const float* /*data*/) {
+        Record(RenderCall::SetUniform, m_currentProgram, location, columns * rows);
+    }
+
+    void RecordingRenderDevice::SetDepthTest(bool enabled) {
+        Record(RenderCall::SetDepthTest, 0, enabled ? 1 : 0);
+    }
+
+    void RecordingRenderDevice::SetFrontFace(FrontFace frontFace) {
+        Record(RenderCall::SetFrontFace, 0, static_cast<int64_t>(frontFace));
+    }
+
+    void RecordingRenderDevice::SetBlendMode(BlendMode mode) {
+        Record(RenderCall::SetBlendMode, 0, static_cast<int64_t>(mode));
+    }
+
+    void RecordingRenderDevice::ClearDepth() {
+        Record(RenderCall::ClearDepth);
+    }
+
+    void RecordingRenderDevice::ClearColor(float /*r*/, float /*g*/, float /*b*/, float /*a*/) {
+        Record(RenderCall::ClearColor);
+    }
+
+    void RecordingRenderDevice::DrawIndexed(GpuHandle vertexArray, int indexCount) {
+        Record(RenderCall::DrawIndexed, vertexArray, indexCount, 1);
+    }
+
+    void RecordingRenderDevice::DrawIndexedInstanced(GpuHandle vertexArray, int indexCount, int instanceCount) {
+        Record(RenderCall::DrawIndexedInstanced, vertexArray, indexCount, instanceCount);
+    }
+
+}
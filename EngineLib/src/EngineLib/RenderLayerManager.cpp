@@ -11,11 +11,19 @@ namespace EngineCore {
 			Log::Warn("RenderLayerManager: Cant add Layer '{}', Layers can only be added in the start method", layerName);
 			return RenderLayerID(ENGINE_INVALID_ID);
 		}
+		if (m_indexToPriority.size() >= MAX_RENDER_LAYERS) {
+			Log::Warn("RenderLayerManager: Cant add Layer '{}', there can only be {} Layers", layerName, MAX_RENDER_LAYERS);
+			return RenderLayerID(ENGINE_INVALID_ID);
+		}
 		std::string lowerName = FormatUtils::toLowerCase(layerName);
 
 		RenderLayerID rID(m_idManager.GetNewUniqueIdentifier());
 		m_nameToID.emplace(lowerName, rID);
-		m_idToPriority.emplace(rID, renderPriority);
+
+		if (m_idToIndex.size() <= rID.value)
+			m_idToIndex.resize(rID.value + 1, INVALID_LAYER_INDEX);
+		m_idToIndex[rID.value] = static_cast<unsigned int>(m_indexToPriority.size());
+		m_indexToPriority.push_back(renderPriority);
 		return rID;
 	}
 
@@ -42,15 +50,32 @@ namespace EngineCore {
 	}
 
 	int RenderLayerManager::GetLayerPriority(RenderLayerID layerID) {
-		auto it = m_idToPriority.find(layerID);
-		if (it != m_idToPriority.end()) {
-			return it->second;
+		unsigned int index = GetLayerIndex(layerID);
+		if (index != INVALID_LAYER_INDEX) {
+			return m_indexToPriority[index];
 		}
 
-		Log::Warn("RenderLayerManager: Render layer Priority with name {} and ID {}, not found!", layerID.value, GetLayerName(layerID));
+		Log::Limited::Warn("RenderLayerManager: Render layer Priority with name {} and ID {}, not found!", GetLayerName(layerID), layerID.value);
 		return 0;
 	}
 
+	RenderLayerMask RenderLayerManager::GetLayerMask(RenderLayerID layerID) {
+		unsigned int index = GetLayerIndex(layerID);
+		return (index != INVALID_LAYER_INDEX) ? (RenderLayerMask(1) << index) : 0;
+	}
+
+	RenderLayerMask RenderLayerManager::GetLayerMask(const std::vector<RenderLayerID>& layerIDs) {
+		RenderLayerMask mask = 0;
+		for (RenderLayerID layerID : layerIDs) {
+			mask |= GetLayerMask(layerID);
+		}
+		return mask;
+	}
+
+	unsigned int RenderLayerManager::GetLayerIndex(RenderLayerID layerID) {
+		return (layerID.value < m_idToIndex.size()) ? m_idToIndex[layerID.value] : INVALID_LAYER_INDEX;
+	}
+
 	std::vector<std::string> RenderLayerManager::GetAllRenderLayerNames() {
 		std::vector<std::string> names;
 		names.reserve(m_nameToID.size());
@@ -1,7 +1,6 @@
 #include <algorithm>
-#pragma once
-#define GLAD_GL_IMPLEMENTATION
-#include <glad/glad.h>
+#include <cmath>
+#include <cstring>
 #include <CoreLib/Log.h>
 #include <CoreLib/Math/Vector3.h>
 #include <CoreLib/Math/Vector4.h>
@@ -17,6 +16,11 @@
 #include "EngineLib/Material.h"
 #include "EngineLib/Shader.h"
 #include "EngineLib/ShaderBindObject.h"
+#include "EngineLib/Profiler.h"
+#include "EngineLib/OffscreenTarget.h"
+#include "EngineLib/Frustum.h"
+#include "EngineLib/GLRenderDevice.h"
+#include "EngineLib/RecordingRenderDevice.h"
 #include "EngineLib/Renderer.h"
 
 namespace EngineCore {
@@ -26,15 +30,106 @@ namespace EngineCore {
         return &instance;
     }
 
+    RenderBackend Renderer::GetBackend() {
+        return m_backend;
+    }
+
+    RenderDevice* Renderer::GetDevice() {
+        if (!m_device)
+            InitBackend(m_backend);
+        return m_device.get();
+    }
+
+    void Renderer::InitBackend(RenderBackend backend) {
+        m_backend = backend;
+        if (backend == RenderBackend::Recording)
+            m_device = std::make_unique<RecordingRenderDevice>();
+        else
+            m_device = std::make_unique<GLRenderDevice>();
+    }
+
+    const RenderStats& Renderer::GetStats() const {
+        return m_stats;
+    }
+
     void Renderer::Submit(const RenderCommand& cmd) {
         if (cmd.renderLayerID.value == ENGINE_INVALID_ID)
             return;
+        // never sorted if the camera does not render the layer
+        if ((RenderLayerManager::GetLayerMask(cmd.renderLayerID) & m_visibleLayers) == 0)
+            return;
         m_commands.push_back(cmd);
+        if (cmd.isUI)
+            m_uiCommandCount++;
+    }
+
+    void Renderer::BeginUITarget(GpuHandle framebuffer, int width, int height, int scissorX, int scissorY, int scissorWidth, int scissorHeight) {
+        UITarget& target = m_uiTargets.emplace_back();
+        target.framebuffer = framebuffer;
+        target.width = width;
+        target.height = height;
+        target.scissor[0] = scissorX;
+        target.scissor[1] = scissorY;
+        target.scissor[2] = scissorWidth;
+        target.scissor[3] = scissorHeight;
+        target.begin = m_uiCommandCount;
+        target.end = m_uiCommandCount;
+    }
+
+    void Renderer::EndUITarget() {
+        if (!m_uiTargets.empty())
+            m_uiTargets.back().end = m_uiCommandCount;
+    }
+
+    void Renderer::BeginFrame(GpuHandle surfaceFramebuffer, int surfaceWidth, int surfaceHeight) {
+        m_surfaceFramebuffer = surfaceFramebuffer;
+        m_surfaceWidth = surfaceWidth;
+        m_surfaceHeight = surfaceHeight;
+
+        m_frameCameras.clear();
+        m_visibleLayers = 0;
+        m_uiLayers = 0;
+        m_uiTargets.clear();
+        m_uiCommandCount = 0;
+
+        std::shared_ptr<Component::Camera> mainCamera = GameObject::GetMainCamera();
+        if (mainCamera) {
+            if (mainCamera->IsDisable()) {
+                Log::Warn("Renderer: Cant render, main Camera is disabled!");
+            }
+            else if (mainCamera->GetGameObject()->IsDisabled()) {
+                Log::Warn("Renderer: Cant render, main Camera GameObject is disabled!");
+            }
+            else {
+                m_frameCameras.push_back(mainCamera);
+                m_uiLayers = mainCamera->GetRenderLayerMask();
+            }
+        }
+
+        for (auto& weakCamera : GameObject::GetCameras()) {
+            std::shared_ptr<Component::Camera> camera = weakCamera.lock();
+            if (!camera || camera == mainCamera || !camera->IsAdditional())
+                continue;
+            if (camera->IsDisable() || camera->GetGameObject()->IsDisabled())
+                continue;
+            m_frameCameras.push_back(camera);
+        }
+
+        // transparent commands are sorted once, by the main camera if it renders
+        if (!m_frameCameras.empty())
+            m_sortPosition = m_frameCameras.front()->GetGameObject()->GetTransform()->GetWorldPosition();
+
+        std::stable_sort(m_frameCameras.begin(), m_frameCameras.end(),
+            [](const auto& a, const auto& b) { return a->GetPriority() < b->GetPriority(); });
+
+        for (auto& camera : m_frameCameras)
+            m_visibleLayers |= camera->GetRenderLayerMask();
     }
 
     void Renderer::ReserveCommands(size_t count) {
         m_commands.reserve(count);
-        m_instanceMatrices.reserve(count);
+        m_instances.reserve(count);
+        m_commandBounds.reserve(count);
     }
 
     void Renderer::DrawAll() {
@@ -45,23 +140,150 @@ namespace EngineCore {
         * Draw all the transparent objects in sorted order.
         * 
         * Transparency dosent work correctly because i dont sort the faces.
+        *
+        * The commands are sorted once, then every camera draws the world commands
+        * it can see into its viewport / render target. UI is drawn last, once.
         */
+        m_stats = RenderStats{};
+        m_stats.commands = m_commands.size();
         if (m_commands.size() <= 0)
             return;
 
-        std::shared_ptr<Component::Camera> camptr = GameObject::GetMainCamera();
-        if (camptr->IsDisable()) {
-            Log::Warn("Renderer: Cant render, main Camera is disabled!");
+        if (m_frameCameras.empty()) {
+            m_commands.clear();
             return;
         }
-        if (camptr->GetGameObject()->IsDisabled()) {
-            Log::Warn("Renderer: Cant render, main Camera GameObject is disabled!");
-            return;
+
+        {
+            ENGINE_PROFILE_ZONE("Renderer::Sort");
+            SortDrawCommands(m_sortPosition);
         }
-        Matrix4x4 cameraProjectionMat = camptr->GetProjectionMatrix();// could be a ptr
-        Matrix4x4 cameraViewMat = camptr->GetViewMatrix();// could be a ptr
+        {
+            ENGINE_PROFILE_ZONE("Renderer::Cull");
+            CalculateCommandBounds();
+        }
+
+        // state changes, batching and the device calls
+        ENGINE_PROFILE_ZONE("Renderer::Batch");
+
+        RenderDevice* device = GetDevice();
+        size_t uiBegin = static_cast<size_t>(std::find_if(m_commands.begin(), m_commands.end(),
+            [](const RenderCommand& cmd) { return cmd.isUI; }) - m_commands.begin());
+
+        bool drewToSurface = false;
+        for (auto& camera : m_frameCameras) {
+            Vector4 viewport = camera->GetViewport();
+            OffscreenTarget* target = camera->GetRenderTarget();
+            bool hasTarget = target && target->IsValid();
+            int width = (hasTarget) ? target->GetWidth() : m_surfaceWidth;
+            int height = (hasTarget) ? target->GetHeight() : m_surfaceHeight;
+            int vx = static_cast<int>(viewport.x * width);
+            int vy = static_cast<int>(viewport.y * height);
+            int vw = static_cast<int>(viewport.z * width);
+            int vh = static_cast<int>(viewport.w * height);
+
+            device->BindFramebuffer((hasTarget) ? target->GetFramebuffer() : m_surfaceFramebuffer);
+            device->SetViewport(vx, vy, vw, vh);
+            // clears ignore the viewport, the scissor keeps cameras that share a surface from clearing each other
+            if (hasTarget) {
+                device->SetScissor(true, vx, vy, vw, vh);
+                Vector4 background = camera->GetBackgroundColor();
+                device->ClearColor(background.x, background.y, background.z, background.w);
+                device->ClearDepth();
+                device->SetScissor(false, 0, 0, 0, 0);
+            }
+            else {
+                // cameras on the window draw over each other
+                if (drewToSurface) {
+                    device->SetScissor(true, vx, vy, vw, vh);
+                    device->ClearDepth();
+                    device->SetScissor(false, 0, 0, 0, 0);
+                }
+                drewToSurface = true;
+            }
+
+            DrawCommands(0, uiBegin, camera.get(), camera->GetRenderLayerMask());
+            m_stats.cameras++;
+        }
+
+        // cached UI layers are redrawn first, commands of the surface pass composite them
+        size_t uiCount = m_commands.size() - uiBegin;
+        for (const UITarget& target : m_uiTargets) {
+            device->BindFramebuffer(target.framebuffer);
+            device->SetViewport(0, 0, target.width, target.height);
+            device->SetScissor(true, target.scissor[0], target.scissor[1], target.scissor[2], target.scissor[3]);
+            device->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            device->SetBlendMode(BlendMode::Layer);
+            DrawCommands(uiBegin + std::min(target.begin, uiCount), uiBegin + std::min(target.end, uiCount), nullptr, m_uiLayers);
+            device->SetBlendMode(BlendMode::Alpha);
+            device->SetScissor(false, 0, 0, 0, 0);
+        }
+
+        device->BindFramebuffer(m_surfaceFramebuffer);
+        device->SetViewport(0, 0, m_surfaceWidth, m_surfaceHeight);
+        size_t next = uiBegin;
+        for (const UITarget& target : m_uiTargets) {
+            DrawCommands(next, uiBegin + std::min(target.begin, uiCount), nullptr, m_uiLayers);
+            next = uiBegin + std::min(target.end, uiCount);
+        }
+        DrawCommands(next, m_commands.size(), nullptr, m_uiLayers);
+
+        // turn depth testing on if UI turned of
+        device->SetDepthTest(true);
+
+        // PrintCommands(true);
+        m_commands.clear();
+        m_uiTargets.clear();
+        m_uiCommandCount = 0;
+    }
+
+    void Renderer::CalculateCommandBounds() {
+        ResourceManager* rm = ResourceManager::GetInstance();
+        m_commandBounds.resize(m_commands.size());
+
+        MeshID meshID(ENGINE_INVALID_ID);
+        Mesh* mesh = nullptr;
+        for (size_t i = 0; i < m_commands.size(); i++) {
+            const RenderCommand& cmd = m_commands[i];
+            Vector4& bounds = m_commandBounds[i];
+            bounds.w = -1.0f;
+            if (cmd.isUI || cmd.type != RenderCommandType::Mesh || !cmd.modelMatrix)
+                continue;
+
+            // commands are sorted by mesh, most lookups are skipped
+            if (meshID != cmd.meshID) {
+                meshID = cmd.meshID;
+                mesh = rm->GetMesh(meshID);
+            }
+            if (!mesh)
+                continue;
+
+            const Vector4& sphere = mesh->GetBoundingSphere();
+            if (sphere.w < 0.0f)
+                continue;
+
+            // the radius grows with the longest axis, one sqrt instead of GetScale
+            const float* m = cmd.modelMatrix->GetData();
+            float scaleSqX = m[0] * m[0] + m[4] * m[4] + m[8] * m[8];
+            float scaleSqY = m[1] * m[1] + m[5] * m[5] + m[9] * m[9];
+            float scaleSqZ = m[2] * m[2] + m[6] * m[6] + m[10] * m[10];
+            float maxScale = std::sqrt(std::max({ scaleSqX, scaleSqY, scaleSqZ }));
+            bounds.Set(
+                m[0] * sphere.x + m[1] * sphere.y + m[2] * sphere.z + m[3],
+                m[4] * sphere.x + m[5] * sphere.y + m[6] * sphere.z + m[7],
+                m[8] * sphere.x + m[9] * sphere.y + m[10] * sphere.z + m[11],
+                sphere.w * maxScale);
+        }
+    }
+
+    void Renderer::DrawCommands(size_t begin, size_t end, Component::Camera* camera, RenderLayerMask layers) {
+        if (begin >= end)
+            return;
+
+        const Matrix4x4* cameraProjectionMat = (camera) ? &camera->GetProjectionMatrix() : nullptr;
+        const Matrix4x4* cameraViewMat = (camera) ? &camera->GetViewMatrix() : nullptr;
+        const Frustum* frustum = (camera) ? &camera->GetFrustum() : nullptr;
         Matrix4x4* uiProjectionMat = UIManager::GetOrthograpicMatrixPtr();
-        const std::vector<RenderLayerID>& renderLayers = camptr->GetRenderLayers();
 
         Shader* currentShader = nullptr;
         ShaderID currentShaderID(ENGINE_INVALID_ID);
@@ -70,37 +292,42 @@ namespace EngineCore {
         ShaderBindObject* currentOverrideShaderBindObj = nullptr;
         Mesh* currentMesh = nullptr;
         MeshID currentMeshID(ENGINE_INVALID_ID);
-        bool currentInvertMesh = m_commands[0].invertMesh;
+        bool currentInvertMesh = m_commands[begin].invertMesh;
         FontID currentFontID(ENGINE_INVALID_ID);
         int currentFontPixelSize = -1;
-        int currentRenderLayerPriority = RenderLayerManager::GetLayerPriority(m_commands[0].renderLayerID);
-        int currentZOrder = m_commands[0].zOrder;
-        Vector4 currentMeshColor(-1,-1, -1, -1);
+        int currentRenderLayerPriority = RenderLayerManager::GetLayerPriority(m_commands[begin].renderLayerID);
+        int currentZOrder = m_commands[begin].zOrder;
+        uint64_t currentOverrideKey = 0;
         bool isUI = false;
 
         ResourceManager* rm = ResourceManager::GetInstance();
-        
-        SortDrawCommands(camptr);
+        RenderDevice* device = GetDevice();
 
-        auto flushBatch = [&](Mesh* mesh, Shader* shader, ShaderBindObject* shaderBindObjOverride, bool invert, const std::vector<Matrix4x4>& matrices) {
-            if (mesh && shader && !matrices.empty()) {
+        // color, uv rect and the custom params are instance attributes, only the mesh, material,
+        // the values of the override and the winding split a batch
+        auto flushBatch = [&](Mesh* mesh, Shader* shader, ShaderBindObject* shaderBindObjOverride, bool invert, std::vector<InstanceData>& instances) {
+            if (mesh && shader && !instances.empty()) {
                 // shader->Bind(); probably fine
                 if (shaderBindObjOverride)
                     shaderBindObjOverride->Bind(shader);
-                glFrontFace(invert ? GL_CW : GL_CCW);
-                mesh->DrawInstanced((int)matrices.size(), matrices);
+                device->SetFrontFace(invert ? FrontFace::Clockwise : FrontFace::CounterClockwise);
+                mesh->DrawInstanced(instances);
+                m_stats.drawCalls++;
+                m_stats.instances += instances.size();
             }
+            instances.clear();
         };
 
-        for (auto& cmd : m_commands) {
-            // if element is not in renderlayers of the cam inefficient
-            bool isInLayer = false;
-            for (auto& layer : renderLayers) {
-                if (layer == cmd.renderLayerID)
-                    isInLayer = true;
-            }
-            if (!isInLayer)
+        for (size_t i = begin; i < end; i++) {
+            const RenderCommand& cmd = m_commands[i];
+            if ((RenderLayerManager::GetLayerMask(cmd.renderLayerID) & layers) == 0)
+                continue;
+
+            const Vector4& bounds = m_commandBounds[i];
+            if (frustum && bounds.w >= 0.0f && !frustum->IntersectsSphere(Vector3(bounds.x, bounds.y, bounds.z), bounds.w)) {
+                m_stats.culled++;
                 continue;
+            }
 
             int renderLayerPrio = RenderLayerManager::GetLayerPriority(cmd.renderLayerID);
             // clear depth buffer if render prio changed
@@ -108,28 +335,25 @@ namespace EngineCore {
                 currentRenderLayerPriority = renderLayerPrio;
                 currentZOrder = cmd.zOrder;
                 //draw the rest
-                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-                m_instanceMatrices.clear();
+                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instances);
 
-                glClear(GL_DEPTH_BUFFER_BIT);
+                device->ClearDepth();
             }// clear if z order changed
             else if (currentZOrder != cmd.zOrder) {
                 currentZOrder = cmd.zOrder;
                 //draw the rest
-                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-                m_instanceMatrices.clear();
+                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instances);
 
-                glClear(GL_DEPTH_BUFFER_BIT);
+                device->ClearDepth();
             }
 
             // if UI started rendering no depth testing
             if (isUI != cmd.isUI) {
-                glDisable(GL_DEPTH_TEST);
+                device->SetDepthTest(false);
             }
 
             if (cmd.type == RenderCommandType::Text) {
-                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-                m_instanceMatrices.clear();
+                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instances);
 
                 // new font or new pixel size
                 if (currentFontID != cmd.fontID || currentFontPixelSize != cmd.pixelSize) {
@@ -138,7 +362,7 @@ namespace EngineCore {
                     unsigned int texID = rm->GetFontAtlasTextureID(cmd.fontID, cmd.pixelSize);
                     // if valid texture
                     if (texID != ENGINE_INVALID_ID) {
-                        glBindTexture(GL_TEXTURE_2D, texID);
+                        device->BindTexture(0, texID);
                     }
                 }
 
@@ -159,9 +383,9 @@ namespace EngineCore {
                         continue;
                     }
 
-                    if (!cmd.isUI) {
-                        currentShader->SetMatrix4("projection", cameraProjectionMat.ToOpenGLData());
-                        currentShader->SetMatrix4("view", cameraViewMat.ToOpenGLData());
+                    if (!cmd.isUI && camera) {
+                        currentShader->SetMatrix4("projection", cameraProjectionMat->ToOpenGLData());
+                        currentShader->SetMatrix4("view", cameraViewMat->ToOpenGLData());
                     }
                     else {
                         currentShader->SetMatrix4("projection", uiProjectionMat->ToOpenGLData());
@@ -184,19 +408,19 @@ namespace EngineCore {
                 // if invert mesh changes 
                 if (currentInvertMesh != cmd.invertMesh) {
                     currentInvertMesh = cmd.invertMesh;
-                    glFrontFace(cmd.invertMesh ? GL_CW : GL_CCW);
+                    device->SetFrontFace(cmd.invertMesh ? FrontFace::Clockwise : FrontFace::CounterClockwise);
                 }
 
-                for (const auto& quad : cmd.textQuads) {
-                    FontManager::DrawQuad(quad);
+                for (size_t i = 0; i < cmd.textQuadCount; i++) {
+                    FontManager::DrawQuad(cmd.textQuads[i]);
                 }
+                m_stats.drawCalls += cmd.textQuadCount;
                 continue;
             }
 
             // material change
             if (currentMaterialID != cmd.materialID || isUI != cmd.isUI) {
-                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-                m_instanceMatrices.clear();
+                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instances);
         
                 if (cmd.materialID.value == ENGINE_INVALID_ID) continue;
         
@@ -221,27 +445,29 @@ namespace EngineCore {
                     }
 
                     // change projection matrix if ui is rendered
-                    if (!cmd.isUI) {
-                        currentShader->SetMatrix4("projection", cameraProjectionMat.ToOpenGLData());
-                        currentShader->SetMatrix4("view", cameraViewMat.ToOpenGLData());
+                    if (!cmd.isUI && camera) {
+                        currentShader->SetMatrix4("projection", cameraProjectionMat->ToOpenGLData());
+                        currentShader->SetMatrix4("view", cameraViewMat->ToOpenGLData());
                     }
                     else {
                         currentShader->SetMatrix4("projection", uiProjectionMat->ToOpenGLData());
                     }
-                    // Set mesh color to -1 so that it gets init correct if a shader changes
-                    currentMeshColor.Set(-1, -1, -1, -1);
                 }
                 else {
                     currentMaterial->ApplyParamsOnly(currentShader);
                 }
             }
 
-            // shader bind obj override
-            if (currentOverrideShaderBindObj != cmd.shaderBindOverride) {
-                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-                m_instanceMatrices.clear();
+            // shader bind obj override, overrides with the same values (e.g. sprites with the same texture) share a batch,
+            // the key is a hash, so equal keys of different objects get their values compared
+            uint64_t overrideKey = (cmd.shaderBindOverride) ? cmd.shaderBindOverride->GetBindKey() : 0;
+            if (currentOverrideKey != overrideKey ||
+                (overrideKey != 0 && cmd.shaderBindOverride != currentOverrideShaderBindObj &&
+                !cmd.shaderBindOverride->HasSameParams(*currentOverrideShaderBindObj))) {
+                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instances);
 
                 currentOverrideShaderBindObj = cmd.shaderBindOverride;
+                currentOverrideKey = overrideKey;
             }
 
             if (currentMaterialID.value == ENGINE_INVALID_ID ||
@@ -250,20 +476,10 @@ namespace EngineCore {
                 continue;
             }
 
-            // if mesh color changes
-            if (currentMeshColor.x == -1 || currentMeshColor.SquaredMagnitude() != cmd.meshColor.SquaredMagnitude()) {
-                currentMeshColor = cmd.meshColor;
-
-                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-                m_instanceMatrices.clear();
-                currentShader->SetVector4("umeshColor", currentMeshColor);
-            }
-
             if (currentMeshID != cmd.meshID || 
                 currentInvertMesh != cmd.invertMesh) {
 
-                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-                m_instanceMatrices.clear();
+                flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instances);
         
                 currentMeshID = cmd.meshID;
                 currentMesh = rm->GetMesh(currentMeshID);;
@@ -276,21 +492,19 @@ namespace EngineCore {
             }
         
             if (cmd.modelMatrix) {
-                m_instanceMatrices.push_back(*cmd.modelMatrix);
+                InstanceData& instance = m_instances.emplace_back();
+                std::memcpy(instance.model, cmd.modelMatrix->ToOpenGLData(), sizeof(instance.model));
+                instance.color = cmd.meshColor;
+                instance.uvRect = cmd.uvRect;
+                instance.params = cmd.instanceParams;
+                instance.custom = cmd.instanceCustom;
             }
         }
         
-        flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instanceMatrices);
-        // turn depth testing on if UI turned of
-        glEnable(GL_DEPTH_TEST);
-
-        // PrintCommands(true);
-        m_commands.clear();
-        m_instanceMatrices.clear();
+        flushBatch(currentMesh, currentShader, currentOverrideShaderBindObj, currentInvertMesh, m_instances);
     }
 
-    void Renderer::SortDrawCommands(std::shared_ptr<Component::Camera> cameraPtr) {
-        Vector3 camPos = cameraPtr->GetGameObject()->GetTransform()->GetWorldPosition();
+    void Renderer::SortDrawCommands(const Vector3& viewPosition) {
 
         auto it = std::stable_partition(m_commands.begin(), m_commands.end(),
             [](const RenderCommand& cmd) { return !cmd.isUI; });
@@ -318,13 +532,11 @@ namespace EngineCore {
                     if (a.materialID != b.materialID) return a.materialID < b.materialID;
                     if (a.meshID != b.meshID) return a.meshID < b.meshID;
 
-                    if (a.shaderBindOverride != b.shaderBindOverride)
-                        return a.shaderBindOverride == nullptr;
-
-                    float aSQM = a.meshColor.SquaredMagnitude();
-                    float bSQM = b.meshColor.SquaredMagnitude();
-                    if (aSQM != bSQM)
-                        return aSQM > bSQM;
+                    // the color is an instance attribute and does not need to be sorted
+                    uint64_t keyA = (a.shaderBindOverride) ? a.shaderBindOverride->GetBindKey() : 0;
+                    uint64_t keyB = (b.shaderBindOverride) ? b.shaderBindOverride->GetBindKey() : 0;
+                    if (keyA != keyB)
+                        return keyA < keyB;
                     return a.invertMesh < b.invertMesh;
                 }
 
@@ -332,8 +544,8 @@ namespace EngineCore {
                 if (a.isTransparent && b.isTransparent) {
                     Vector3 posA = a.modelMatrix ? a.modelMatrix->GetTranslation() : Vector3::zero;
                     Vector3 posB = b.modelMatrix ? b.modelMatrix->GetTranslation() : Vector3::zero;
-                    float distA = Vector3::SquaredDistance(camPos, posA);
-                    float distB = Vector3::SquaredDistance(camPos, posB);
+                    float distA = Vector3::SquaredDistance(viewPosition, posA);
+                    float distB = Vector3::SquaredDistance(viewPosition, posB);
                     return distA > distB;
                 }
 
@@ -189,6 +189,10 @@ namespace EngineCore {
         return it->second.get();
     }
 
+    SpriteAtlas& ResourceManager::GetSpriteAtlas() {
+        return m_spriteAtlas;
+    }
+
     #pragma endregion
 
     const FontAsset::Glyph& ResourceManager::GetFontGlyph(FontID id, char c, int pixelSize) {
@@ -347,6 +351,8 @@ namespace EngineCore {
     #pragma region Delete_Asset
 
     void ResourceManager::DeleteAsset(Texture2DID id) {
+        // the id can be handed out again, so the region must not stay
+        m_spriteAtlas.Remove(id);
         DeleteAssetInternal<Texture2DID, std::unique_ptr<Texture2D>>(m_texture2Ds, AssetType::TEXTURE2D, id);
     }
 
@@ -373,6 +379,8 @@ namespace EngineCore {
     }
 
     void ResourceManager::Cleanup() {
+        // deletes the page textures
+        m_spriteAtlas.Clear();
         for (auto& [id, texture] : m_texture2Ds) { texture->DeleteGL(); }
         for (auto& [id, mesh] : m_meshes) { mesh->DeleteGL(); }
         for (auto& [id, shader] : m_shaders) { shader->DeleteGL(); }
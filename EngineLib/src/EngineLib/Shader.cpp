@@ -1,11 +1,11 @@
-﻿#include <glad/glad.h>
-#include <fstream>
+﻿#include <fstream>
 #include <sstream>
 #include <iostream>
 
 #include <CoreLib\Log.h>
 #include <CoreLib\Math.h>
 
+#include "EngineLib\Renderer.h"
 #include "EngineLib\Shader.h"
 
 namespace EngineCore {
@@ -15,10 +15,8 @@ namespace EngineCore {
 	}
 
 	bool Shader::IsActive() const {
-		GLint currentProgram = 0;
-		glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
-
-		return (static_cast<GLint>(m_ID.value) == currentProgram);
+		// the device tracks the program, no glGet round trip
+		return Renderer::GetDevice()->GetCurrentProgram() == m_ID.value;
 	}
 
 	Shader::Shader() {
@@ -76,12 +74,12 @@ namespace EngineCore {
 			Log::Warn("Shader: Could not Use Shader. GL ShaderProgram was not created");
 			return;
 		}
-		glUseProgram(m_ID.value);
+		Renderer::GetDevice()->UseProgram(m_ID.value);
 	}
 
 	void Shader::Unbind() {
 		if (!IsActive()) return;
-		glUseProgram(0);
+		Renderer::GetDevice()->UseProgram(0);
 	}
 
 	void Shader::CreateGL() {
@@ -93,55 +91,12 @@ namespace EngineCore {
 			return;
 		}
 
-		const char* vShaderCode = m_vertexCode.c_str();
-		const char* fShaderCode = m_fragmentCode.c_str();
-
-		unsigned int vertex, fragment;
-		int success;
-		char infoLog[512];
-		// vertex Shader
-		vertex = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(vertex, 1, &vShaderCode, NULL);
-		glCompileShader(vertex);
-		// print compile errors if any
-		glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
-		if (!success)
-		{
-			glGetShaderInfoLog(vertex, 512, NULL, infoLog);
-			Log::Error("Shader: VERTEX::COMPILATION_FAILED\n{}", infoLog);
-		};
-
-		// fragment Shader
-		fragment = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(fragment, 1, &fShaderCode, NULL);
-		glCompileShader(fragment);
-		// print compile errors if any
-		glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-		if (!success)
-		{
-			glGetShaderInfoLog(fragment, 512, NULL, infoLog);
-			Log::Error("Shader: FRAGMENT::COMPILATION_FAILED\n{}", infoLog);
-		};
-
-		m_ID.value = glCreateProgram();
-		glAttachShader(m_ID.value, vertex);
-		glAttachShader(m_ID.value, fragment);
-		glLinkProgram(m_ID.value);
-		// print linking errors if any
-		glGetProgramiv(m_ID.value, GL_LINK_STATUS, &success);
-		if (!success)
-		{
-			glGetProgramInfoLog(m_ID.value, 512, NULL, infoLog);
-			Log::Error("Shader: PROGRAM::LINKING_FAILED\n{}", infoLog);
-		}
-		// delete shaders; they’re linked into our program and no longer necessary
-		glDeleteShader(vertex);
-		glDeleteShader(fragment);
+		m_ID.value = Renderer::GetDevice()->CreateProgram(m_vertexCode, m_fragmentCode);
 	}
 
 	void Shader::DeleteGL() {
 		if (m_ID.value == ENGINE_INVALID_ID) return;
-		glDeleteProgram(m_ID.value);
+		Renderer::GetDevice()->DeleteProgram(m_ID.value);
 		m_ID.value = ENGINE_INVALID_ID;
 	}
 
@@ -161,37 +116,46 @@ namespace EngineCore {
 	void Shader::SetBool(const std::string& name, bool value) const {
 		if (!CanSetValue("SetBool", name)) return;
 
-		glUniform1i(glGetUniformLocation(m_ID.value, name.c_str()), (int)value);
+		RenderDevice* device = Renderer::GetDevice();
+		device->SetUniformInt(device->GetUniformLocation(m_ID.value, name), (int)value);
 	}
 
 	void Shader::SetInt(const std::string& name, int value) const {
 		if (!CanSetValue("SetInt", name)) return;
 
-		glUniform1i(glGetUniformLocation(m_ID.value, name.c_str()), value);
+		RenderDevice* device = Renderer::GetDevice();
+		device->SetUniformInt(device->GetUniformLocation(m_ID.value, name), value);
 	}
 
 	void Shader::SetFloat(const std::string& name, float value) const {
 		if (!CanSetValue("SetFloat", name)) return;
 
-		glUniform1f(glGetUniformLocation(m_ID.value, name.c_str()), value);
+		RenderDevice* device = Renderer::GetDevice();
+		device->SetUniformFloats(device->GetUniformLocation(m_ID.value, name), &value, 1);
 	}
 
 	void Shader::SetVector2(const std::string& name, const Vector2& value) const {
 		if (!CanSetValue("SetVector2", name)) return;
 
-		glUniform2f(glGetUniformLocation(m_ID.value, name.c_str()), value.x, value.y);
+		RenderDevice* device = Renderer::GetDevice();
+		float values[2] = { value.x, value.y };
+		device->SetUniformFloats(device->GetUniformLocation(m_ID.value, name), values, 2);
 	}
 
 	void Shader::SetVector3(const std::string& name, const Vector3& value) const {
 		if (!CanSetValue("SetVector3", name)) return;
 
-		glUniform3f(glGetUniformLocation(m_ID.value, name.c_str()), value.x, value.y, value.z);
+		RenderDevice* device = Renderer::GetDevice();
+		float values[3] = { value.x, value.y, value.z };
+		device->SetUniformFloats(device->GetUniformLocation(m_ID.value, name), values, 3);
 	}
 
 	void Shader::SetVector4(const std::string& name, const Vector4& value) const {
 		if (!CanSetValue("SetVector4", name)) return;
 
-		glUniform4f(glGetUniformLocation(m_ID.value, name.c_str()), value.x, value.y, value.z, value.w);
+		RenderDevice* device = Renderer::GetDevice();
+		float values[4] = { value.x, value.y, value.z, value.w };
+		device->SetUniformFloats(device->GetUniformLocation(m_ID.value, name), values, 4);
 	}
 
 #pragma region SetMatrix
@@ -199,61 +163,61 @@ namespace EngineCore {
 	void Shader::SetMatrix2(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 2, 2, data);
 	}
 
 	void Shader::SetMatrix3(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 3, 3, data);
 	}
 
 	void Shader::Shader::SetMatrix4(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 4, 4, data);
 	}
 
 	void Shader::SetMatrix2x3(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix2x3fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 2, 3, data);
 	}
 
 	void Shader::SetMatrix3x2(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix3x2fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 3, 2, data);
 	}
 
 	void Shader::SetMatrix2x4(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix2x4fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 2, 4, data);
 	}
 
 	void Shader::SetMatrix4x2(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix4x2fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 4, 2, data);
 	}
 
 	void Shader::SetMatrix3x4(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix3x4fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 3, 4, data);
 	}
 
 	void Shader::SetMatrix4x3(const std::string& name, const float* data) const {
 		if (!CanSetValue("SetMatrix", name)) return;
 
-		glUniformMatrix4x3fv(GetUniformLocation(name), 1, GL_FALSE, data);
+		Renderer::GetDevice()->SetUniformMatrix(GetUniformLocation(name), 4, 3, data);
 	}
 
 #pragma endregion
 
 	int Shader::GetUniformLocation(const std::string& name) const {
-		int location = glGetUniformLocation(m_ID.value, name.c_str());
+		int location = Renderer::GetDevice()->GetUniformLocation(m_ID.value, name);
 		if (location == -1) {
 			Log::Warn("Shader: Param {} was not found", name);
 			return -1;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <CoreLib/FormatUtils.h>
 
 #include "EngineLib/ResourceManager.h"
@@ -94,6 +95,114 @@ namespace EngineCore {
 		return m_isTransparent;
 	}
 
+	uint64_t ShaderBindObject::GetBindKey() const {
+		if (m_bindKeyDirty) {
+			m_bindKey = ComputeBindKey();
+			m_bindKeyDirty = false;
+		}
+		return m_bindKey;
+	}
+
+	namespace {
+		// FNV-1a
+		uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; i++) {
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		uint64_t HashParam(int type, const std::string& name, const void* value, size_t size) {
+			uint64_t hash = HashBytes(&type, sizeof(type));
+			hash = HashBytes(name.data(), name.size(), hash);
+			return HashBytes(value, size, hash);
+		}
+
+		template<typename T>
+		bool SameParams(const std::unordered_map<std::string, T>& a, const std::unordered_map<std::string, T>& b) {
+			if (a.size() != b.size())
+				return false;
+			for (const auto& [name, value] : a) {
+				auto it = b.find(name);
+				if (it == b.end() || !(it->second == value))
+					return false;
+			}
+			return true;
+		}
+
+		bool SameMatrix(const Matrix& a, const Matrix& b) {
+			if (a.GetRowCount() != b.GetRowCount() || a.GetColCount() != b.GetColCount())
+				return false;
+			return std::equal(a.GetData(), a.GetData() + a.GetRowCount() * a.GetColCount(), b.GetData());
+		}
+	}
+
+	bool ShaderBindObject::HasSameParams(const ShaderBindObject& other) const {
+		if (this == &other)
+			return true;
+		if (GetBindKey() != other.GetBindKey())
+			return false;
+
+		if (!SameParams(m_boolParams, other.m_boolParams) ||
+			!SameParams(m_intParams, other.m_intParams) ||
+			!SameParams(m_floatParams, other.m_floatParams) ||
+			!SameParams(m_vector2Params, other.m_vector2Params) ||
+			!SameParams(m_vector3Params, other.m_vector3Params) ||
+			!SameParams(m_vector4Params, other.m_vector4Params) ||
+			!SameParams(m_textureParams, other.m_textureParams))
+			return false;
+
+		if (m_matrixParams.size() != other.m_matrixParams.size())
+			return false;
+		for (const auto& [name, value] : m_matrixParams) {
+			auto it = other.m_matrixParams.find(name);
+			if (it == other.m_matrixParams.end() || !SameMatrix(it->second, value))
+				return false;
+		}
+		return true;
+	}
+
+	uint64_t ShaderBindObject::ComputeBindKey() const {
+		// the entries are summed up, so the iteration order of the maps does not matter
+		uint64_t key = 0;
+		for (const auto& [name, value] : m_boolParams) {
+			key += HashParam(0, name, &value, sizeof(value));
+		}
+		for (const auto& [name, value] : m_intParams) {
+			key += HashParam(1, name, &value, sizeof(value));
+		}
+		for (const auto& [name, value] : m_floatParams) {
+			key += HashParam(2, name, &value, sizeof(value));
+		}
+		for (const auto& [name, value] : m_vector2Params) {
+			float f[] = { value.x, value.y };
+			key += HashParam(3, name, f, sizeof(f));
+		}
+		for (const auto& [name, value] : m_vector3Params) {
+			float f[] = { value.x, value.y, value.z };
+			key += HashParam(4, name, f, sizeof(f));
+		}
+		for (const auto& [name, value] : m_vector4Params) {
+			float f[] = { value.x, value.y, value.z, value.w };
+			key += HashParam(5, name, f, sizeof(f));
+		}
+		for (const auto& [name, value] : m_matrixParams) {
+			key += HashParam(6, name, value.GetData(), sizeof(float) * value.GetRowCount() * value.GetColCount());
+		}
+		for (const auto& [name, value] : m_textureParams) {
+			key += HashParam(7, name, &value.value, sizeof(value.value));
+		}
+
+		// a non empty object never gets the key of the empty one
+		if (key == 0 && !(m_boolParams.empty() && m_intParams.empty() && m_floatParams.empty() &&
+			m_vector2Params.empty() && m_vector3Params.empty() && m_vector4Params.empty() &&
+			m_matrixParams.empty() && m_textureParams.empty()))
+			key = 1;
+		return key;
+	}
+
 	std::vector<bool> ShaderBindObject::GetParamBools() const {
 		return GetParamsImpl<bool>(m_boolParams);
 	}
@@ -173,7 +282,7 @@ namespace EngineCore {
 	void ShaderBindObject::SetIsTransparent(Texture2DID id) {
 		auto* rm = ResourceManager::GetInstance();
 		auto tex = rm->GetTexture2D(id);
-		if (tex->GetNrChannels() > 3)
+		if (tex && tex->GetNrChannels() > 3)
 			m_isTransparent = true;
 	}
 
@@ -0,0 +1,244 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <CoreLib/Log.h>
+
+#include "EngineLib/ResourceManager.h"
+#include "EngineLib/SpriteAtlas.h"
+
+namespace EngineCore {
+
+    SpriteAtlas::SpriteAtlas(int pageSize, int padding, int maxSpriteSize)
+        : m_pageSize(pageSize), m_padding(padding), m_maxSpriteSize(std::min(maxSpriteSize, pageSize - 2 * padding)) {
+    }
+
+    bool SpriteAtlas::Pack(Texture2DID id, Region& outRegion) {
+        if (TryGetRegion(id, outRegion))
+            return true;
+
+        ResourceManager* rm = ResourceManager::GetInstance();
+        Texture2D* texture = rm->GetTexture2D(id);
+        if (!texture)
+            return false;
+
+        int width = texture->GetWidth();
+        int height = texture->GetHeight();
+        if (width <= 0 || height <= 0 || width > m_maxSpriteSize || height > m_maxSpriteSize)
+            return false;
+
+        std::vector<unsigned char> pixels;
+        if (!texture->GetPixelsRGBA(pixels))
+            return false;
+
+        // find a page with the same filter and space left
+        int blockWidth = width + 2 * m_padding;
+        int blockHeight = height + 2 * m_padding;
+        unsigned int filter = texture->GetFilterMag();
+        Page* page = nullptr;
+        int x = 0;
+        int y = 0;
+        size_t shelf = 0;
+        for (auto& p : m_pages) {
+            if (p.filter == filter && Allocate(p, blockWidth, blockHeight, x, y, shelf)) {
+                page = &p;
+                break;
+            }
+        }
+        if (!page) {
+            page = CreatePage(filter);
+            if (!page || !Allocate(*page, blockWidth, blockHeight, x, y, shelf))
+                return false;
+        }
+
+        // copy the sprite into the middle of the block and repeat its edge pixels into the padding
+        m_blockBuffer.resize(static_cast<size_t>(blockWidth) * blockHeight * 4);
+        for (int by = 0; by < blockHeight; by++) {
+            int sy = std::clamp(by - m_padding, 0, height - 1);
+            for (int bx = 0; bx < blockWidth; bx++) {
+                int sx = std::clamp(bx - m_padding, 0, width - 1);
+                std::memcpy(&m_blockBuffer[(static_cast<size_t>(by) * blockWidth + bx) * 4],
+                    &pixels[(static_cast<size_t>(sy) * width + sx) * 4], 4);
+            }
+        }
+
+        Texture2D* pageTexture = rm->GetTexture2D(page->texture);
+        if (!pageTexture) {
+            Free(*page, shelf, x, blockWidth);
+            return false;
+        }
+        pageTexture->UpdateRegion(x, y, blockWidth, blockHeight, m_blockBuffer.data());
+        page->spriteCount++;
+
+        float size = static_cast<float>(m_pageSize);
+        Region region;
+        region.texture = page->texture;
+        region.uvRect.Set(
+            static_cast<float>(x + m_padding) / size,
+            static_cast<float>(y + m_padding) / size,
+            static_cast<float>(width) / size,
+            static_cast<float>(height) / size);
+        region.serial = m_nextSerial++;
+        m_placements[id] = { region, shelf, x, blockWidth };
+
+        outRegion = region;
+        return true;
+    }
+
+    bool SpriteAtlas::TryGetRegion(Texture2DID id, Region& outRegion) const {
+        auto it = m_placements.find(id);
+        if (it == m_placements.end())
+            return false;
+        outRegion = it->second.region;
+        return true;
+    }
+
+    void SpriteAtlas::Remove(Texture2DID id) {
+        auto it = m_placements.find(id);
+        if (it == m_placements.end())
+            return;
+        Placement placement = it->second;
+        m_placements.erase(it);
+        m_generation++;
+
+        auto page = std::find_if(m_pages.begin(), m_pages.end(),
+            [&](const Page& p) { return p.texture == placement.region.texture; });
+        if (page == m_pages.end())
+            return;
+
+        if (--page->spriteCount == 0) {
+            // no sprite uses the page anymore
+            Texture2DID texture = page->texture;
+            m_pages.erase(page);
+            if (ResourceManager* rm = ResourceManager::GetInstance())
+                rm->DeleteAsset(texture);
+            return;
+        }
+        Free(*page, placement.shelf, placement.x, placement.width);
+    }
+
+    void SpriteAtlas::Clear() {
+        ResourceManager* rm = ResourceManager::GetInstance();
+        if (rm) {
+            for (auto& page : m_pages)
+                rm->DeleteAsset(page.texture);
+        }
+        m_pages.clear();
+        m_placements.clear();
+        m_generation++;
+    }
+
+    size_t SpriteAtlas::GetPageCount() const {
+        return m_pages.size();
+    }
+
+    size_t SpriteAtlas::GetSpriteCount() const {
+        return m_placements.size();
+    }
+
+    uint64_t SpriteAtlas::GetGeneration() const {
+        return m_generation;
+    }
+
+    bool SpriteAtlas::Allocate(Page& page, int width, int height, int& outX, int& outY, size_t& outShelf) {
+        auto findSpan = [width](Shelf& shelf) {
+            return std::find_if(shelf.freeSpans.begin(), shelf.freeSpans.end(),
+                [width](const Span& span) { return span.width >= width; });
+        };
+
+        // the lowest shelf the block fits on wastes the least height
+        Shelf* best = nullptr;
+        for (auto& shelf : page.shelves) {
+            if (shelf.height < height || (best && shelf.height >= best->height))
+                continue;
+            if (shelf.x + width <= m_pageSize || findSpan(shelf) != shelf.freeSpans.end())
+                best = &shelf;
+        }
+
+        if (!best) {
+            if (page.nextShelfY + height > m_pageSize || width > m_pageSize)
+                return false;
+            page.shelves.push_back({ page.nextShelfY, height, 0, {} });
+            page.nextShelfY += height;
+            best = &page.shelves.back();
+        }
+
+        outY = best->y;
+        outShelf = static_cast<size_t>(best - page.shelves.data());
+
+        // fills the gaps of removed blocks first
+        auto span = findSpan(*best);
+        if (span != best->freeSpans.end()) {
+            outX = span->x;
+            span->x += width;
+            span->width -= width;
+            if (span->width == 0)
+                best->freeSpans.erase(span);
+            return true;
+        }
+
+        outX = best->x;
+        best->x += width;
+        return true;
+    }
+
+    void SpriteAtlas::Free(Page& page, size_t shelfIndex, int x, int width) {
+        if (shelfIndex >= page.shelves.size())
+            return;
+        Shelf& shelf = page.shelves[shelfIndex];
+        auto& spans = shelf.freeSpans;
+
+        if (x + width == shelf.x) {
+            // the last block of the shelf, a free span that ends here is free up to the end now
+            shelf.x = x;
+            if (!spans.empty() && spans.back().x + spans.back().width == shelf.x) {
+                shelf.x = spans.back().x;
+                spans.pop_back();
+            }
+        }
+        else {
+            auto next = std::lower_bound(spans.begin(), spans.end(), x,
+                [](const Span& span, int value) { return span.x < value; });
+            next = spans.insert(next, { x, width });
+            // merges with the neighbours
+            auto following = next + 1;
+            if (following != spans.end() && next->x + next->width == following->x) {
+                next->width += following->width;
+                spans.erase(following);
+            }
+            if (next != spans.begin()) {
+                auto previous = next - 1;
+                if (previous->x + previous->width == next->x) {
+                    previous->width += next->width;
+                    spans.erase(next);
+                }
+            }
+        }
+
+        while (!page.shelves.empty() && page.shelves.back().x == 0) {
+            page.nextShelfY -= page.shelves.back().height;
+            page.shelves.pop_back();
+        }
+    }
+
+    SpriteAtlas::Page* SpriteAtlas::CreatePage(unsigned int filter) {
+        ResourceManager* rm = ResourceManager::GetInstance();
+        std::vector<unsigned char> empty(static_cast<size_t>(m_pageSize) * m_pageSize * 4, 0);
+        Texture2DID id = rm->AddTexture2DFromMemory(empty.data(), m_pageSize, m_pageSize, 4);
+        Texture2D* texture = rm->GetTexture2D(id);
+        if (!texture) {
+            Log::Error("SpriteAtlas: Could not create page {}", m_pages.size());
+            return nullptr;
+        }
+
+        // mipmaps would mix neighbouring sprites
+        texture->SetWrapping(GL_CLAMP_TO_EDGE);
+        texture->SetFilter(filter);
+        texture->SetGenerateMipmaps(false);
+
+        Page& page = m_pages.emplace_back();
+        page.texture = id;
+        page.filter = filter;
+        return &page;
+    }
+
+}
@@ -8,6 +8,7 @@
 #include <CoreLib\Math.h>
 #include <CoreLib\stb_image.h>
 
+#include "EngineLib\Renderer.h"
 #include "EngineLib\Texture2D.h"
 
 namespace EngineCore {
@@ -72,51 +73,13 @@ namespace EngineCore {
 		m_exists = true;
 		m_path = path;
 
-		// create texture
-		glGenTextures(1, &m_opengGLID);
-		glBindTexture(GL_TEXTURE_2D, m_opengGLID);
-		// set the texture wrapping/filtering options (on currently bound texture)
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_wrappingX);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_wrappingY);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_filterMin);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_filterMag);
 		// load and generate the texture
 		unsigned char* imageData = stbi_load(path, &m_width, &m_height, &m_nrChannels, 0);
 
-
 		if (imageData) {
-			GLenum dataFormat, internalFormat;
-			if (m_nrChannels == 1) {
-				dataFormat = GL_RED;
-				internalFormat = GL_R8;
-			}
-			else if (m_nrChannels == 3) {
-				dataFormat = GL_RGB;
-				internalFormat = GL_RGB8;
-			}
-			else if (m_nrChannels == 4) {
-				dataFormat = GL_RGBA;
-				internalFormat = GL_RGBA8;
-			}
-			else {
-				Log::Error("Texture2D: Unsupported number of channels: {}!", m_nrChannels);
+			if (!CreateTexture(imageData)) {
 				LoadTextureFallback();
-				stbi_image_free(imageData);
 				m_exists = false;
-				return;
-			}
-
-			int rowBytes = m_width * m_nrChannels;
-			int alignment = 4;
-			if (rowBytes % 4 != 0) alignment = 1;
-			glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-
-			glTexImage2D(GL_TEXTURE_2D, 0, internalFormat,
-				m_width, m_height, 0,
-				dataFormat, GL_UNSIGNED_BYTE, imageData);
-
-			if (m_createMipmaps) {
-				glGenerateMipmap(GL_TEXTURE_2D);
 			}
 		}
 		else {
@@ -140,51 +103,14 @@ namespace EngineCore {
 		m_imageData = new unsigned char[width * height * nrChannels];
 		std::memcpy(m_imageData, data, width * height * nrChannels);
 
-		// create texture
-		glGenTextures(1, &m_opengGLID);
-		glBindTexture(GL_TEXTURE_2D, m_opengGLID);
-		// set the texture wrapping/filtering options (on currently bound texture)
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_wrappingX);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_wrappingY);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_filterMin);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_filterMag);
-
 		m_width = width;
 		m_height = height;
 		m_nrChannels = nrChannels;
 
 		if (data) {
-			GLenum dataFormat, internalFormat;
-			if (m_nrChannels == 1) {
-				dataFormat = GL_RED;
-				internalFormat = GL_R8;
-			}
-			else if (m_nrChannels == 3) {
-				dataFormat = GL_RGB;
-				internalFormat = GL_RGB8;
-			}
-			else if (m_nrChannels == 4) {
-				dataFormat = GL_RGBA;
-				internalFormat = GL_RGBA8;
-			}
-			else {
-				Log::Error("Texture2D: Unsupported number of channels: {}!", m_nrChannels);
+			if (!CreateTexture(data)) {
 				LoadTextureFallback();
 				m_exists = false;
-				return;
-			}
-
-			int rowBytes = m_width * m_nrChannels;
-			int alignment = 4;
-			if (rowBytes % 4 != 0) alignment = 1;
-			glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-
-			glTexImage2D(GL_TEXTURE_2D, 0, internalFormat,
-				m_width, m_height, 0,
-				dataFormat, GL_UNSIGNED_BYTE, data);
-
-			if (m_createMipmaps) {
-				glGenerateMipmap(GL_TEXTURE_2D);
 			}
 		}
 		else {
@@ -194,6 +120,26 @@ namespace EngineCore {
 		}
 	}
 
+	bool Texture2D::CreateTexture(const unsigned char* data) {
+		TextureDesc desc;
+		desc.width = m_width;
+		desc.height = m_height;
+		desc.channels = m_nrChannels;
+		desc.wrapX = m_wrappingX;
+		desc.wrapY = m_wrappingY;
+		desc.filterMin = m_filterMin;
+		desc.filterMag = m_filterMag;
+		desc.mipmaps = m_createMipmaps;
+
+		GpuHandle texture = Renderer::GetDevice()->CreateTexture2D(desc, data);
+		if (texture == 0) {
+			Log::Error("Texture2D: Unsupported number of channels: {}!", m_nrChannels);
+			return false;
+		}
+		m_opengGLID = texture;
+		return true;
+	}
+
 	void Texture2D::CreateGL() {
 		if (m_exists) return;
 
@@ -212,7 +158,7 @@ namespace EngineCore {
 		if (!m_exists) return;
 
 		if (m_opengGLID != ENGINE_INVALID_ID) {
-			glDeleteTextures(1, &m_opengGLID);
+			Renderer::GetDevice()->DeleteTexture(m_opengGLID);
 			m_opengGLID = ENGINE_INVALID_ID;
 		}
 
@@ -268,24 +214,69 @@ namespace EngineCore {
 		return data;
 	}
 
+	void Texture2D::UpdateRegion(int x, int y, int width, int height, const unsigned char* data) {
+		if (!data || x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > m_width || y + height > m_height) {
+			Log::Error("Texture2D: Cant update region {}x{} at {}, {}, it is outside of the texture!", width, height, x, y);
+			return;
+		}
+
+		if (m_imageData != nullptr) {
+			size_t rowBytes = static_cast<size_t>(width) * m_nrChannels;
+			for (int row = 0; row < height; row++) {
+				size_t dst = (static_cast<size_t>(y + row) * m_width + x) * m_nrChannels;
+				std::memcpy(m_imageData + dst, data + row * rowBytes, rowBytes);
+			}
+		}
+
+		if (m_exists && m_opengGLID != ENGINE_INVALID_ID)
+			Renderer::GetDevice()->UpdateTexture2D(m_opengGLID, x, y, width, height, m_nrChannels, data);
+	}
+
+	bool Texture2D::GetPixelsRGBA(std::vector<unsigned char>& outPixels) const {
+		int width = m_width;
+		int height = m_height;
+		int channels = m_nrChannels;
+		const unsigned char* source = m_imageData;
+
+		unsigned char* loadedData = nullptr;
+		if (source == nullptr && !m_path.empty()) {
+			loadedData = stbi_load(m_path.c_str(), &width, &height, &channels, 0);
+			source = loadedData;
+		}
+		if (source == nullptr || width <= 0 || height <= 0 || channels < 1 || channels == 2 || channels > 4) {
+			stbi_image_free(loadedData);
+			return false;
+		}
+
+		// same channel mapping as the GPU formats (R8 samples as r, 0, 0, 1)
+		size_t pixelCount = static_cast<size_t>(width) * height;
+		outPixels.resize(pixelCount * 4);
+		for (size_t i = 0; i < pixelCount; i++) {
+			const unsigned char* src = source + i * channels;
+			unsigned char* dst = outPixels.data() + i * 4;
+			dst[0] = src[0];
+			dst[1] = (channels >= 3) ? src[1] : 0;
+			dst[2] = (channels >= 3) ? src[2] : 0;
+			dst[3] = (channels == 4) ? src[3] : 255;
+		}
+
+		stbi_image_free(loadedData);
+		return true;
+	}
+
 	void Texture2D::Bind(unsigned int unit) {
 		if (!m_exists || m_opengGLID == ENGINE_INVALID_ID) {
 			CreateGL();
 		}
-		glActiveTexture(GL_TEXTURE0 + unit);
-		glBindTexture(GL_TEXTURE_2D, m_opengGLID);
+		Renderer::GetDevice()->BindTexture(unit, m_opengGLID);
 	}
 
 	void Texture2D::Unbind(unsigned int unit) {
-		glActiveTexture(GL_TEXTURE0 + unit);
-
-		GLint boundTexture = 0;
-		glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
-
-		if (static_cast<GLint>(m_opengGLID) != boundTexture)
+		RenderDevice* device = Renderer::GetDevice();
+		if (device->GetBoundTexture(unit) != m_opengGLID)
 			return;
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		device->BindTexture(unit, 0);
 	}
 
 	#pragma region Set
@@ -348,6 +339,10 @@ namespace EngineCore {
 		return m_nrChannels;
 	}
 
+	unsigned int Texture2D::GetFilterMag() const {
+		return m_filterMag;
+	}
+
 	#pragma endregion
 
 }
\ No newline at end of file
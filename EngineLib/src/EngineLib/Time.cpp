@@ -23,8 +23,12 @@ namespace EngineCore {
 		return m_frameCount;
 	}
 
+	void Time::SetClock(Clock clock) {
+		m_clock = std::move(clock);
+	}
+
 	float Time::GetTime() {
-		return static_cast<float>(glfwGetTime());
+		return static_cast<float>(GetTimeDouble());
 	}
 
 	float Time::GetDeltaTime() {
@@ -32,7 +36,7 @@ namespace EngineCore {
 	}
 
 	double Time::GetTimeDouble() {
-		return glfwGetTime();
+		return (m_clock) ? m_clock() : glfwGetTime();
 	}
 
 	double Time::GetDeltaTimeDouble() {
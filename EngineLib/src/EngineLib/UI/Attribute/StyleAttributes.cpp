@@ -167,6 +167,12 @@ namespace {
         "Sets the transition duration time between styles",
         "0s", AHel::NumberType::TIME);
 
+    const StyleAttribute EasingAtt = AttributeHelper::MakeSimpleStringAttribute(
+        Attribute::easing,
+        "Sets the curve of the transition between styles",
+        { "linear", "ease-in", "ease-out", "ease-in-out" },
+        "ease-in-out");
+
 }
 
 namespace EngineCore::UI::Init {
@@ -209,6 +215,7 @@ namespace EngineCore::UI::Init {
 
         StyleAttribute::RegisterAttribute(BorderRadius);
         StyleAttribute::RegisterAttribute(Duration);
+        StyleAttribute::RegisterAttribute(EasingAtt);
         return true;
     }
 
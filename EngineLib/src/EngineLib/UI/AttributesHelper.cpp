@@ -45,15 +45,15 @@ namespace EngineCore::UI {
 	}
 
 	bool AttributeHelper::TryGetUnit(const std::string& input, std::string& out) {
+		// longest match, otherwise "ms" would end with "s"
+		out.clear();
 		for (const auto& u : m_units) {
-			if (input.size() >= u.size() &&
-				input.rfind(u) == input.size() - u.size()) {
+			if (u.size() > out.size() && input.size() >= u.size() &&
+				input.compare(input.size() - u.size(), u.size(), u) == 0) {
 				out = u;
-				return true;
 			}
 		}
-		out.clear();
-		return false;
+		return !out.empty();
 	}
 
 	bool AttributeHelper::TryGetNumber(const std::string& input, float& outValue) {
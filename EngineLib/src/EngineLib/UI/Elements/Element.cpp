@@ -16,34 +16,16 @@ namespace EngineCore::UI {
         m_cmd.meshID = ASSETS::ENGINE::MESH::UIPlain();
         m_cmd.materialID = matID;
         m_baseStyle = UIManager::GetElementBaseStyle();
-
-        // subs to style dirty events
-        m_styleDirtyCallbackID = m_style->SubDirtCallback([this]() { m_styleDirty = true; });
-        m_baseStyleDirtyCallbackID = m_baseStyle->SubDirtCallback([this]() { m_styleDirty = true; });
-
-        m_mergedStyle = Style::Create("Merged", m_baseStyle);
-        m_mergedStyle->Extend(m_style);
+        m_mergedStyle = Style::GetMerged(m_baseStyle, m_style);
 	}
 
     ElementBase::~ElementBase() {
-        // unsubs to style dirty events
-        m_style->UnsubDirtyCallback(m_styleDirtyCallbackID);
-        m_baseStyle->UnsubDirtyCallback(m_baseStyleDirtyCallbackID);
     }
 
     void ElementBase::Init() {
         // inits the start propetys
         RegisterAttributesImpl();
         SetStyleAttributes();
-        InitShaderBindObject();
-    }
-
-    void ElementBase::InitShaderBindObject() {
-        m_sbo.SetParam("uBackgroundColor", m_backgroundColor);
-        m_sbo.SetParam("uBorderColor", m_borderColor);
-        m_sbo.SetParam("uBorderRadius", m_borderRadius);
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
-        m_sbo.SetParam("uSize", m_layoutSize);
     }
 
     void ElementBase::OnUIElementGUI(IUIElementDetailRenderer& ui) {
@@ -139,6 +121,7 @@ namespace EngineCore::UI {
             ui.DrawSeparatorText("Animation/Timing");
 
             ui.DrawLabel(FU::formatString("Duration: {}s", m_duration));
+            ui.DrawLabel(FU::formatString("Easing: {}", ToString(m_easing)));
         }
     }
 
@@ -212,6 +195,10 @@ namespace EngineCore::UI {
         return m_state; 
     }
 
+    bool ElementBase::IsCached() const {
+        return m_isCached;
+    }
+
 
     size_t ElementBase::GetChildCount() const {
         return m_children.size();
@@ -373,21 +360,18 @@ namespace EngineCore::UI {
         if (m_backgroundColor == color)
             return;
         m_backgroundColor = color;
-        m_sbo.SetParam("uBackgroundColor", m_backgroundColor);
     }
 
     void ElementBase::SetBorderColor(const Vector4& color) {
         if (m_borderColor == color)
             return;
         m_borderColor = color;
-        m_sbo.SetParam("uBorderColor", m_borderColor);
     }
 
     void ElementBase::SetBorderRadius(const Vector4& radius) {
         if (m_borderRadius == radius)
             return;
         m_borderRadius = radius;
-        m_sbo.SetParam("uBorderRadius", m_borderRadius);
     }
 
     void ElementBase::SetBorderWidth(float width) {
@@ -395,7 +379,6 @@ namespace EngineCore::UI {
         if (m_borderSize == Vector4(width))
             return;
         m_borderSize.Set(width);
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
         MarkTransDirtyParent();
     }
 
@@ -404,7 +387,6 @@ namespace EngineCore::UI {
         if (m_borderSize.x == top)
             return;
         m_borderSize.x = top;
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
         MarkTransDirtyParent();
     }
 
@@ -413,7 +395,6 @@ namespace EngineCore::UI {
         if (m_borderSize.y == right)
             return;
         m_borderSize.y = right;
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
         MarkTransDirtyParent();
     }
 
@@ -422,7 +403,6 @@ namespace EngineCore::UI {
         if (m_borderSize.z == bottom)
             return;
         m_borderSize.z = bottom;
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
         MarkTransDirtyParent();
     }
 
@@ -431,7 +411,6 @@ namespace EngineCore::UI {
         if (m_borderSize.w == left)
             return;
         m_borderSize.w = left;
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
         MarkTransDirtyParent();
     }
 
@@ -449,7 +428,6 @@ namespace EngineCore::UI {
             m_borderSize.w == hor)
             return;
         m_borderSize.Set(ver, hor, ver, hor);
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
         MarkTransDirtyParent();
     }
 
@@ -464,7 +442,6 @@ namespace EngineCore::UI {
             m_borderSize.w == left)
             return;
         m_borderSize.Set(top, right, bottom, left);
-        m_sbo.SetParam("uBorderWidth", m_borderSize);
         MarkTransDirtyParent();
     }
 
@@ -575,6 +552,18 @@ namespace EngineCore::UI {
         m_duration = duration;
     }
 
+    void ElementBase::SetEasing(Easing easing) {
+        m_easing = easing;
+    }
+
+    void ElementBase::SetCachedInternal(bool value) {
+        if (m_isCached == value)
+            return;
+        // the UIManager creates or deletes the layer with the next draw
+        m_isCached = value;
+        MarkRenderDirty();
+    }
+
     void ElementBase::SetLayoutSize(const Vector2& size) {
         SetLayoutSize(size.x, size.y);
     }
@@ -728,6 +717,10 @@ namespace EngineCore::UI {
         return m_duration;
     }
 
+    Easing ElementBase::GetEasing() const {
+        return m_easing;
+    }
+
     bool ElementBase::IsMouseOver(const Vector2& mousePos) {
         Vector2 pos = GetWorldPosition();
         Vector2 size = GetScreenSize();
@@ -764,14 +757,9 @@ namespace EngineCore::UI {
     }
 
     void ElementBase::SetStyleInternal(std::shared_ptr<Style> style) {
-        m_style->UnsubDirtyCallback(m_styleDirtyCallbackID);
         m_style = style;
-
-        if(m_style)
-            m_styleDirtyCallbackID = m_style->SubDirtCallback([this]() { m_styleDirty = true; });
-
-        m_mergedStyle = Style::Create("Merged", m_baseStyle);
-        m_mergedStyle->Extend(m_style);
+        m_mergedStyle = Style::GetMerged(m_baseStyle, m_style);
+        m_styleDirty = true;
     }
 
     void ElementBase::AddStyleInternal(std::shared_ptr<Style> style) {
@@ -788,17 +776,22 @@ namespace EngineCore::UI {
     }
 
     void ElementBase::ClearStyleInternal() {
-        if(m_style)
-            m_style->UnsubDirtyCallback(m_styleDirtyCallbackID);
-
-        m_styleDirtyCallbackID = 0;
         m_style = nullptr;
-
-        m_mergedStyle = Style::Create("Merged", m_baseStyle);
+        m_mergedStyle = Style::GetMerged(m_baseStyle, nullptr);
+        m_styleDirty = true;
     }
 
     void ElementBase::RegisterAttribute(const std::string& name, std::function<void(ElementBase*, const StyleValue&)> func) {
-        m_registeredAttributes[FormatUtils::toLowerCase(name)] = func;
+        const StyleAttribute* attribute = StyleAttribute::FindAttribute(name);
+        if (!attribute) {
+            Log::Warn("UI::Element: Could not register attribute '{}', it is not a StyleAttribute", name);
+            return;
+        }
+
+        size_t id = attribute->GetID();
+        if (id >= m_registeredAttributes.size())
+            m_registeredAttributes.resize(id + 1);
+        m_registeredAttributes[id] = func;
     }
 
     void ElementBase::UpdateLayoutPosition() {
@@ -839,8 +832,6 @@ namespace EngineCore::UI {
             m_margin.Set(0, 0, 0, 0);
             break;
         }
-
-        m_sbo.SetParam("uSize", m_layoutSize);
     }
 
     void ElementBase::UpdateWorldTransform() {
@@ -881,17 +872,49 @@ namespace EngineCore::UI {
         UIManager::SetRootElementTransDirty();
     }
 
+    size_t ElementBase::GetHierarchyVersion() {
+        return s_hierarchyVersion;
+    }
+
+    void ElementBase::MarkHierarchyChanged() {
+        s_hierarchyVersion++;
+    }
+
+    void ElementBase::MarkRenderDirty() {
+        if (LayerCache::GetLayerCount() == 0)
+            return;
+
+        LayerCache::Rect rect = LayerCache::Rect::FromModel(m_worldTransform);
+        for (ElementBase* element = this; element; element = element->m_parentElementPtr) {
+            if (element->m_layer) {
+                element->m_layer->AddDirtyRect(m_renderRect);
+                element->m_layer->AddDirtyRect(rect);
+            }
+        }
+        m_renderRect = rect;
+    }
+
     void ElementBase::MarkTransDirty() const {
+        // e.g. every child of a container changes its size in the same frame
+        if (m_subtreeDirty && !s_layoutRunning)
+            return;
+        m_subtreeDirty = !s_layoutRunning;
+
         m_transformDirty = true;
+        m_layoutCache.Invalidate();
         for (auto& child : m_children) {
             child->MarkTransDirty();
         }
     }
 
     void ElementBase::UpdateImpl() {
-        if (m_styleDirty) {
+        // styles only bump their generation when they change, this picks the change up once per frame
+        size_t styleGeneration = m_mergedStyle->GetGeneration();
+        if (m_styleDirty || styleGeneration != m_appliedStyleGeneration) {
             SetStyleAttributes();
+            m_appliedStyleGeneration = styleGeneration;
             m_styleDirty = false;
+            MarkRenderDirty();
         }
 
         Update();
@@ -901,6 +924,13 @@ namespace EngineCore::UI {
         m_cmd.renderLayerID = renderLayerID;
         m_cmd.modelMatrix = GetWorldModelMatrixPtr();
         m_cmd.shaderBindOverride = &m_sbo;
+        // per element values are instance attributes of the UI shader, so neighbouring elements
+        // with the same material are drawn in one instanced call (the size is the model scale).
+        // The DefaultUI shader reads the slots differently than the mesh shaders, see InstanceData
+        m_cmd.meshColor = m_backgroundColor;
+        m_cmd.uvRect = m_borderColor;
+        m_cmd.instanceParams = m_borderSize;
+        m_cmd.instanceCustom = m_borderRadius;
         SendDrawCommand(renderer);
     }
 
@@ -950,31 +980,31 @@ namespace EngineCore::UI {
 
             RegisterAttribute(att::width, [](ElementBase* el, const StyleValue& val) {
                 if (float f; val.TryGetValue<float>(f, att::width)) {
-                    el->SetDesiredWidth(f, val.GetUnit(0));
+                    el->TransitionTo(TransitionProperty::Width, f, val.GetUnit(0));
                 }
             });
 
             RegisterAttribute(att::height, [](ElementBase* el, const StyleValue& val) {
                 if (float f; val.TryGetValue<float>(f, att::height)) {
-                    el->SetDesiredHeight(f, val.GetUnit(0));
+                    el->TransitionTo(TransitionProperty::Height, f, val.GetUnit(0));
                 }
             });
 
             RegisterAttribute(att::backgroundColor, [](ElementBase* el, const StyleValue& val) {
                 if (Vector4 vec;  val.TryGetValue<Vector4>(vec, att::backgroundColor)) {
-                    el->SetBackgroundColor(vec);
+                    el->TransitionTo(TransitionProperty::BackgroundColor, vec);
                 }
             });
 
             RegisterAttribute(att::borderColor, [](ElementBase* el, const StyleValue& val) {
                 if (Vector4 vec;  val.TryGetValue<Vector4>(vec, att::borderColor)) {
-                    el->SetBorderColor(vec);
+                    el->TransitionTo(TransitionProperty::BorderColor, vec);
                 }
             });
 
             RegisterAttribute(att::borderRadius, [](ElementBase* el, const StyleValue& val) {
                 if (Vector4 vec;  val.TryGetValue<Vector4>(vec, att::borderRadius)) {
-                    el->SetBorderRadius(vec);
+                    el->TransitionTo(TransitionProperty::BorderRadius, vec);
                 }
             });
 
@@ -982,25 +1012,25 @@ namespace EngineCore::UI {
 
             RegisterAttribute(att::borderTop, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::borderTop)) {
-                    el->SetBorderTop(f);
+                    el->TransitionTo(TransitionProperty::BorderTop, f);
                 }
             });
 
             RegisterAttribute(att::borderLeft, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::borderLeft)) {
-                    el->SetBorderLeft(f);
+                    el->TransitionTo(TransitionProperty::BorderLeft, f);
                 }
             });
 
             RegisterAttribute(att::borderBottom, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::borderBottom)) {
-                    el->SetBorderBottom(f);
+                    el->TransitionTo(TransitionProperty::BorderBottom, f);
                 }
             });
 
             RegisterAttribute(att::borderRight, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::borderRight)) {
-                    el->SetBorderRight(f);
+                    el->TransitionTo(TransitionProperty::BorderRight, f);
                 }
             });
 
@@ -1010,25 +1040,25 @@ namespace EngineCore::UI {
 
             RegisterAttribute(att::marginTop, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::marginTop)) {
-                    el->SetMarginTop(f);
+                    el->TransitionTo(TransitionProperty::MarginTop, f);
                 }
             });
 
             RegisterAttribute(att::marginRight, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::marginRight)) {
-                    el->SetMarginRight(f);
+                    el->TransitionTo(TransitionProperty::MarginRight, f);
                 }
             });
 
             RegisterAttribute(att::marginBottom, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::marginBottom)) {
-                    el->SetMarginBottom(f);
+                    el->TransitionTo(TransitionProperty::MarginBottom, f);
                 }
             });
 
             RegisterAttribute(att::marginLeft, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::marginLeft)) {
-                    el->SetMarginLeft(f);
+                    el->TransitionTo(TransitionProperty::MarginLeft, f);
                 }
             });
 
@@ -1038,30 +1068,47 @@ namespace EngineCore::UI {
 
             RegisterAttribute(att::paddingTop, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::paddingTop)) {
-                    el->SetPaddingTop(f);
+                    el->TransitionTo(TransitionProperty::PaddingTop, f);
                 }
             });
 
             RegisterAttribute(att::paddingRight, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::paddingRight)) {
-                    el->SetPaddingRight(f);
+                    el->TransitionTo(TransitionProperty::PaddingRight, f);
                 }
             });
 
             RegisterAttribute(att::paddingBottom, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::paddingBottom)) {
-                    el->SetPaddingBottom(f);
+                    el->TransitionTo(TransitionProperty::PaddingBottom, f);
                 }
             });
 
             RegisterAttribute(att::paddingLeft, [](ElementBase* el, const StyleValue& val) {
                 if (float f;  val.TryGetValue<float>(f, att::paddingLeft)) {
-                    el->SetPaddingLeft(f);
+                    el->TransitionTo(TransitionProperty::PaddingLeft, f);
                 }
             });
 
             #pragma endregion
 
+            RegisterAttribute(att::duration, [](ElementBase* el, const StyleValue& val) {
+                if (float f;  val.TryGetValue<float>(f, att::duration)) {
+                    el->SetDuration(StyleUnit::EvaluateTimeUnit(f, val.GetUnit(0)));
+                }
+            });
+
+            RegisterAttribute(att::easing, [](ElementBase* el, const StyleValue& val) {
+                if (std::string easing; val.TryGetValue<std::string>(easing, att::easing)) {
+                    el->SetEasing(ToEasing(easing));
+                }
+            });
+
+            if (const StyleAttribute* attribute = StyleAttribute::FindAttribute(att::duration))
+                s_durationAttributeID = attribute->GetID();
+            if (const StyleAttribute* attribute = StyleAttribute::FindAttribute(att::easing))
+                s_easingAttributeID = attribute->GetID();
+
             RegisterAttributes();
         }
     }
@@ -1072,58 +1119,87 @@ namespace EngineCore::UI {
     }
 
     void ElementBase::SetStyleAttributes() {
+        // the compiled state already contains the normal state as a base
+        const CompiledStyle& compiled = m_mergedStyle->GetCompiled(m_state);
+
+        // the transition of the new state applies to all of its values, states without one snap
+        SetDuration(0.0f);
+        SetEasing(Easing::EaseInOut);
+        for (size_t id : { s_durationAttributeID, s_easingAttributeID }) {
+            if (compiled.Has(id) && id < m_registeredAttributes.size() && m_registeredAttributes[id])
+                m_registeredAttributes[id](this, compiled.Get(id));
+        }
 
-        // SetAttributes(m_baseStyle->GetAllState(m_state));
-        // // if state is not normal use normal state as a base
-        // if(m_state != State::Normal)
-        //     SetAttributes(m_style->GetAllState(State::Normal));
-        // SetAttributes(m_style->GetAllState(m_state));
-
-
-        //SetAttributes(m_baseStyle->GetAllState(m_state));
-        if (m_state != State::Normal)
-            SetAttributes(m_mergedStyle->GetAllState(State::Normal));
-        SetAttributes(m_mergedStyle->GetAllState(m_state));
-    }
-
-    void ElementBase::SetAttributes(const std::unordered_map<std::string, std::string>& attribute) {
-        for (auto& [name, valueStr] : attribute) {
-            const StyleValue& value = StyleAttribute::GetAttributeValue(name, valueStr);
-            auto it = m_registeredAttributes.find(FormatUtils::toLowerCase(name));
-            if (it != m_registeredAttributes.end()) {
-                it->second(this, value);
-            }
+        for (size_t id : compiled.GetSetIDs()) {
+            if (id < m_registeredAttributes.size() && m_registeredAttributes[id])
+                m_registeredAttributes[id](this, compiled.Get(id));
         }
+        m_styleApplied = true;
     }
 
-    Vector2 ElementBase::ComputeSiblingsTotalDesiredPixelSize() const {
-        if (!m_parentElementPtr) return Vector2();
-
-        auto& siblings = m_parentElementPtr->GetChildren();
+    void ElementBase::TransitionTo(TransitionProperty property, const Vector4& value, StyleUnit::Unit unit) {
+        // values of different size units can not be mixed
+        float duration = m_styleApplied ? m_duration : 0.0f;
+        if ((property == TransitionProperty::Width && m_sizeUnits[0] != unit) ||
+            (property == TransitionProperty::Height && m_sizeUnits[1] != unit))
+            duration = 0.0f;
 
-        Vector2 totalSize;
-        for (auto& child : siblings) {
-            // ignors this element 
-            if (child->GetID() != this->m_id) {
-                totalSize += child->m_desiredPixelSize + child->m_borderSize + child->m_margin;
-            }
+        UI::TransitionSystem& transitions = UIManager::m_transitions;
+        if (duration <= 0.0f && transitions.GetCount() == 0) {
+            SetTransitionValue(property, value, unit);
+            return;
+        }
+        transitions.Start(this, property, GetTransitionValue(property), value, duration, m_easing, unit);
+    }
+
+    void ElementBase::TransitionTo(TransitionProperty property, float value, StyleUnit::Unit unit) {
+        TransitionTo(property, Vector4(value, 0.0f, 0.0f, 0.0f), unit);
+    }
+
+    Vector4 ElementBase::GetTransitionValue(TransitionProperty property) const {
+        switch (property) {
+        case TransitionProperty::BackgroundColor: return m_backgroundColor;
+        case TransitionProperty::BorderColor: return m_borderColor;
+        case TransitionProperty::BorderRadius: return m_borderRadius;
+        case TransitionProperty::BorderTop: return Vector4(m_borderSize.x, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::BorderRight: return Vector4(m_borderSize.y, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::BorderBottom: return Vector4(m_borderSize.z, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::BorderLeft: return Vector4(m_borderSize.w, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::MarginTop: return Vector4(m_margin.x, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::MarginRight: return Vector4(m_margin.y, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::MarginBottom: return Vector4(m_margin.z, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::MarginLeft: return Vector4(m_margin.w, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::PaddingTop: return Vector4(m_padding.x, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::PaddingRight: return Vector4(m_padding.y, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::PaddingBottom: return Vector4(m_padding.z, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::PaddingLeft: return Vector4(m_padding.w, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::Width: return Vector4(m_desiredSize.x, 0.0f, 0.0f, 0.0f);
+        case TransitionProperty::Height: return Vector4(m_desiredSize.y, 0.0f, 0.0f, 0.0f);
+        default: return Vector4(0.0f, 0.0f, 0.0f, 0.0f);
         }
-        return totalSize;
     }
 
-    Vector2 ElementBase::ComputeSiblingsTotalLayoutSize() const {
-        if (!m_parentElementPtr) return Vector2();
-
-        auto& siblings = m_parentElementPtr->GetChildren();
-
-        Vector2 totalSize;
-        for (auto& child : siblings) {
-            // ignors this element 
-            if (child->GetID() != this->m_id) {
-                totalSize += child->m_layoutSize + child->m_borderSize + child->m_margin;
-            }
+    void ElementBase::SetTransitionValue(TransitionProperty property, const Vector4& value, StyleUnit::Unit unit) {
+        switch (property) {
+        case TransitionProperty::BackgroundColor: SetBackgroundColor(value); break;
+        case TransitionProperty::BorderColor: SetBorderColor(value); break;
+        case TransitionProperty::BorderRadius: SetBorderRadius(value); break;
+        case TransitionProperty::BorderTop: SetBorderTop(value.x); break;
+        case TransitionProperty::BorderRight: SetBorderRight(value.x); break;
+        case TransitionProperty::BorderBottom: SetBorderBottom(value.x); break;
+        case TransitionProperty::BorderLeft: SetBorderLeft(value.x); break;
+        case TransitionProperty::MarginTop: SetMarginTop(value.x); break;
+        case TransitionProperty::MarginRight: SetMarginRight(value.x); break;
+        case TransitionProperty::MarginBottom: SetMarginBottom(value.x); break;
+        case TransitionProperty::MarginLeft: SetMarginLeft(value.x); break;
+        case TransitionProperty::PaddingTop: SetPaddingTop(value.x); break;
+        case TransitionProperty::PaddingRight: SetPaddingRight(value.x); break;
+        case TransitionProperty::PaddingBottom: SetPaddingBottom(value.x); break;
+        case TransitionProperty::PaddingLeft: SetPaddingLeft(value.x); break;
+        case TransitionProperty::Width: SetDesiredWidth(value.x, unit); break;
+        case TransitionProperty::Height: SetDesiredHeight(value.x, unit); break;
+        default: break;
         }
-        return totalSize;
     }
 
     void ElementBase::CalculateDesiredPixels() {
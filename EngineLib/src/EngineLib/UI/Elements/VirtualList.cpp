@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <CoreLib/FormatUtils.h>
+
+#include "EngineLib/Input.h"
+#include "EngineLib/UI/UIManager.h"
+#include "EngineLib/UI/LayoutCalc/GridLayoutCalculator.h"
+#include "EngineLib/UI/Elements/VirtualList.h"
+
+namespace EngineCore::UI {
+
+    VirtualList::VirtualList(UIElementID id, std::shared_ptr<Style> style, std::shared_ptr<Style> itemStyle)
+        : Element<VirtualList>("VirtualList", id, style), m_itemStyle(std::move(itemStyle)) {
+        SetLayoutType(LayoutType::Grid);
+    }
+
+    VirtualList* VirtualList::SetMode(Mode mode) {
+        if (m_mode == mode)
+            return this;
+        m_mode = mode;
+        ResizePool(0);
+        return this;
+    }
+
+    VirtualList* VirtualList::SetItemCount(size_t count) {
+        if (m_itemCount == count)
+            return this;
+        m_itemCount = count;
+        // the indices shown by the items can change with the pool size
+        std::fill(m_boundIndices.begin(), m_boundIndices.end(), UNBOUND_INDEX);
+        return this;
+    }
+
+    VirtualList* VirtualList::SetOnBind(BindCallback callback) {
+        m_onBind = std::move(callback);
+        return Refresh();
+    }
+
+    VirtualList* VirtualList::SetOverscan(size_t rows) {
+        m_overscan = rows;
+        return this;
+    }
+
+    VirtualList* VirtualList::SetScroll(float scroll) {
+        scroll = std::max(scroll, 0.0f);
+        if (m_scroll == scroll)
+            return this;
+        m_scroll = scroll;
+        MarkTransDirty();
+        return this;
+    }
+
+    VirtualList* VirtualList::ScrollBy(float amount) {
+        return SetScroll(m_scroll + amount);
+    }
+
+    VirtualList* VirtualList::SetScrollSpeed(float speed) {
+        m_scrollSpeed = speed;
+        return this;
+    }
+
+    VirtualList* VirtualList::Refresh() {
+        std::fill(m_boundIndices.begin(), m_boundIndices.end(), UNBOUND_INDEX);
+        return this;
+    }
+
+    VirtualList::Mode VirtualList::GetMode() const {
+        return m_mode;
+    }
+
+    size_t VirtualList::GetItemCount() const {
+        return m_itemCount;
+    }
+
+    float VirtualList::GetScroll() const {
+        return m_scroll;
+    }
+
+    float VirtualList::GetMaxScroll() const {
+        return m_maxScroll;
+    }
+
+    size_t VirtualList::GetPoolSize() const {
+        return m_children.size();
+    }
+
+    size_t VirtualList::GetBoundIndex(size_t poolIndex) const {
+        if (poolIndex >= m_boundIndices.size())
+            return UNBOUND_INDEX;
+        return m_boundIndices[poolIndex];
+    }
+
+    void VirtualList::Update() {
+        // the items are always placed in cells, a style can not change that
+        SetLayoutType(LayoutType::Grid);
+
+        if (int dir; Input::GetScrollDir(dir) && IsMouseOver(Input::GetMousePosition()))
+            ScrollBy(static_cast<float>(-dir) * m_scrollSpeed);
+
+        UpdatePool();
+    }
+
+    void VirtualList::SendDrawCommand(Renderer* renderer) {
+        renderer->Submit(m_cmd);
+    }
+
+    void VirtualList::OnUIElementGUIImpl(IUIElementDetailRenderer& ui) {
+        using FU = FormatUtils;
+        ui.DrawLabel(FU::formatString("Mode: {}", (m_mode == Mode::List) ? "List" : "Grid"));
+        ui.DrawLabel(FU::formatString("Items: {}", m_itemCount));
+        ui.DrawLabel(FU::formatString("Pool: {}", m_children.size()));
+        ui.DrawLabel(FU::formatString("Scroll: {} / {}", m_scroll, m_maxScroll));
+    }
+
+    size_t VirtualList::GetGridCellIndex(size_t listPosition) const {
+        if (listPosition >= m_boundIndices.size() || m_boundIndices[listPosition] == UNBOUND_INDEX)
+            return listPosition;
+        return m_boundIndices[listPosition];
+    }
+
+    size_t VirtualList::GetGridColumnCount() const {
+        return (m_mode == Mode::List) ? 1 : 0;
+    }
+
+    Vector2 VirtualList::GetScrollOffset() const {
+        return Vector2(0, m_scroll);
+    }
+
+    void VirtualList::UpdatePool() {
+        if (m_itemCount == 0) {
+            ResizePool(0);
+            m_scroll = 0.0f;
+            m_maxScroll = 0.0f;
+            return;
+        }
+
+        // one item is needed to know the cell size, the rest follows after it was laid out
+        if (m_children.empty()) {
+            ResizePool(1);
+            return;
+        }
+
+        Vector2 content = GetContentSize();
+        Vector2 cell = m_children.front()->GetMarginSize();
+        size_t columns = (m_mode == Mode::List) ? 1 : GridLayoutCalculator::CalculateColumnCount(content.x, cell.x);
+        size_t rowCount = (m_itemCount + columns - 1) / columns;
+
+        size_t visibleRows = 1;
+        size_t firstRow = 0;
+        if (cell.y > 0.0f) {
+            m_maxScroll = std::max(static_cast<float>(rowCount) * cell.y - content.y, 0.0f);
+            if (m_scroll > m_maxScroll)
+                SetScroll(m_maxScroll);
+
+            visibleRows = static_cast<size_t>(std::ceil(content.y / cell.y)) + 1;
+            firstRow = static_cast<size_t>(m_scroll / cell.y);
+            firstRow = (firstRow > m_overscan) ? firstRow - m_overscan : 0;
+        }
+
+        size_t poolSize = std::min((visibleRows + 2 * m_overscan) * columns, m_itemCount);
+        ResizePool(poolSize);
+        poolSize = m_children.size();
+        if (poolSize == 0)
+            return;
+
+        // every index in the window has exactly one item, only the indices that scrolled in are bound
+        size_t firstIndex = std::min(firstRow * columns, m_itemCount - poolSize);
+        bool boundNew = false;
+        for (size_t index = firstIndex; index < firstIndex + poolSize; index++) {
+            size_t slot = index % poolSize;
+            if (m_boundIndices[slot] == index)
+                continue;
+
+            m_boundIndices[slot] = index;
+            boundNew = true;
+            if (m_onBind)
+                m_onBind(index, static_cast<Panel&>(*m_children[slot]));
+        }
+
+        // items moved to other cells
+        if (boundNew)
+            MarkTransDirty();
+    }
+
+    void VirtualList::ResizePool(size_t size) {
+        if (m_children.size() == size)
+            return;
+
+        while (m_children.size() > size) {
+            UIManager::FreeIDsInternal(m_children.back());
+            m_children.pop_back();
+            MarkHierarchyChanged();
+        }
+
+        while (m_children.size() < size) {
+            UIElementID id = UIManager::CreateElementID();
+            if (id.value == ENGINE_INVALID_ID)
+                break;
+            UIManager::RegisterElementInternal(AddChild<Panel>(id, m_itemStyle));
+        }
+
+        m_boundIndices.assign(m_children.size(), UNBOUND_INDEX);
+        MarkTransDirty();
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cmath>
+
+#include "EngineLib/UI/Elements/Element.h"
+#include "EngineLib/UI/HitGrid.h"
+
+namespace EngineCore::UI {
+
+    HitGrid::HitGrid(float cellSize)
+        : m_cellSize(cellSize) {
+    }
+
+    void HitGrid::SetBounds(const Vector2& size) {
+        if (m_bounds == size)
+            return;
+        m_bounds = size;
+        m_columns = static_cast<size_t>(std::ceil(std::max(size.x, 0.0f) / m_cellSize));
+        m_rows = static_cast<size_t>(std::ceil(std::max(size.y, 0.0f) / m_cellSize));
+        m_rebuild = true;
+    }
+
+    void HitGrid::Invalidate() {
+        m_rebuild = true;
+    }
+
+    void HitGrid::Update(ElementBase& root, const std::vector<ElementBase*>& movedElements) {
+        if (m_rebuild || m_hierarchyVersion != ElementBase::GetHierarchyVersion()) {
+            Rebuild(root);
+            return;
+        }
+
+        if (movedElements.empty())
+            return;
+
+        // many moved elements (resize, scrolling) are cheaper to sort into fresh cells
+        if (movedElements.size() * 4 > m_entries.size()) {
+            bool changed = false;
+            for (size_t i = 0; i < m_entries.size(); i++)
+                changed |= CalculateRect(i);
+            if (changed) {
+                FillCells();
+                m_generation++;
+            }
+            return;
+        }
+
+        // parents come before their children, so a child is clipped by the new parent rect
+        for (ElementBase* element : movedElements) {
+            size_t index = element->m_hitIndex;
+            if (index >= m_entries.size())
+                continue;
+
+            Rect previous = m_entries[index].rect;
+            if (!CalculateRect(index))
+                continue;
+
+            RemoveFromCells(index, previous);
+            InsertIntoCells(index, m_entries[index].rect);
+            m_generation++;
+        }
+    }
+
+    std::shared_ptr<ElementBase> HitGrid::Find(const Vector2& point) const {
+        // entries outside of the window are not in the grid
+        if (point.x < 0.0f || point.y < 0.0f || point.x >= m_bounds.x || point.y >= m_bounds.y) {
+            for (size_t i = m_entries.size(); i-- > 0;) {
+                if (m_entries[i].rect.Contains(point))
+                    return m_entries[i].element;
+            }
+            return nullptr;
+        }
+
+        size_t x = std::min(static_cast<size_t>(point.x / m_cellSize), m_columns - 1);
+        size_t y = std::min(static_cast<size_t>(point.y / m_cellSize), m_rows - 1);
+        const auto& cell = m_cells[y * m_columns + x];
+        for (size_t i = cell.size(); i-- > 0;) {
+            const Entry& entry = m_entries[cell[i]];
+            if (entry.rect.Contains(point))
+                return entry.element;
+        }
+        return nullptr;
+    }
+
+    size_t HitGrid::GetGeneration() const {
+        return m_generation;
+    }
+
+    size_t HitGrid::GetEntryCount() const {
+        return m_entries.size();
+    }
+
+    bool HitGrid::Rect::IsEmpty() const {
+        return !(maxX > minX && maxY > minY);
+    }
+
+    bool HitGrid::Rect::Contains(const Vector2& point) const {
+        // same comparison as ElementBase::IsMouseOver
+        return (point.x > minX && maxX > point.x &&
+                point.y > minY && maxY > point.y);
+    }
+
+    void HitGrid::Rebuild(ElementBase& root) {
+        m_entries.clear();
+        for (auto& child : root.GetChildren())
+            AddEntries(child, NO_PARENT);
+
+        for (size_t i = 0; i < m_entries.size(); i++)
+            CalculateRect(i);
+        FillCells();
+
+        m_hierarchyVersion = ElementBase::GetHierarchyVersion();
+        m_rebuild = false;
+        m_generation++;
+    }
+
+    void HitGrid::AddEntries(const std::shared_ptr<ElementBase>& element, size_t parent) {
+        size_t index = m_entries.size();
+        element->m_hitIndex = index;
+
+        Entry& entry = m_entries.emplace_back();
+        entry.element = element;
+        entry.parent = parent;
+        for (auto& child : element->GetChildren())
+            AddEntries(child, index);
+    }
+
+    bool HitGrid::CalculateRect(size_t index) {
+        Entry& entry = m_entries[index];
+        ElementBase& element = *entry.element;
+
+        Vector2 pos = element.GetWorldPosition();
+        Vector2 size = element.GetScreenSize();
+        Rect rect{ pos.x, pos.y, pos.x + size.x, pos.y + size.y };
+
+        if (entry.parent != NO_PARENT) {
+            const Rect& parent = m_entries[entry.parent].rect;
+            rect.minX = std::max(rect.minX, parent.minX);
+            rect.minY = std::max(rect.minY, parent.minY);
+            rect.maxX = std::min(rect.maxX, parent.maxX);
+            rect.maxY = std::min(rect.maxY, parent.maxY);
+        }
+
+        if (entry.rect == rect)
+            return false;
+        entry.rect = rect;
+        return true;
+    }
+
+    void HitGrid::FillCells() {
+        m_cells.resize(m_columns * m_rows);
+        for (auto& cell : m_cells)
+            cell.clear();
+
+        // entries are added in order, every cell stays sorted
+        for (size_t i = 0; i < m_entries.size(); i++) {
+            size_t minX, minY, maxX, maxY;
+            if (!GetCellRange(m_entries[i].rect, minX, minY, maxX, maxY))
+                continue;
+
+            for (size_t y = minY; y <= maxY; y++) {
+                for (size_t x = minX; x <= maxX; x++)
+                    m_cells[y * m_columns + x].push_back(i);
+            }
+        }
+    }
+
+    void HitGrid::InsertIntoCells(size_t index, const Rect& rect) {
+        size_t minX, minY, maxX, maxY;
+        if (!GetCellRange(rect, minX, minY, maxX, maxY))
+            return;
+
+        for (size_t y = minY; y <= maxY; y++) {
+            for (size_t x = minX; x <= maxX; x++) {
+                auto& cell = m_cells[y * m_columns + x];
+                cell.insert(std::lower_bound(cell.begin(), cell.end(), index), index);
+            }
+        }
+    }
+
+    void HitGrid::RemoveFromCells(size_t index, const Rect& rect) {
+        size_t minX, minY, maxX, maxY;
+        if (!GetCellRange(rect, minX, minY, maxX, maxY))
+            return;
+
+        for (size_t y = minY; y <= maxY; y++) {
+            for (size_t x = minX; x <= maxX; x++) {
+                auto& cell = m_cells[y * m_columns + x];
+                auto it = std::lower_bound(cell.begin(), cell.end(), index);
+                if (it != cell.end() && *it == index)
+                    cell.erase(it);
+            }
+        }
+    }
+
+    bool HitGrid::GetCellRange(const Rect& rect, size_t& outMinX, size_t& outMinY, size_t& outMaxX, size_t& outMaxY) const {
+        if (rect.IsEmpty() || m_columns == 0 || m_rows == 0)
+            return false;
+        if (rect.maxX <= 0.0f || rect.maxY <= 0.0f || rect.minX >= m_bounds.x || rect.minY >= m_bounds.y)
+            return false;
+
+        auto toCell = [this](float value, size_t count) {
+            float cell = std::floor(std::max(value, 0.0f) / m_cellSize);
+            return std::min(static_cast<size_t>(cell), count - 1);
+        };
+        outMinX = toCell(rect.minX, m_columns);
+        outMinY = toCell(rect.minY, m_rows);
+        outMaxX = toCell(rect.maxX, m_columns);
+        outMaxY = toCell(rect.maxY, m_rows);
+        return true;
+    }
+
+}
\ No newline at end of file
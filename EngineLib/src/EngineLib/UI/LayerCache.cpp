@@ -0,0 +1,192 @@
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <CoreLib/Log.h>
+
+#include "EngineLib/AssetRepository.h"
+#include "EngineLib/ResourceManager.h"
+#include "EngineLib/Renderer.h"
+#include "EngineLib/UI/LayerCache.h"
+
+namespace EngineCore::UI {
+
+    bool LayerCache::Rect::IsEmpty() const {
+        return !(maxX > minX && maxY > minY);
+    }
+
+    bool LayerCache::Rect::Overlaps(const Rect& other) const {
+        return (minX < other.maxX && other.minX < maxX &&
+                minY < other.maxY && other.minY < maxY);
+    }
+
+    void LayerCache::Rect::Merge(const Rect& other) {
+        if (other.IsEmpty())
+            return;
+        if (IsEmpty()) {
+            *this = other;
+            return;
+        }
+        minX = std::min(minX, other.minX);
+        minY = std::min(minY, other.minY);
+        maxX = std::max(maxX, other.maxX);
+        maxY = std::max(maxY, other.maxY);
+    }
+
+    LayerCache::Rect LayerCache::Rect::FromModel(const Matrix4x4& model) {
+        // corners of the unit plane, the matrix is row-major with the translation in the last column
+        const float* m = model.GetData();
+        float xs[4] = { m[3], m[0] + m[3], m[1] + m[3], m[0] + m[1] + m[3] };
+        float ys[4] = { m[7], m[4] + m[7], m[5] + m[7], m[4] + m[5] + m[7] };
+
+        Rect rect;
+        rect.minX = std::min({ xs[0], xs[1], xs[2], xs[3] });
+        rect.maxX = std::max({ xs[0], xs[1], xs[2], xs[3] });
+        rect.minY = std::min({ ys[0], ys[1], ys[2], ys[3] });
+        rect.maxY = std::max({ ys[0], ys[1], ys[2], ys[3] });
+        return rect;
+    }
+
+    LayerCache::LayerCache() {
+        s_layerCount++;
+        m_cmd.isUI = true;
+        m_cmd.type = RenderCommandType::Mesh;
+        m_cmd.meshID = ASSETS::ENGINE::MESH::UIPlain();
+        m_cmd.materialID = ASSETS::ENGINE::MATERIAL::DefaultUILayer();
+        m_cmd.shaderBindOverride = &m_sbo;
+        m_cmd.modelMatrix = &m_compositeTransform;
+    }
+
+    LayerCache::~LayerCache() {
+        Release();
+        s_layerCount--;
+    }
+
+    bool LayerCache::Prepare(const Vector2& windowSize) {
+        int width = static_cast<int>(windowSize.x);
+        int height = static_cast<int>(windowSize.y);
+        if (width == m_width && height == m_height)
+            return m_framebuffer != 0;
+
+        Release();
+        if (width <= 0 || height <= 0)
+            return false;
+
+        ResourceManager* rm = ResourceManager::GetInstance();
+        std::vector<unsigned char> empty(static_cast<size_t>(width) * height * 4, 0);
+        m_texture = rm->AddTexture2DFromMemory(empty.data(), width, height, 4);
+        Texture2D* texture = rm->GetTexture2D(m_texture);
+        if (!texture) {
+            Log::Error("LayerCache: Could not create the {}x{} layer texture", width, height);
+            return false;
+        }
+
+        // one texel per pixel, mipmaps are never used
+        texture->SetWrapping(GL_CLAMP_TO_EDGE);
+        texture->SetFilter(GL_LINEAR);
+        texture->SetGenerateMipmaps(false);
+        texture->CreateGL();
+
+        m_framebuffer = Renderer::GetDevice()->CreateTextureFramebuffer(texture->GetID(), width, height);
+        if (m_framebuffer == 0) {
+            rm->DeleteAsset(m_texture);
+            m_texture = Texture2DID(ENGINE_INVALID_ID);
+            return false;
+        }
+
+        m_width = width;
+        m_height = height;
+        m_sbo.SetParam("texture", m_texture);
+        Invalidate();
+        return true;
+    }
+
+    void LayerCache::Release() {
+        if (m_framebuffer != 0)
+            Renderer::GetDevice()->DeleteFramebuffer(m_framebuffer);
+        m_framebuffer = 0;
+
+        ResourceManager* rm = ResourceManager::GetInstance();
+        if (rm && m_texture.value != ENGINE_INVALID_ID)
+            rm->DeleteAsset(m_texture);
+        m_texture = Texture2DID(ENGINE_INVALID_ID);
+
+        m_width = 0;
+        m_height = 0;
+        m_dirtyRect = Rect{};
+        m_contentRect = Rect{};
+    }
+
+    void LayerCache::AddDirtyRect(const Rect& rect) {
+        m_dirtyRect.Merge(rect);
+    }
+
+    void LayerCache::Invalidate() {
+        m_dirtyRect = Rect{ 0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height) };
+        m_contentRect = Rect{};
+    }
+
+    bool LayerCache::IsDirty() const {
+        return !m_dirtyRect.IsEmpty();
+    }
+
+    void LayerCache::BeginRedraw(Renderer* renderer) {
+        // whole pixels plus one for the anti aliased edges
+        int minX = std::clamp(static_cast<int>(std::floor(m_dirtyRect.minX)) - 1, 0, m_width);
+        int minY = std::clamp(static_cast<int>(std::floor(m_dirtyRect.minY)) - 1, 0, m_height);
+        int maxX = std::clamp(static_cast<int>(std::ceil(m_dirtyRect.maxX)) + 1, 0, m_width);
+        int maxY = std::clamp(static_cast<int>(std::ceil(m_dirtyRect.maxY)) + 1, 0, m_height);
+        m_redrawRect = Rect{
+            static_cast<float>(minX), static_cast<float>(minY),
+            static_cast<float>(maxX), static_cast<float>(maxY)
+        };
+
+        // UI rows count from the top, framebuffer rows from the bottom
+        renderer->BeginUITarget(m_framebuffer, m_width, m_height, minX, m_height - maxY, maxX - minX, maxY - minY);
+    }
+
+    bool LayerCache::NeedsRedraw(const Rect& rect) const {
+        return m_redrawRect.Overlaps(rect);
+    }
+
+    void LayerCache::AddDrawnRect(const Rect& rect) {
+        m_contentRect.Merge(rect);
+    }
+
+    void LayerCache::EndRedraw(Renderer* renderer) {
+        renderer->EndUITarget();
+        m_dirtyRect = Rect{};
+        m_redrawRect = Rect{};
+    }
+
+    void LayerCache::SendCompositeCommand(Renderer* renderer, RenderLayerID renderLayerID) {
+        if (m_framebuffer == 0)
+            return;
+
+        float width = static_cast<float>(m_width);
+        float height = static_cast<float>(m_height);
+        Rect area{
+            std::clamp(std::floor(m_contentRect.minX), 0.0f, width),
+            std::clamp(std::floor(m_contentRect.minY), 0.0f, height),
+            std::clamp(std::ceil(m_contentRect.maxX), 0.0f, width),
+            std::clamp(std::ceil(m_contentRect.maxY), 0.0f, height)
+        };
+        if (area.IsEmpty())
+            return;
+
+        float areaWidth = area.maxX - area.minX;
+        float areaHeight = area.maxY - area.minY;
+        m_compositeTransform = GLTransform4x4::Scale(areaWidth, areaHeight, 1.0f);
+        GLTransform4x4::MakeTranslate(m_compositeTransform, area.minX, area.minY, 0.0f);
+
+        // the texture is upside down compared to the screen
+        m_cmd.renderLayerID = renderLayerID;
+        m_cmd.uvRect.Set(area.minX / width, 1.0f - area.minY / height, areaWidth / width, -areaHeight / height);
+        renderer->Submit(m_cmd);
+    }
+
+    size_t LayerCache::GetLayerCount() {
+        return s_layerCount;
+    }
+
+}
@@ -6,21 +6,59 @@
 namespace EngineCore::UI {
 
     Vector2 FlexLayoutCalculator::CalculatePosition(ElementBase* element) {
-        // position in the child list of the parent
-        size_t listPosition = element->GetListPosition();
         ElementBase* parent = element->GetParent();
         if (!parent)
             return { 0, 0 };
+
+        // the first child that is positioned arranges all of them
+        LayoutCache& cache = parent->m_layoutCache;
+        size_t listPosition = element->GetListPosition();
+        if (!cache.arranged || listPosition >= cache.childPositions.size())
+            Arrange(parent, cache);
+
+        if (listPosition >= cache.childPositions.size())
+            return { 0, 0 };
+        return cache.childPositions[listPosition];
+    }
+
+    void FlexLayoutCalculator::Arrange(ElementBase* container, LayoutCache& cache) {
+        auto& children = container->GetChildren();
+
+        cache.childrenLayoutSize.Set(0, 0);
+        for (auto& child : children)
+            cache.childrenLayoutSize += child->GetLocalSize() + Vector2(child->GetBorderSize()) + Vector2(child->GetMargin());
+
+        // every child only depends on the one before it
+        cache.childPositions.resize(children.size());
+        Vector2 previousPosition;
+        Vector2 previousMarginSize;
+        for (size_t i = 0; i < children.size(); i++) {
+            ElementBase* child = children[i].get();
+            Vector2 childLayoutSize = child->GetLocalSize() + Vector2(child->GetBorderSize()) + Vector2(child->GetMargin());
+
+            Vector2 position = ArrangeChild(container, child, i,
+                cache.childrenLayoutSize - childLayoutSize, previousPosition, previousMarginSize);
+            cache.childPositions[i] = position;
+
+            previousPosition = position;
+            previousMarginSize = child->GetMarginSize();
+        }
+        cache.arranged = true;
+    }
+
+    Vector2 FlexLayoutCalculator::ArrangeChild(ElementBase* parent, ElementBase* element, size_t listPosition,
+        const Vector2& siblingsLayoutSize, const Vector2& previousPosition, const Vector2& previousMarginSize) {
         auto parentLayoutDir = parent->GetLayoutDirection();
         bool isParentLayoutDirRow = parentLayoutDir == Flex::LayoutDirection::Row;
         bool parentWrap = (parent->GetLayoutWrap() == Flex::LayoutWrap::Wrap);
         Axis major = (isParentLayoutDirRow) ? Axis::X : Axis::Y;
         Axis minor = (!isParentLayoutDirRow) ? Axis::X : Axis::Y;
 
-        float parentSizeMajor = (major == Axis::X) ? parent->GetContentSize().x : parent->GetContentSize().y;
-        float parentSizeMinor = (major != Axis::X) ? parent->GetContentSize().x : parent->GetContentSize().y;
+        Vector2 parentContentSize = parent->GetContentSize();
+        float parentSizeMajor = (major == Axis::X) ? parentContentSize.x : parentContentSize.y;
+        float parentSizeMinor = (major != Axis::X) ? parentContentSize.x : parentContentSize.y;
 
-        float totalSizeMajor = (major == Axis::X) ? element->ComputeSiblingsTotalLayoutSize().x : element->ComputeSiblingsTotalLayoutSize().y;
+        float totalSizeMajor = (major == Axis::X) ? siblingsLayoutSize.x : siblingsLayoutSize.y;
 
         float majorDesiredPosition = (isParentLayoutDirRow) ? element->GetDesiredPosition().x : element->GetDesiredPosition().y;
         float minorDesiredPosition = (!isParentLayoutDirRow) ? element->GetDesiredPosition().x : element->GetDesiredPosition().y;
@@ -50,30 +88,10 @@ namespace EngineCore::UI {
         float minorSize = (!isParentLayoutDirRow) ? element->GetLocalSize().x : element->GetLocalSize().y;
 
         size_t siblingCount = parent->GetChildCount();
-        float preMajorEndPos = 0.0f;
-        float preMajorSize = 0.0f;
-        float preMinorEndPos = 0.0f;
-        float preMinorSize = 0.0f;
-        if (listPosition > 0.0f) {
-            std::shared_ptr<ElementBase> preElement = parent->GetChild(listPosition - 1);
-            if (preElement) {
-                preMajorEndPos = (isParentLayoutDirRow) ?
-                    preElement->GetLocalPosition().x :
-                    preElement->GetLocalPosition().y;
-
-                preMinorEndPos = (!isParentLayoutDirRow) ?
-                    preElement->GetLocalPosition().x :
-                    preElement->GetLocalPosition().y;
-
-                preMajorSize = (isParentLayoutDirRow) ?
-                    preElement->GetMarginSize().x :
-                    preElement->GetMarginSize().y;
-
-                preMinorSize = (!isParentLayoutDirRow) ?
-                    preElement->GetMarginSize().x :
-                    preElement->GetMarginSize().y;
-            }
-        }
+        float preMajorEndPos = (isParentLayoutDirRow) ? previousPosition.x : previousPosition.y;
+        float preMinorEndPos = (!isParentLayoutDirRow) ? previousPosition.x : previousPosition.y;
+        float preMajorSize = (isParentLayoutDirRow) ? previousMarginSize.x : previousMarginSize.y;
+        float preMinorSize = (!isParentLayoutDirRow) ? previousMarginSize.x : previousMarginSize.y;
 
         Vector2 newPosition;
         if (isParentLayoutDirRow) {
@@ -108,7 +126,14 @@ namespace EngineCore::UI {
         float parentSizeMajor = (major == Axis::X) ? parentSize.x : parentSize.y;
         float parentSizeMinor = (major != Axis::X) ? parentSize.x : parentSize.y;
         
-        float totalPixelSizeMajor = (major == Axis::X) ? element->ComputeSiblingsTotalDesiredPixelSize().x : element->ComputeSiblingsTotalDesiredPixelSize().y;
+        // the first child that is sized measures all of them
+        LayoutCache& cache = parent->m_layoutCache;
+        if (!cache.measured)
+            Measure(parent, cache);
+
+        Vector2 siblingsDesiredPixelSize = cache.childrenDesiredPixelSize -
+            (element->GetDesiredPixelSize() + Vector2(element->GetBorderSize()) + Vector2(element->GetMargin()));
+        float totalPixelSizeMajor = (major == Axis::X) ? siblingsDesiredPixelSize.x : siblingsDesiredPixelSize.y;
         auto unitArray = element->GetSizeUnits();
         StyleUnit::Unit majorUnit = (isParentLayoutDirRow) ? unitArray[0] : unitArray[1];
         StyleUnit::Unit minorUnit = (!isParentLayoutDirRow) ? unitArray[0] : unitArray[1];
@@ -140,31 +165,11 @@ namespace EngineCore::UI {
         majorAxis.SetBorder(borderMajorStart, borderMajorEnd);
         minorAxis.SetBorder(borderMinorStart, borderMinorEnd);
         
-        // Calculates the amount of children that will be stretched
-        size_t cStretchCountMajor = 0, cAvaibleStretchCountMajor = 0;
-        for (const auto& c : parent->GetChildren()) {
-            auto units = c->GetSizeUnits();
-            if (isParentLayoutDirRow) {
-                // major axis X
-                if (units[0] == StyleUnit::Unit::Percent_A)
-                    cAvaibleStretchCountMajor++;
-                else if (c->GetDesiredSize().x <= 0.0f)
-                    cStretchCountMajor++;
-            }
-            else {
-                // major axis Y
-                if (units[1] == StyleUnit::Unit::Percent_A)
-                    cAvaibleStretchCountMajor++;
-                else if (c->GetDesiredSize().y <= 0.0f)
-                    cStretchCountMajor++;
-            }
-        }
-
         Vector2 newSize;
         if (isParentLayoutDirRow) {
             // major axis X
             newSize.Set(
-                majorAxis.CalculateSize(cStretchCountMajor, cAvaibleStretchCountMajor),
+                majorAxis.CalculateSize(cache.stretchCount, cache.avaibleStretchCount),
                 minorAxis.CalculateSize(0, 0)
             );
         }
@@ -172,12 +177,41 @@ namespace EngineCore::UI {
             // major axis Y
             newSize.Set(
                 minorAxis.CalculateSize(0, 0),
-                majorAxis.CalculateSize(cStretchCountMajor, cAvaibleStretchCountMajor)
+                majorAxis.CalculateSize(cache.stretchCount, cache.avaibleStretchCount)
             );
         }
 
         return newSize;
     }
+
+    void FlexLayoutCalculator::Measure(ElementBase* container, LayoutCache& cache) {
+        bool isLayoutDirRow = container->GetLayoutDirection() == Flex::LayoutDirection::Row;
+
+        cache.childrenDesiredPixelSize.Set(0, 0);
+        cache.stretchCount = 0;
+        cache.avaibleStretchCount = 0;
+        for (const auto& c : container->GetChildren()) {
+            cache.childrenDesiredPixelSize += c->GetDesiredPixelSize() + Vector2(c->GetBorderSize()) + Vector2(c->GetMargin());
+
+            // Calculates the amount of children that will be stretched
+            auto& units = c->GetSizeUnits();
+            if (isLayoutDirRow) {
+                // major axis X
+                if (units[0] == StyleUnit::Unit::Percent_A)
+                    cache.avaibleStretchCount++;
+                else if (c->GetDesiredSize().x <= 0.0f)
+                    cache.stretchCount++;
+            }
+            else {
+                // major axis Y
+                if (units[1] == StyleUnit::Unit::Percent_A)
+                    cache.avaibleStretchCount++;
+                else if (c->GetDesiredSize().y <= 0.0f)
+                    cache.stretchCount++;
+            }
+        }
+        cache.measured = true;
+    }
     
     float FlexLayoutCalculator::AxisLayout::CalculatePosition(
         float previousEndPos,
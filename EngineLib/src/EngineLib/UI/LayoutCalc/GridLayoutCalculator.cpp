@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include <CoreLib/Log.h>
 
 #include "EngineLib/UI/Elements/Element.h"
@@ -6,13 +8,77 @@
 namespace EngineCore::UI {
 
     Vector2 GridLayoutCalculator::CalculatePosition(ElementBase* element) {
-        Log::Warn("GridLayoutCalculator: Can not CalculatePosition GridLayoutCalculator is not implemented!");
-        return { 0, 0 };
+        ElementBase* parent = element->GetParent();
+        if (!parent)
+            return { 0, 0 };
+
+        // the first child that is positioned arranges all of them
+        LayoutCache& cache = parent->m_layoutCache;
+        size_t listPosition = element->GetListPosition();
+        if (!cache.arranged || listPosition >= cache.childPositions.size())
+            Arrange(parent, cache);
+
+        if (listPosition >= cache.childPositions.size())
+            return { 0, 0 };
+        return cache.childPositions[listPosition];
     }
 
     Vector2 GridLayoutCalculator::CalculateSize(ElementBase* element) {
-        Log::Warn("GridLayoutCalculator: Can not CalculateSize GridLayoutCalculator is not implemented!");
-        return { 0, 0 };
+        ElementBase* parent = element->GetParent();
+        if (!parent)
+            return { 0, 0 };
+
+        // %a has no free space to share in a grid, it is relative to the content of the container
+        Vector2 size = element->GetDesiredPixelSize();
+        auto& units = element->GetSizeUnits();
+        Vector2 parentSize = parent->GetContentSize();
+        if (units[0] == StyleUnit::Unit::Percent_A)
+            size.x = std::max(parentSize.x * (element->GetDesiredSize().x / 100.0f), 0.0f);
+        if (units[1] == StyleUnit::Unit::Percent_A)
+            size.y = std::max(parentSize.y * (element->GetDesiredSize().y / 100.0f), 0.0f);
+
+        // Add border, remove margin (margin affects only position)
+        Vector4 border = element->GetBorderSize();
+        return Vector2(
+            std::max(size.x + border.y + border.w, 0.0f),
+            std::max(size.y + border.x + border.z, 0.0f)
+        );
+    }
+
+    size_t GridLayoutCalculator::CalculateColumnCount(float contentWidth, float cellWidth) {
+        if (cellWidth <= 0.0f || contentWidth <= cellWidth)
+            return 1;
+        return static_cast<size_t>(std::floor(contentWidth / cellWidth));
+    }
+
+    void GridLayoutCalculator::Arrange(ElementBase* container, LayoutCache& cache) {
+        auto& children = container->GetChildren();
+
+        cache.gridCellSize.Set(0, 0);
+        for (auto& child : children) {
+            Vector2 marginSize = child->GetMarginSize();
+            cache.gridCellSize.x = std::max(cache.gridCellSize.x, marginSize.x);
+            cache.gridCellSize.y = std::max(cache.gridCellSize.y, marginSize.y);
+        }
+
+        cache.gridColumns = container->GetGridColumnCount();
+        if (cache.gridColumns == 0)
+            cache.gridColumns = CalculateColumnCount(container->GetContentSize().x, cache.gridCellSize.x);
+
+        Vector2 scroll = container->GetScrollOffset();
+        cache.childPositions.resize(children.size());
+        for (size_t i = 0; i < children.size(); i++) {
+            size_t cell = container->GetGridCellIndex(i);
+            size_t column = cell % cache.gridColumns;
+            size_t row = cell / cache.gridColumns;
+
+            const Vector4& margin = children[i]->GetMargin();
+            cache.childPositions[i].Set(
+                static_cast<float>(column) * cache.gridCellSize.x + margin.w - scroll.x,
+                static_cast<float>(row) * cache.gridCellSize.y + margin.x - scroll.y
+            );
+        }
+        cache.arranged = true;
     }
 
 }
\ No newline at end of file
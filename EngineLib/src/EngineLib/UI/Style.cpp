@@ -1,9 +1,54 @@
+#include <algorithm>
+
 #include "EngineLib/UI/AttributeNames.h"
 #include "EngineLib/UI/UIManager.h"
 #include "EngineLib/UI/Style.h"
 
 namespace EngineCore::UI {
 
+	void CompiledStyle::Set(size_t attributeID, const StyleValue& value) {
+		SetShared(attributeID, std::make_shared<const StyleValue>(value));
+	}
+
+	void CompiledStyle::SetShared(size_t attributeID, const std::shared_ptr<const StyleValue>& value) {
+		if (attributeID >= m_values.size())
+			m_values.resize(attributeID + 1);
+
+		if (!m_values[attributeID])
+			m_setIDs.push_back(attributeID);
+		m_values[attributeID] = value;
+	}
+
+	void CompiledStyle::Remove(size_t attributeID) {
+		if (!Has(attributeID))
+			return;
+
+		m_values[attributeID] = nullptr;
+		m_setIDs.erase(std::find(m_setIDs.begin(), m_setIDs.end(), attributeID));
+	}
+
+	void CompiledStyle::Merge(const CompiledStyle& other) {
+		for (size_t id : other.m_setIDs)
+			SetShared(id, other.m_values[id]);
+	}
+
+	void CompiledStyle::Clear() {
+		m_values.clear();
+		m_setIDs.clear();
+	}
+
+	bool CompiledStyle::Has(size_t attributeID) const {
+		return attributeID < m_values.size() && m_values[attributeID];
+	}
+
+	const StyleValue& CompiledStyle::Get(size_t attributeID) const {
+		return *m_values[attributeID];
+	}
+
+	const std::vector<size_t>& CompiledStyle::GetSetIDs() const {
+		return m_setIDs;
+	}
+
 	Style::Style(const std::string& name)
 		:m_name(name){
 	}
@@ -19,11 +64,29 @@ namespace EngineCore::UI {
 		return s;
 	}
 
+	std::shared_ptr<Style> Style::GetMerged(std::shared_ptr<Style> base, std::shared_ptr<Style> style) {
+		std::pair<const Style*, const Style*> key(base.get(), style.get());
+		auto& entry = s_mergedStyles[key];
+		if (auto merged = entry.lock())
+			return merged;
+
+		auto merged = Create("Merged", base);
+		merged->Extend(style);
+		entry = merged;
+
+		// styles of deleted elements leave expired entries behind
+		if (s_mergedStyles.size() > s_mergedStylesCleanSize * 2 + 16) {
+			std::erase_if(s_mergedStyles, [](const auto& pair) { return pair.second.expired(); });
+			s_mergedStylesCleanSize = s_mergedStyles.size();
+		}
+
+		return merged;
+	}
+
 	void Style::Extend(std::shared_ptr<Style> style) {
 		if (!style)
 			return;
 		m_extendedStyles.emplace_back(style);
-		style->SubDirtCallbackInter([this]() { SetStyleDirty(); });
 		SetStyleDirty();
 	}
 
@@ -37,6 +100,7 @@ namespace EngineCore::UI {
 
 	void Style::Set(State state, const char* name, const std::string& value) {
 		m_attributes[state][name] = value;
+		CompileAttribute(state, name);
 		SetStyleDirty();
 	}
 
@@ -48,9 +112,11 @@ namespace EngineCore::UI {
 		auto outerIt = m_attributes.find(state);
 		if (outerIt != m_attributes.end()) {
 			outerIt->second.erase(name);
+			CompileAttribute(state, name);
 
 			if (outerIt->second.empty()) {
 				m_attributes.erase(outerIt);
+				m_compiledAttributes.erase(state);
 			}
 			SetStyleDirty();
 		}
@@ -58,12 +124,15 @@ namespace EngineCore::UI {
 
 	void Style::Clear() {
 		m_attributes.clear();
+		m_compiledAttributes.clear();
+		SetStyleDirty();
 	}
 
 	void Style::Clear(UI::State state) {
 		auto it = m_attributes.find(state);
 		if (it != m_attributes.end())
 			it->second.clear();
+		m_compiledAttributes.erase(state);
 
 		SetStyleDirty();
 	}
@@ -73,13 +142,10 @@ namespace EngineCore::UI {
 
 		// Copy own attributes
 		copy->m_attributes = m_attributes;
+		copy->m_compiledAttributes = m_compiledAttributes;
 
 		copy->m_extendedStyles = m_extendedStyles;
-		copy->m_styleDirty = true;
-
-		// Don't copy subscribers (they are tied to the original element's lifecycle)
-		copy->m_dirtyCallback.clear();
-		copy->m_dirtyCallbackInter.clear();
+		copy->SetStyleDirty();
 
 		return copy;
 	}
@@ -89,7 +155,7 @@ namespace EngineCore::UI {
 	}
 
 	std::string Style::Get(State state, const char* name) const {
-		if (m_styleDirty) {
+		if (IsCacheOutdated()) {
 			GenerateCachedStyle();
 		}
 
@@ -126,14 +192,14 @@ namespace EngineCore::UI {
 	}
 
 	const std::unordered_map<State, std::unordered_map<std::string, std::string>>& Style::GetAll() const {
-		if (m_styleDirty) {
+		if (IsCacheOutdated()) {
 			GenerateCachedStyle();
 		}
 		return m_cachedStyle->m_attributes;
 	}
 
 	const std::unordered_map<std::string, std::string>& Style::GetAllState(State state) const {
-		if (m_styleDirty) {
+		if (IsCacheOutdated()) {
 			GenerateCachedStyle();
 		}
 		return m_cachedStyle->m_attributes[state];
@@ -151,6 +217,23 @@ namespace EngineCore::UI {
 		return m_extendedStyles;
 	}
 
+	const CompiledStyle& Style::GetCompiled(State state) const {
+		if (IsCacheOutdated()) {
+			GenerateCachedStyle();
+		}
+
+		auto it = m_resolvedAttributes.find(state);
+		if (it != m_resolvedAttributes.end())
+			return it->second;
+
+		it = m_resolvedAttributes.find(State::Normal);
+		if (it != m_resolvedAttributes.end())
+			return it->second;
+
+		static const CompiledStyle empty;
+		return empty;
+	}
+
 	std::string Style::ToString() const {
 		std::ostringstream ss;
 
@@ -166,7 +249,7 @@ namespace EngineCore::UI {
 			ss << "\n";
 		}
 
-		if (m_styleDirty) {
+		if (IsCacheOutdated()) {
 			GenerateCachedStyle();
 		}
 
@@ -184,29 +267,75 @@ namespace EngineCore::UI {
 		return ss.str();
 	}
 
-	Style::SubscriberID Style::SubDirtCallback(StyleDirtyCallback callback) {
-		m_dirtyCallback.push_back({ ++m_dirtyCallbackID, callback });
-		return m_dirtyCallbackID;
+	size_t Style::GetGeneration() const {
+		// no style changed since the last call
+		if (m_chainCheckedAt == s_generationCounter)
+			return m_chainGeneration;
+
+		size_t generation = m_generation;
+		for (const auto& extStyle : m_extendedStyles)
+			generation = std::max(generation, extStyle->GetGeneration());
+
+		m_chainGeneration = generation;
+		m_chainCheckedAt = s_generationCounter;
+		return generation;
 	}
 
-	Style::SubscriberID Style::SubDirtCallbackInter(StyleDirtyCallback callback) {
-		m_dirtyCallbackInter.push_back({ ++m_dirtyCallbackIDInter, callback });
-		return m_dirtyCallbackIDInter;
+	void Style::SetStyleDirty() {
+		m_generation = ++s_generationCounter;
 	}
 
-	void Style::UnsubDirtyCallback(SubscriberID id) {
-		auto it = std::find_if(m_dirtyCallback.begin(), m_dirtyCallback.end(),
-			[id](const Subscriber<StyleDirtyCallback>& sub) { return id == sub.id; }
-		);
+	bool Style::IsCacheOutdated() const {
+		return !m_cachedStyle || m_cachedGeneration != GetGeneration();
+	}
 
-		if (it != m_dirtyCallback.end()) {
-			m_dirtyCallback.erase(it);
+	void Style::CompileAttribute(State state, const std::string& name) {
+		const StyleAttribute& attribute = StyleAttribute::GetAttribute(name);
+		if (attribute.GetID() == StyleAttribute::INVALID_ID)
+			return;
+
+		if (!attribute.IsComposite()) {
+			CompileSingleAttribute(state, attribute);
+			return;
+		}
+
+		for (const auto& mappedName : attribute.GetMappedAttributes()) {
+			if (const StyleAttribute* mapped = StyleAttribute::FindAttribute(mappedName))
+				CompileSingleAttribute(state, *mapped);
 		}
 	}
 
-	void Style::SetStyleDirty() {
-		m_styleDirty = true;
-		CallDirty();
+	void Style::CompileSingleAttribute(State state, const StyleAttribute& attribute) {
+		auto& compiled = m_compiledAttributes[state];
+		auto stateIt = m_attributes.find(state);
+		if (stateIt == m_attributes.end()) {
+			compiled.Remove(attribute.GetID());
+			return;
+		}
+
+		const auto& attributes = stateIt->second;
+		auto it = attributes.find(attribute.GetName());
+		if (it != attributes.end()) {
+			compiled.Set(attribute.GetID(), attribute.GetValue(it->second));
+			return;
+		}
+
+		// the value can come from a composite like margin
+		for (const auto& [name, value] : attributes) {
+			const StyleAttribute* composite = StyleAttribute::FindAttribute(name);
+			if (!composite || !composite->IsComposite())
+				continue;
+
+			const auto& mapped = composite->GetMappedAttributes();
+			if (std::find(mapped.begin(), mapped.end(), attribute.GetName()) == mapped.end())
+				continue;
+
+			auto values = composite->ParseCompositeValues(value);
+			compiled.Set(attribute.GetID(), attribute.GetValue(values[attribute.GetName()]));
+			return;
+		}
+
+		compiled.Remove(attribute.GetID());
 	}
 
 	void Style::GenerateCachedStyle() const {
@@ -253,40 +382,29 @@ namespace EngineCore::UI {
 			}
 		}
 
-		m_styleDirty = false;
-	}
-
-	void Style::CallDirty() {
-		if (m_dirtyCallbackInter.empty() && m_dirtyCallback.empty())
-			return;
-
-#ifndef NDEBUG
-		if (UIManager::GetDebug())
-			Log::Debug("Style: called Dirt Callbacks with '{}' Inter and '{}' normal", m_dirtyCallbackInter.size(), m_dirtyCallback.size());
-#endif
-
-		if (m_dirtyCallbackInter.size() > 10 && m_dirtyCallback.size() > 10) {
-			std::vector<Subscriber<StyleDirtyCallback>> callbacks;
-			callbacks.reserve(m_dirtyCallbackInter.size() + m_dirtyCallback.size());
-			callbacks.insert(callbacks.end(), m_dirtyCallbackInter.begin(), m_dirtyCallbackInter.end());
-			callbacks.insert(callbacks.end(), m_dirtyCallback.begin(), m_dirtyCallback.end());
+		// same for the parsed values, the extended styles are already merged
+		auto& compiled = m_cachedStyle->m_compiledAttributes;
+		for (const auto& extStyle : m_extendedStyles) {
+			if (extStyle->IsCacheOutdated())
+				extStyle->GenerateCachedStyle();
 
-			for (const auto& sub : callbacks) {
-				if (sub.callback)
-					sub.callback();
-			}
+			for (const auto& [state, values] : extStyle->m_cachedStyle->m_compiledAttributes)
+				compiled[state].Merge(values);
 		}
-		else {
-			for (const auto& sub : m_dirtyCallbackInter) {
-				if (sub.callback)
-					sub.callback();
-			}
-
-			for (const auto& sub : m_dirtyCallback) {
-				if (sub.callback)
-					sub.callback();
-			}
+		for (const auto& [state, values] : m_compiledAttributes)
+			compiled[state].Merge(values);
+
+		// elements apply the normal state below every other state
+		m_resolvedAttributes.clear();
+		auto normalIt = compiled.find(State::Normal);
+		for (const auto& [state, values] : compiled) {
+			auto& resolved = m_resolvedAttributes[state];
+			if (state != State::Normal && normalIt != compiled.end())
+				resolved = normalIt->second;
+			resolved.Merge(values);
 		}
+
+		m_cachedGeneration = GetGeneration();
 	}
 
 }
\ No newline at end of file
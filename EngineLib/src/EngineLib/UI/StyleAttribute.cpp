@@ -72,6 +72,10 @@ namespace EngineCore::UI {
 		return m_name; 
 	}
 
+	size_t StyleAttribute::GetID() const {
+		return m_id;
+	}
+
 	const std::string& StyleAttribute::GetDesc() const { 
 		return m_description; 
 	}
@@ -114,6 +118,27 @@ namespace EngineCore::UI {
 		return dummy;
 	}
 
+	const StyleAttribute* StyleAttribute::FindAttribute(const std::string& name) {
+		auto it = m_registeredStyleAttributes.find(name);
+		if (it == m_registeredStyleAttributes.end())
+			return nullptr;
+		return &it->second;
+	}
+
+	const StyleAttribute& StyleAttribute::GetAttribute(size_t id) {
+		if (id < m_attributesByID.size()) {
+			return *m_attributesByID[id];
+		}
+
+		Log::Error("StyleAttribute: Could not get Attribute with id '{}', this Attribute does not exist!", id);
+		static StyleAttribute dummy;
+		return dummy;
+	}
+
+	size_t StyleAttribute::GetAttributeCount() {
+		return m_attributesByID.size();
+	}
+
 	const bool StyleAttribute::TryGetAttribute(const std::string& name, StyleAttribute& outValue) {
 		if (m_registeredStyleAttributes.find(name) != m_registeredStyleAttributes.end()) {
 			outValue = m_registeredStyleAttributes.at(name);
@@ -133,7 +158,18 @@ namespace EngineCore::UI {
 				attribute.GetName());
 		}
 #endif
-		m_registeredStyleAttributes[attribute.GetName()] = attribute;
+		AddToRegistry(attribute);
+	}
+
+	void StyleAttribute::AddToRegistry(const StyleAttribute& attribute) {
+		auto [it, inserted] = m_registeredStyleAttributes.try_emplace(attribute.GetName());
+		size_t id = inserted ? m_attributesByID.size() : it->second.m_id;
+
+		// map nodes do not move, the pointer stays valid
+		it->second = attribute;
+		it->second.m_id = id;
+		if (inserted)
+			m_attributesByID.push_back(&it->second);
 	}
 
 }
\ No newline at end of file
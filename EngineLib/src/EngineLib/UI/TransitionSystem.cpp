@@ -0,0 +1,192 @@
+#include <algorithm>
+
+#include "EngineLib/UI/Elements/Element.h"
+#include "EngineLib/UI/TransitionSystem.h"
+
+namespace EngineCore::UI {
+
+    void TransitionSystem::Start(ElementBase* element, TransitionProperty property, const Vector4& from, const Vector4& to,
+        float duration, Easing easing, StyleUnit::Unit unit) {
+        uint64_t key = GetKey(element, property);
+        auto it = m_lookup.find(key);
+
+        if (duration <= 0.0f) {
+            if (it != m_lookup.end())
+                RemoveAt(it->second);
+            element->SetTransitionValue(property, to, unit);
+            element->MarkRenderDirty();
+            return;
+        }
+
+        size_t index = 0;
+        if (it != m_lookup.end()) {
+            index = it->second;
+            if (m_units[index] == unit &&
+                m_to[0][index] == to.x && m_to[1][index] == to.y && m_to[2][index] == to.z && m_to[3][index] == to.w)
+                return;
+        }
+        else {
+            if (from == to)
+                return;
+
+            index = m_elements.size();
+            m_lookup[key] = index;
+            m_elements.push_back(element);
+            m_properties.push_back(property);
+            m_units.push_back(unit);
+            m_elapsed.push_back(0.0f);
+            m_invDuration.push_back(0.0f);
+            m_easeA.push_back(0.0f);
+            m_easeB.push_back(0.0f);
+            m_easeC.push_back(0.0f);
+            for (size_t c = 0; c < 4; c++) {
+                m_from[c].push_back(0.0f);
+                m_to[c].push_back(0.0f);
+            }
+        }
+
+        // a retargeted transition starts again from where it is now
+        m_units[index] = unit;
+        m_elapsed[index] = 0.0f;
+        m_invDuration[index] = 1.0f / duration;
+        m_from[0][index] = from.x;
+        m_from[1][index] = from.y;
+        m_from[2][index] = from.z;
+        m_from[3][index] = from.w;
+        m_to[0][index] = to.x;
+        m_to[1][index] = to.y;
+        m_to[2][index] = to.z;
+        m_to[3][index] = to.w;
+
+        // every curve is 0 at t = 0 and exactly 1 at t = 1
+        switch (easing) {
+        case Easing::Linear:
+            m_easeA[index] = 0.0f; m_easeB[index] = 0.0f; m_easeC[index] = 1.0f;
+            break;
+        case Easing::EaseIn:
+            m_easeA[index] = 1.0f; m_easeB[index] = 0.0f; m_easeC[index] = 0.0f;
+            break;
+        case Easing::EaseOut:
+            m_easeA[index] = 1.0f; m_easeB[index] = -3.0f; m_easeC[index] = 3.0f;
+            break;
+        case Easing::EaseInOut:
+        default:
+            m_easeA[index] = -2.0f; m_easeB[index] = 3.0f; m_easeC[index] = 0.0f;
+            break;
+        }
+    }
+
+    void TransitionSystem::Stop(const ElementBase* element, TransitionProperty property) {
+        auto it = m_lookup.find(GetKey(element, property));
+        if (it != m_lookup.end())
+            RemoveAt(it->second);
+    }
+
+    void TransitionSystem::Remove(const ElementBase* element) {
+        if (m_elements.empty())
+            return;
+        for (size_t p = 0; p < static_cast<size_t>(TransitionProperty::Count); p++)
+            Stop(element, static_cast<TransitionProperty>(p));
+    }
+
+    void TransitionSystem::Clear() {
+        m_elements.clear();
+        m_properties.clear();
+        m_units.clear();
+        m_elapsed.clear();
+        m_invDuration.clear();
+        m_easeA.clear();
+        m_easeB.clear();
+        m_easeC.clear();
+        m_progress.clear();
+        for (size_t c = 0; c < 4; c++) {
+            m_from[c].clear();
+            m_to[c].clear();
+            m_value[c].clear();
+        }
+        m_lookup.clear();
+    }
+
+    void TransitionSystem::Advance(float deltaTime) {
+        size_t count = m_elements.size();
+        if (count == 0)
+            return;
+
+        m_progress.resize(count);
+        {
+            float* elapsed = m_elapsed.data();
+            const float* invDuration = m_invDuration.data();
+            const float* easeA = m_easeA.data();
+            const float* easeB = m_easeB.data();
+            const float* easeC = m_easeC.data();
+            float* progress = m_progress.data();
+            for (size_t i = 0; i < count; i++) {
+                elapsed[i] += deltaTime;
+                float t = std::min(elapsed[i] * invDuration[i], 1.0f);
+                progress[i] = ((easeA[i] * t + easeB[i]) * t + easeC[i]) * t;
+            }
+        }
+
+        // from * (1 - p) + to * p ends exactly on the target
+        for (size_t c = 0; c < 4; c++) {
+            m_value[c].resize(count);
+            const float* from = m_from[c].data();
+            const float* to = m_to[c].data();
+            const float* progress = m_progress.data();
+            float* value = m_value[c].data();
+            for (size_t i = 0; i < count; i++)
+                value[i] = from[i] * (1.0f - progress[i]) + to[i] * progress[i];
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            ElementBase* element = m_elements[i];
+            element->SetTransitionValue(m_properties[i],
+                Vector4(m_value[0][i], m_value[1][i], m_value[2][i], m_value[3][i]), m_units[i]);
+            element->MarkRenderDirty();
+        }
+
+        // backwards, the entries moved into a removed slot are already checked
+        for (size_t i = count; i-- > 0;) {
+            if (m_elapsed[i] * m_invDuration[i] >= 1.0f)
+                RemoveAt(i);
+        }
+    }
+
+    bool TransitionSystem::IsRunning(const ElementBase* element, TransitionProperty property) const {
+        return m_lookup.find(GetKey(element, property)) != m_lookup.end();
+    }
+
+    size_t TransitionSystem::GetCount() const {
+        return m_elements.size();
+    }
+
+    uint64_t TransitionSystem::GetKey(const ElementBase* element, TransitionProperty property) {
+        return (static_cast<uint64_t>(element->GetID().value) << 8) | static_cast<uint64_t>(property);
+    }
+
+    void TransitionSystem::RemoveAt(size_t index) {
+        size_t last = m_elements.size() - 1;
+        m_lookup.erase(GetKey(m_elements[index], m_properties[index]));
+
+        auto moveLast = [index, last](auto& list) {
+            list[index] = list[last];
+            list.pop_back();
+        };
+        moveLast(m_elements);
+        moveLast(m_properties);
+        moveLast(m_units);
+        moveLast(m_elapsed);
+        moveLast(m_invDuration);
+        moveLast(m_easeA);
+        moveLast(m_easeB);
+        moveLast(m_easeC);
+        for (size_t c = 0; c < 4; c++) {
+            moveLast(m_from[c]);
+            moveLast(m_to[c]);
+        }
+
+        if (index != last)
+            m_lookup[GetKey(m_elements[index], m_properties[index])] = index;
+    }
+
+}
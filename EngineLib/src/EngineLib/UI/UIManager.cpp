@@ -1,11 +1,12 @@
 #include <any>
-#include <CoreLib/Algorithm.h>
+#include <algorithm>
 #include <CoreLib/FormatUtils.h>
 #include <CoreLib/Log.h>
 
 #include "EngineLib/UI/Elements/Element.h"
 #include "EngineLib/UI/Style.h"
 #include "EngineLib/Renderer.h"
+#include "EngineLib/Profiler.h"
 #include "EngineLib/Input.h"
 #include "EngineLib/UI/UITypes.h"
 #include "EngineLib/UI/Attribute/_Attributes.h"
@@ -23,6 +24,9 @@ namespace EngineCore {
 
 	void UIManager::Shutdown() {
         EndRootElement();
+        for (auto& layer : m_layers)
+            layer->Release();
+        m_transitions.Clear();
 	}
 
 	void UIManager::End() {
@@ -40,26 +44,29 @@ namespace EngineCore {
 	}
 
     const std::shared_ptr<UI::ElementBase> UIManager::GetElement(UIElementID elementID) {
-        return SearchElementInternal(m_roots, elementID);
+        if (elementID.value >= m_elementsByID.size())
+            return nullptr;
+        return m_elementsByID[elementID.value].lock();
     }
 
     void UIManager::DeleteElement(UIElementID elementID) {
-        auto element = SearchElementInternal(m_roots, elementID);
+        auto element = GetElement(elementID);
+        if (!element) {
+            Log::Warn("UIManager: Cannot delete element id {}, element not found!", elementID.value);
+            return;
+        }
+
         auto parent = element->GetParent();
         FreeIDsInternal(element);
+        UI::ElementBase::MarkHierarchyChanged();
 
         if (parent) {
-            auto& parentChilds = parent->GetChildren();
-            parentChilds.erase(
-                std::remove_if(parentChilds.begin(), parentChilds.end(),
-                    [element](const std::shared_ptr<UI::ElementBase>& ptr) { return ptr == element; }),
-                parentChilds.end());
+            EraseFromListInternal(parent->GetChildren(), element);
+            // the siblings move up, the cached layout of the parent is outdated
+            parent->MarkTransDirty();
         }
         else {
-            m_roots.erase(
-                std::remove_if(m_roots.begin(), m_roots.end(),
-                    [element](const std::shared_ptr<UI::ElementBase>& ptr) { return ptr == element; }),
-                m_roots.end());
+            EraseFromListInternal(m_roots, element);
         }
     }
 
@@ -74,6 +81,8 @@ namespace EngineCore {
 		}
 
 		m_roots.clear();
+        m_elementsByID.clear();
+        UI::ElementBase::MarkHierarchyChanged();
         BeginRootElement();
 	}
 
@@ -127,6 +136,7 @@ namespace EngineCore {
         // resets scale factor to default value
         if (!value)
             m_uiScaleFactor = 1;
+        m_hitGrid.Invalidate();
     }
 
     void UIManager::SetReferenceScreenSize(float x, float y) {
@@ -246,6 +256,16 @@ namespace EngineCore {
         m_rootElement = nullptr;
     }
 
+    UIElementID UIManager::CreateElementID() {
+        UIElementID id = UIElementID(m_idManager.GetNewUniqueIdentifier());
+        if (id.value == ENGINE_INVALID_ID) {
+            Log::Error("UIManager: Could not create element, no free Element id found!");
+            return id;
+        }
+        m_elementCount++;
+        return id;
+    }
+
     void UIManager::WindowResize(int width, int height) {
         m_windowSize.Set(static_cast<float>(width), static_cast<float>(height));
         m_rootElement->SetLayoutSize(m_windowSize);
@@ -255,10 +275,13 @@ namespace EngineCore {
         m_rootElement->UpdateWorldTransform();
 
         CalculateOrthograpicMatrix(width, height);
+        m_hitGrid.SetBounds(m_windowSize);
+        // the root was just laid out again
+        m_rootElement->m_subtreeDirty = false;
         SetRootElementTransDirty();
     }
 
-    void UIManager::Update(int width, int height) {
+    void UIManager::Update(int width, int height, float deltaTime) {
         // freezes updating of the UI
         if (m_freezUI) {
             // steps UI forward by set amount
@@ -276,19 +299,40 @@ namespace EngineCore {
         if(m_enableUIScaling)
             m_uiScaleFactor = CalculateUIScaleFactor(width, height);
 
-        UpdateInput();
-        UpdateElementState();
-
-        ComputeLayout(m_rootElement);
-        UpdateChild(m_rootElement);
+        {
+            ENGINE_PROFILE_ZONE("UIManager::Input");
+            UpdateInput();
+            UpdateElementState();
+        }
+        {
+            // before the layout, changed sizes are laid out in the same frame
+            ENGINE_PROFILE_ZONE("UIManager::Transitions");
+            m_transitions.Advance(deltaTime);
+        }
+        {
+            ENGINE_PROFILE_ZONE("UIManager::Layout");
+            ComputeLayout(m_rootElement);
+
+            m_hitGrid.Update(*m_rootElement, m_movedElements);
+            for (UI::ElementBase* element : m_movedElements)
+                element->MarkRenderDirty();
+            m_movedElements.clear();
+        }
+        {
+            ENGINE_PROFILE_ZONE("UIManager::UpdateElements");
+            UpdateChild(m_rootElement);
+        }
     }
 
     void UIManager::ComputeLayout(std::shared_ptr<UI::ElementBase>& root) {
+        UI::ElementBase::s_layoutRunning = true;
         // updates the scale of every element that is dirty
         UpdateScales(root);
 
         // updates the position of each element with the newly calculated size of each element
         UpdatePositions(root);
+        UI::ElementBase::s_layoutRunning = false;
+        root->m_subtreeDirty = false;
     }
 
 
@@ -312,11 +356,13 @@ namespace EngineCore {
 
     void UIManager::UpdatePositions(std::shared_ptr<UI::ElementBase>& root) {
         for (auto& child : root->GetChildren()) {
+            child->m_subtreeDirty = false;
             if (child->IsTransformDirty()) {
                 child->UpdateLayoutPosition();
                 child->UpdateWorldTransform();
 
                 child->SetTransformDirty(false);
+                m_movedElements.push_back(child.get());
             }
 
             UpdatePositions(child);
@@ -389,6 +435,7 @@ namespace EngineCore {
 
 
 	void UIManager::SendDrawCommands() {
+        ENGINE_PROFILE_ZONE("UIManager::SendDrawCommands");
         if (m_renderLayerID.value == ENGINE_INVALID_ID) {
             Log::Warn("UIManager: UI Render layer is not set! Use UIManager::SetUIRenderLayer to set the render layer for the UI");
             return;
@@ -396,6 +443,8 @@ namespace EngineCore {
 
         m_renderer->ReserveCommands(m_elementCount);
 		for (auto& element : m_roots) {
+            if ((element->m_isCached || element->m_layer) && SendLayerDrawCommands(element))
+                continue;
 			element->SendDrawCommandImpl(m_renderer, m_renderLayerID);
 			SendChildDrawCommands(element);
 		}
@@ -403,11 +452,58 @@ namespace EngineCore {
 
     void UIManager::SendChildDrawCommands(std::shared_ptr<UI::ElementBase> element) {
         for (auto& child : element->GetChildren()) {
+            if ((child->m_isCached || child->m_layer) && SendLayerDrawCommands(child))
+                continue;
             child->SendDrawCommandImpl(m_renderer, m_renderLayerID);
             SendChildDrawCommands(child);
         }
     }
 
+    bool UIManager::SendLayerDrawCommands(const std::shared_ptr<UI::ElementBase>& element) {
+        if (!element->m_isCached) {
+            DeleteLayerInternal(element.get());
+            return false;
+        }
+
+        if (!element->m_layer)
+            element->m_layer = m_layers.emplace_back(std::make_unique<UI::LayerCache>()).get();
+
+        UI::LayerCache* layer = element->m_layer;
+        if (!layer->Prepare(m_windowSize))
+            return false;
+
+        if (layer->IsDirty()) {
+            layer->BeginRedraw(m_renderer);
+            SendLayerElementDrawCommands(element, *layer);
+            layer->EndRedraw(m_renderer);
+        }
+        layer->SendCompositeCommand(m_renderer, m_renderLayerID);
+        return true;
+    }
+
+    void UIManager::SendLayerElementDrawCommands(const std::shared_ptr<UI::ElementBase>& element, UI::LayerCache& layer) {
+        // cached elements inside the layer are drawn into it as well
+        element->m_renderRect = UI::LayerCache::Rect::FromModel(element->GetWorldModelMatrix());
+        if (layer.NeedsRedraw(element->m_renderRect)) {
+            element->SendDrawCommandImpl(m_renderer, m_renderLayerID);
+            layer.AddDrawnRect(element->m_renderRect);
+        }
+
+        for (auto& child : element->GetChildren())
+            SendLayerElementDrawCommands(child, layer);
+    }
+
+    void UIManager::DeleteLayerInternal(UI::ElementBase* element) {
+        if (!element->m_layer)
+            return;
+
+        auto it = std::find_if(m_layers.begin(), m_layers.end(),
+            [element](const auto& layer) { return layer.get() == element->m_layer; });
+        if (it != m_layers.end())
+            m_layers.erase(it);
+        element->m_layer = nullptr;
+    }
+
     float UIManager::CalculateUIScaleFactor(int width, int height) {
         Vector2 scaleDiff = Vector2{ static_cast<float>(width), static_cast<float>(height) } / m_referenceScreenSize;
 
@@ -433,47 +529,53 @@ namespace EngineCore {
 		for (const auto& child : childs) {
 			FreeIDsInternal(child);
 		}
-		m_idManager.FreeUniqueIdentifier(element->GetID().value);
-	}
 
-    std::shared_ptr<UI::ElementBase> UIManager::SearchElementInternal(std::vector<std::shared_ptr<UI::ElementBase>>& list, UIElementID id) {
-        if (list.empty())
-            return nullptr;
+		// the area of the element gets redrawn in the layers above it
+		element->MarkRenderDirty();
+		DeleteLayerInternal(element.get());
+		m_transitions.Remove(element.get());
 
-        // binary search if the ids are in order and size is large enough
-        if (!m_idManager.IsIDFallback() && list.size() > 64) {
-            auto element = Algorithm::Search::GetBinary<UI::ElementBase>(list, 
-                [](UI::ElementBase& e) { return e.GetID().value; }, id.value);
-            if (element)
-                return element;
-        }
+		unsigned int id = element->GetID().value;
+		if (id < m_elementsByID.size())
+			m_elementsByID[id].reset();
+		m_idManager.FreeUniqueIdentifier(id);
+	}
 
-        // lineare search
-        return Algorithm::Search::GetLinearRecursive(list, 
-            [id](UI::ElementBase& e) { return e.GetID() == id; }, 
-            [](UI::ElementBase& e) -> std::vector<std::shared_ptr<UI::ElementBase>>& { return e.GetChildren(); });
+    void UIManager::RegisterElementInternal(const std::shared_ptr<UI::ElementBase>& element) {
+        unsigned int id = element->GetID().value;
+        if (id >= m_elementsByID.size())
+            m_elementsByID.resize(static_cast<size_t>(id) + 1);
+        m_elementsByID[id] = element;
     }
 
-    bool UIManager::TryGetHoverElement(std::shared_ptr<UI::ElementBase>& outElement) {
-        bool found = false;
-        for (auto& child : m_rootElement->GetChildren()) {
-            if (child->IsMouseOver(m_mousePos)) {
-                found = true;
-                outElement = child;
-                GetHoverElementInternal(outElement);
-            }
+    void UIManager::EraseFromListInternal(std::vector<std::shared_ptr<UI::ElementBase>>& list, const std::shared_ptr<UI::ElementBase>& element) {
+        size_t pos = element->m_listPosition;
+        if (pos >= list.size() || list[pos] != element) {
+            auto it = std::find(list.begin(), list.end(), element);
+            if (it == list.end())
+                return;
+            pos = static_cast<size_t>(it - list.begin());
         }
 
-        return found;
+        list.erase(list.begin() + pos);
+        for (size_t i = pos; i < list.size(); i++)
+            list[i]->m_listPosition = i;
     }
 
-    void UIManager::GetHoverElementInternal(std::shared_ptr<UI::ElementBase>& outElement) {
-        for (auto& child : outElement->GetChildren()) {
-            if (child->IsMouseOver(m_mousePos)) {
-                outElement = child;
-                GetHoverElementInternal(outElement);
-            }
+    bool UIManager::TryGetHoverElement(std::shared_ptr<UI::ElementBase>& outElement) {
+        // picks up elements that were added or removed since the last layout pass
+        m_hitGrid.Update(*m_rootElement, m_movedElements);
+
+        if (m_hoverGeneration != m_hitGrid.GetGeneration() || m_hoverMousePos != m_mousePos) {
+            m_hoverElement = m_hitGrid.Find(m_mousePos);
+            m_hoverGeneration = m_hitGrid.GetGeneration();
+            m_hoverMousePos = m_mousePos;
         }
+
+        if (!m_hoverElement)
+            return false;
+        outElement = m_hoverElement;
+        return true;
     }
 
     void UIManager::BuildHierarchyString(const UI::ElementBase* root, std::string& outStr) {
@@ -16,9 +16,10 @@ namespace EngineCore::UI {
     }
 
     LayoutType ToLayoutType(const std::string& typeStr) {
-        if (FormatUtils::toLowerCase(typeStr) == "none") return LayoutType::None;
-        if (FormatUtils::toLowerCase(typeStr) == "flex") return LayoutType::Flex;
-        if (FormatUtils::toLowerCase(typeStr) == "grid") return LayoutType::Grid;
+        std::string type = FormatUtils::toLowerCase(typeStr);
+        if (type == "none") return LayoutType::None;
+        if (type == "flex") return LayoutType::Flex;
+        if (type == "grid") return LayoutType::Grid;
         Log::Error("UI::ToLayoutType: Unknown Layout type '{}', can not convert to LayoutType!", typeStr);
         return LayoutType::Unknown;
     }
@@ -34,25 +35,47 @@ namespace EngineCore::UI {
         }
     }
 
+    Easing ToEasing(const std::string& easingStr) {
+        std::string easing = FormatUtils::toLowerCase(easingStr);
+        if (easing == "linear") return Easing::Linear;
+        if (easing == "ease-in") return Easing::EaseIn;
+        if (easing == "ease-out") return Easing::EaseOut;
+        return Easing::EaseInOut;
+    }
+
+    std::string ToString(Easing easing) {
+        switch (easing)
+        {
+        case EngineCore::UI::Easing::Linear: return "linear";
+        case EngineCore::UI::Easing::EaseIn: return "ease-in";
+        case EngineCore::UI::Easing::EaseOut: return "ease-out";
+        case EngineCore::UI::Easing::EaseInOut: return "ease-in-out";
+        default: return "Unknown";
+        }
+    }
+
     namespace Flex {
     
         LayoutDirection ToLayoutDirection(const std::string& dirStr) {
-            if (FormatUtils::toLowerCase(dirStr) == "row") return LayoutDirection::Row;
-            if (FormatUtils::toLowerCase(dirStr) == "column") return LayoutDirection::Column;
+            std::string dir = FormatUtils::toLowerCase(dirStr);
+            if (dir == "row") return LayoutDirection::Row;
+            if (dir == "column") return LayoutDirection::Column;
             return LayoutDirection::Row;
         }
 
         LayoutWrap ToLayoutWrap(const std::string& wrapStr) {
-            if (FormatUtils::toLowerCase(wrapStr) == "wrap") return LayoutWrap::Wrap;
+            std::string wrap = FormatUtils::toLowerCase(wrapStr);
+            if (wrap == "wrap") return LayoutWrap::Wrap;
             return LayoutWrap::None;
         }
 
         LayoutAlign ToLayoutAlign(const std::string& alignStr) {
-            if (FormatUtils::toLowerCase(alignStr) == "center") return LayoutAlign::Center;
-            if (FormatUtils::toLowerCase(alignStr) == "end") return LayoutAlign::End;
-            if (FormatUtils::toLowerCase(alignStr) == "stretch") return LayoutAlign::Stretch;
-            if (FormatUtils::toLowerCase(alignStr) == "space-evenly") return LayoutAlign::SpaceEvenly;
-            if (FormatUtils::toLowerCase(alignStr) == "space-around") return LayoutAlign::SpaceAround;
+            std::string align = FormatUtils::toLowerCase(alignStr);
+            if (align == "center") return LayoutAlign::Center;
+            if (align == "end") return LayoutAlign::End;
+            if (align == "stretch") return LayoutAlign::Stretch;
+            if (align == "space-evenly") return LayoutAlign::SpaceEvenly;
+            if (align == "space-around") return LayoutAlign::SpaceAround;
             return LayoutAlign::Start;
         }
 
@@ -0,0 +1,19 @@
+#include "Spin.h"
+
+namespace EngineCore::Component {
+
+	Spin::Spin(GameObjectID gameObjectID)
+		: Script("Spin", gameObjectID) {
+	}
+
+	Spin* Spin::SetSpeed(const Vector3& degreesPerSecond) {
+		m_speed = degreesPerSecond;
+		return this;
+	}
+
+    void Spin::Update() {
+        auto transform = GetGameObject()->GetTransform();
+        transform->SetRotation(transform->GetLocalRotation() + m_speed * Time::GetDeltaTime());
+    }
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <EngineLib\Script.h>
+
+namespace EngineCore::Component {
+
+	/*
+	* @brief Rotates the GameObject around its local axes, used by the stress scenes
+	*/
+	class Spin : public EngineCore::Script{
+	public:
+		Spin(GameObjectID gameObjectID);
+
+		COMPONENT_TYPE_DEFINITION(Spin);
+
+		/*
+		* @param degreesPerSecond rotation speed around every axis
+		*/
+		Spin* SetSpeed(const Vector3& degreesPerSecond);
+
+	private:
+		/*
+		* @brief Called every frame before Application Update.
+		*/
+		void Update() override;
+		Vector3 m_speed = Vector3(0.0f, 45.0f, 0.0f);
+	};
+
+}
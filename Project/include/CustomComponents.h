@@ -1,3 +1,4 @@
 #pragma once
 
-#include "Components/Rainbow.h"
\ No newline at end of file
+#include "Components/Rainbow.h"
+#include "Components/Spin.h"
\ No newline at end of file
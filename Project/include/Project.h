@@ -9,6 +9,12 @@ class Project : public Application {
 public:
 	Project();
 
+	/*
+	* @brief Loads the stress scene (see Scenes::GetStressScenes) instead of the test scene
+	* @param count number of elements, 0 uses the default count of the scene
+	*/
+	void SetStressScene(const std::string& name, size_t count);
+
 protected:
 	void Start() override;
 	void Update() override;
@@ -17,4 +23,8 @@ protected:
 	void OnWindowResize(int newWidth, int newHeight) override;
 	void OnWindowFocusLost() override;
 	void OnWindowFocusGain() override;
+
+private:
+	std::string m_stressScene;
+	size_t m_stressSceneCount = 0;
 };
\ No newline at end of file
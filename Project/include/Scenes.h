@@ -1,4 +1,6 @@
 #pragma once
+#include <string>
+#include <vector>
 
 void SetupGame();
 
@@ -6,4 +8,20 @@ namespace Scenes {
 
 	void LoadTest();
 
+	/*
+	* @brief Parameterized scene for the benchmark mode, see Project --scene
+	*/
+	struct StressScene {
+		const char* name;
+		const char* description;
+		size_t defaultCount;
+		void (*load)(size_t count);
+	};
+
+	const std::vector<StressScene>& GetStressScenes();
+	/*
+	* @return nullptr if there is no stress scene with this name
+	*/
+	const StressScene* FindStressScene(const std::string& name);
+
 }
\ No newline at end of file
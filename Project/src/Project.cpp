@@ -19,6 +19,11 @@ Project::Project()
 	// Log::SaveLogs("Logs/");
 }
 
+void Project::SetStressScene(const std::string& name, size_t count) {
+	m_stressScene = name;
+	m_stressSceneCount = count;
+}
+
 void Project::Start() {
 	App_OpenGL_Set_DepthTesting(true);
 	App_OpenGL_Set_BackgroundColor(0.2f, 0.3f, 0.3f);
@@ -28,6 +33,14 @@ void Project::Start() {
 
 	App_Application_Set_Window_Cursor_LockHidden(false);
 	
+	if (!m_stressScene.empty()) {
+		const Scenes::StressScene* scene = Scenes::FindStressScene(m_stressScene);
+		size_t count = (m_stressSceneCount > 0) ? m_stressSceneCount : scene->defaultCount;
+		Log::Info("Project: Loading stress scene '{}' ({}) with {} elements", m_stressScene, std::string(scene->description), count);
+		scene->load(count);
+		return;
+	}
+
 	SetupGame();
 	Scenes::LoadTest();
 }
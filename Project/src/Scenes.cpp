@@ -1,3 +1,4 @@
+#include <cmath>
 #include <EngineLib/Engine.h>
 
 #include "CustomComponents.h"
@@ -161,4 +162,238 @@ namespace Scenes {
 		sr->SetSprite(id);
 	}
 
+	// ------------------------- Stress scenes -------------------------
+
+	/*
+	* @brief Creates the camera and the UI layer every stress scene needs
+	*/
+	static void SetupStressScene() {
+		uiLayer = RenderLayerManager::AddLayer("UILayer", 10);
+		UIManager::SetUIRenderLayer(uiLayer);
+
+		auto cameraGO = GameObject::Create("MainCamera");
+		cameraGO->SetPersistent(true);
+		cameraGO->AddComponent<Component::Camera>()->AddCameraLayer(uiLayer);
+		cameraGO->AddComponent<Component::FreeCameraController>();
+	}
+
+	/*
+	* @brief Position of element i when count elements are placed in a square grid in front of the camera
+	*/
+	static Vector3 GetGridPosition(size_t i, size_t count, float spacing) {
+		size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+		float x = static_cast<float>(i % columns) - static_cast<float>(columns) * 0.5f;
+		float y = static_cast<float>(i / columns) - static_cast<float>(columns) * 0.5f;
+		return Vector3(x * spacing, y * spacing, 200.0f);
+	}
+
+	static void LoadCubes(size_t count) {
+		SetupStressScene();
+
+		for (size_t i = 0; i < count; i++) {
+			auto go = GameObject::Create(FormatUtils::formatString("cube_{}", i));
+			go->GetTransform()->SetPosition(GetGridPosition(i, count, 15.0f));
+			go->GetTransform()->SetScale(10, 10, 10);
+			auto mr = go->AddComponent<Component::MeshRenderer>();
+			mr->SetMesh(ASSETS::ENGINE::MESH::Cube())->SetMaterial(ASSETS::ENGINE::MATERIAL::Default());
+			go->AddComponent<Component::Spin>();
+		}
+	}
+
+	static void LoadSprites(size_t count) {
+		SetupStressScene();
+		ResourceManager* rm = ResourceManager::GetInstance();
+
+		// every sprite gets its own 4x4 texture, the sprite atlas packs them onto one page
+		unsigned char pixels[4 * 4 * 4];
+		for (size_t i = 0; i < count; i++) {
+			for (size_t p = 0; p < 16; p++) {
+				pixels[p * 4 + 0] = static_cast<unsigned char>(i * 37);
+				pixels[p * 4 + 1] = static_cast<unsigned char>(i * 91 + p);
+				pixels[p * 4 + 2] = static_cast<unsigned char>(i / 256);
+				pixels[p * 4 + 3] = 255;
+			}
+			Texture2DID textureID = rm->AddTexture2DFromMemory(pixels, 4, 4, 4);
+
+			auto go = GameObject::Create(FormatUtils::formatString("sprite_{}", i));
+			go->GetTransform()->SetPosition(GetGridPosition(i, count, 12.0f));
+			go->GetTransform()->SetScale(10, 10, 10);
+			go->AddComponent<Component::SpriteRenderer>()->SetSprite(textureID);
+		}
+	}
+
+	static void LoadTexts(size_t count) {
+		SetupStressScene();
+
+		for (size_t i = 0; i < count; i++) {
+			auto go = GameObject::Create(FormatUtils::formatString("text_{}", i));
+			go->GetTransform()->SetPosition(GetGridPosition(i, count, 40.0f));
+			auto tr = go->AddComponent<Component::TextRenderer>();
+			tr->SetText(FormatUtils::formatString("Text renderer {}", i));
+		}
+	}
+
+	static void LoadHierarchy(size_t count) {
+		SetupStressScene();
+
+		// one chain, the spinning root moves every child each frame
+		std::shared_ptr<GameObject> parent = nullptr;
+		for (size_t i = 0; i < count; i++) {
+			auto go = GameObject::Create(FormatUtils::formatString("node_{}", i));
+			if (parent) {
+				go->SetParent(parent);
+				go->GetTransform()->SetPosition(2.0f, 0.0f, 0.0f);
+			}
+			else {
+				go->GetTransform()->SetPosition(0.0f, 0.0f, 200.0f);
+			}
+			auto mr = go->AddComponent<Component::MeshRenderer>();
+			mr->SetMesh(ASSETS::ENGINE::MESH::Cube())->SetMaterial(ASSETS::ENGINE::MATERIAL::Default());
+			go->AddComponent<Component::Spin>()->SetSpeed(Vector3(0.0f, 0.0f, 10.0f));
+			parent = go;
+		}
+	}
+
+	static void LoadUIWide(size_t count) {
+		using namespace EngineCore::UI;
+		using UI = UIManager;
+		SetupStressScene();
+
+		auto container = Style::Create("StressContainer");
+		container->Set(Attribute::layoutType, "flex");
+		container->Set(Attribute::layoutDirection, "row");
+		container->Set(Attribute::layoutWrap, "wrap");
+		container->Set(Attribute::layout, "start start");
+		container->Set(Attribute::width, "100%w");
+		container->Set(Attribute::height, "100%h");
+
+		auto item = Style::Create("StressItem");
+		item->Set(Attribute::width, "8px");
+		item->Set(Attribute::height, "8px");
+		item->Set(Attribute::margin, "1px");
+		item->Set(Attribute::backgroundColor, "#8f0000");
+		item->Set(State::Hovered, Attribute::backgroundColor, "#ff0000");
+
+		UI::Begin<Panel>(container); {
+			for (size_t i = 0; i < count; i++)
+				UI::Add<Panel>(item);
+		}
+		UI::End();
+	}
+
+	static void BuildUIStyled(size_t count, bool cached) {
+		using namespace EngineCore::UI;
+		using UI = UIManager;
+		SetupStressScene();
+
+		auto container = Style::Create("StressContainer");
+		container->Set(Attribute::layoutType, "flex");
+		container->Set(Attribute::layoutDirection, "row");
+		container->Set(Attribute::layoutWrap, "wrap");
+		container->Set(Attribute::layout, "start start");
+		container->Set(Attribute::width, "100%w");
+		container->Set(Attribute::height, "100%h");
+
+		// neighbours never share colors, radius or border
+		const char* colors[] = { "#8f0000", "#008f00", "#00008f", "#8f8f00", "#008f8f", "#8f008f" };
+		std::vector<std::shared_ptr<Style>> items;
+		for (size_t i = 0; i < std::size(colors); i++) {
+			auto item = Style::Create(FormatUtils::formatString("StressStyledItem{}", i));
+			item->Set(Attribute::width, "12px");
+			item->Set(Attribute::height, "12px");
+			item->Set(Attribute::margin, "1px");
+			item->Set(Attribute::backgroundColor, colors[i]);
+			item->Set(Attribute::borderColor, colors[(i + 1) % std::size(colors)]);
+			item->Set(Attribute::borderSize, FormatUtils::formatString("{}px", i % 3));
+			item->Set(Attribute::borderRadius, FormatUtils::formatString("{}px", i));
+			item->Set(State::Hovered, Attribute::backgroundColor, "#ffffff");
+			items.push_back(item);
+		}
+
+		UI::Begin<Panel>(container)->SetCached(cached); {
+			for (size_t i = 0; i < count; i++)
+				UI::Add<Panel>(items[i % items.size()]);
+		}
+		UI::End();
+	}
+
+	static void LoadUIStyled(size_t count) {
+		BuildUIStyled(count, false);
+	}
+
+	static void LoadUICached(size_t count) {
+		BuildUIStyled(count, true);
+	}
+
+	static void LoadUIDeep(size_t count) {
+		using namespace EngineCore::UI;
+		using UI = UIManager;
+		SetupStressScene();
+
+		auto container = Style::Create("StressContainer");
+		container->Set(Attribute::layoutType, "flex");
+		container->Set(Attribute::layout, "center center");
+		container->Set(Attribute::width, "100%w");
+		container->Set(Attribute::height, "100%h");
+
+		auto nested = Style::Create("StressNested", container);
+		nested->Set(Attribute::width, "99%w");
+		nested->Set(Attribute::height, "99%h");
+		nested->Set(Attribute::backgroundColor, "#10101020");
+		nested->Set(State::Hovered, Attribute::backgroundColor, "#10101040");
+
+		UI::Begin<Panel>(container);
+		for (size_t i = 0; i < count; i++)
+			UI::Begin<Panel>(nested);
+		for (size_t i = 0; i < count; i++)
+			UI::End();
+		UI::End();
+	}
+
+	static void LoadUIList(size_t count) {
+		using namespace EngineCore::UI;
+		using UI = UIManager;
+		SetupStressScene();
+
+		auto list = Style::Create("StressList");
+		list->Set(Attribute::width, "100%w");
+		list->Set(Attribute::height, "100%h");
+
+		auto item = Style::Create("StressListItem");
+		item->Set(Attribute::width, "8px");
+		item->Set(Attribute::height, "8px");
+		item->Set(Attribute::margin, "1px");
+		item->Set(Attribute::backgroundColor, "#008f00");
+		item->Set(State::Hovered, Attribute::backgroundColor, "#00ff00");
+
+		// same items as ui_wide, but only the visible ones exist
+		UI::Begin<VirtualList>(list, item)
+			->SetMode(VirtualList::Mode::Grid)
+			->SetItemCount(count);
+		UI::End();
+	}
+
+	const std::vector<StressScene>& GetStressScenes() {
+		static const std::vector<StressScene> scenes = {
+			{ "cubes", "N spinning cubes sharing one material", 10000, LoadCubes },
+			{ "sprites", "N sprites with unique textures", 2000, LoadSprites },
+			{ "texts", "N TextRenderers", 500, LoadTexts },
+			{ "hierarchy", "Transform chain with N levels and a spinning root", 256, LoadHierarchy },
+			{ "ui_wide", "flex row with N wrapped children", 2000, LoadUIWide },
+			{ "ui_styled", "flex row with N wrapped children in differently styled neighbours", 2000, LoadUIStyled },
+			{ "ui_cached", "ui_styled drawn into a cached layer, only changed areas are redrawn", 2000, LoadUICached },
+			{ "ui_deep", "N nested flex containers", 64, LoadUIDeep },
+			{ "ui_list", "virtual grid over N items", 100000, LoadUIList },
+		};
+		return scenes;
+	}
+
+	const StressScene* FindStressScene(const std::string& name) {
+		for (const auto& scene : GetStressScenes()) {
+			if (name == scene.name)
+				return &scene;
+		}
+		return nullptr;
+	}
+
 }
\ No newline at end of file
@@ -1,7 +1,116 @@
+#include <cstring>
 #include "Project.h"
+#include "Scenes.h"
 
-int main() {
-	EngineCore::Engine engine(std::make_shared<Project>());
+/*
+* Usage: Project [options]
+*   --benchmark <frames>    runs headless as deterministic benchmark for the given number of frames
+*   --benchmark-out <path>  where the frame timings are written (path/name, .csv and .json get appended)
+*   --warmup <frames>       frames that run before the recording starts (default: 0)
+*   --scene <name>          loads a stress scene instead of the test scene (see Scenes::GetStressScenes)
+*   --count <n>             number of elements in the stress scene (default: depends on the scene)
+*   --baseline <file.json>  compares the benchmark metrics against a baseline
+*   --threshold <float>     relative growth that counts as regression (default: 0.1 = 10%)
+*   --update-baseline       writes the metrics to the baseline file instead of comparing
+*   --offscreen <api>       renders into a framebuffer that is read back, api: native, egl or osmesa
+*   --dump-frames <path>    writes the offscreen frames as PNG sequence (path/name, _<frame>.png gets appended)
+*   --dump-interval <n>     only dumps every n-th frame (default: 1)
+*
+* Returns EXIT_FAILURE if a baseline was given and at least one metric regressed.
+*/
+
+static void PrintUsage() {
+	Log::Print("Usage: Project [--benchmark <frames>] [--benchmark-out <path>] [--warmup <frames>] [--scene <name>] "
+		"[--count <n>] [--baseline <file.json>] [--threshold <float>] [--update-baseline] "
+		"[--offscreen <native|egl|osmesa>] [--dump-frames <path>] [--dump-interval <n>]");
+	Log::Print("Stress scenes:");
+	for (const auto& scene : Scenes::GetStressScenes())
+		Log::Print("  {} - {} (default count {})", std::string(scene.name), std::string(scene.description), scene.defaultCount);
+}
+
+static bool ParseContextAPI(const char* name, Application::ContextAPI& outAPI) {
+	if (std::strcmp(name, "native") == 0)
+		outAPI = Application::ContextAPI::Native;
+	else if (std::strcmp(name, "egl") == 0)
+		outAPI = Application::ContextAPI::EGL;
+	else if (std::strcmp(name, "osmesa") == 0)
+		outAPI = Application::ContextAPI::OSMesa;
+	else
+		return false;
+	return true;
+}
+
+int main(int argc, char** argv) {
+	auto project = std::make_shared<Project>();
+	std::string sceneName;
+	size_t sceneCount = 0;
+
+	for (int i = 1; i < argc; i++) {
+		bool hasValue = (i + 1 < argc);
+
+		if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+			PrintUsage();
+			return EXIT_SUCCESS;
+		}
+		else if (std::strcmp(argv[i], "--benchmark") == 0 && hasValue) {
+			project->App_Application_Set_Header(false);
+			project->App_Benchmark_Set_Enabled(true);
+			project->App_Benchmark_Set_FrameLimit(std::strtoull(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--benchmark-out") == 0 && hasValue) {
+			project->App_Benchmark_Set_OutputPath(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+			project->App_Benchmark_Set_WarmupFrames(std::strtoull(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--scene") == 0 && hasValue) {
+			sceneName = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--count") == 0 && hasValue) {
+			sceneCount = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue) {
+			project->App_Benchmark_Set_Baseline(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--threshold") == 0 && hasValue) {
+			project->App_Benchmark_Set_Threshold(std::atof(argv[++i]));
+		}
+		else if (std::strcmp(argv[i], "--update-baseline") == 0) {
+			project->App_Benchmark_Set_UpdateBaseline(true);
+		}
+		else if (std::strcmp(argv[i], "--offscreen") == 0 && hasValue) {
+			Application::ContextAPI api;
+			if (!ParseContextAPI(argv[++i], api)) {
+				Log::Error("Project: Unknown context api '{}'", std::string(argv[i]));
+				PrintUsage();
+				return EXIT_FAILURE;
+			}
+			project->App_Offscreen_Set_Enabled(true);
+			project->App_Offscreen_Set_ContextAPI(api);
+		}
+		else if (std::strcmp(argv[i], "--dump-frames") == 0 && hasValue) {
+			project->App_Offscreen_Set_DumpPath(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--dump-interval") == 0 && hasValue) {
+			project->App_Offscreen_Set_DumpInterval(std::strtoull(argv[++i], nullptr, 10));
+		}
+		else {
+			Log::Error("Project: Unknown or incomplete argument '{}'", std::string(argv[i]));
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (!sceneName.empty()) {
+		if (!Scenes::FindStressScene(sceneName)) {
+			Log::Error("Project: Unknown stress scene '{}'", sceneName);
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+		project->SetStressScene(sceneName, sceneCount);
+	}
+
+	EngineCore::Engine engine(project);
 
 	const int result = engine.EngineStart();
 	if (result != 0) {
@@ -9,7 +118,8 @@ int main() {
 		return EXIT_FAILURE;
 	}
 
-	engine.EngineLoop();
+	if (engine.EngineLoop() != 0)
+		return EXIT_FAILURE;
 
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}